@@ -0,0 +1,210 @@
+/**
+ * @file task_scheduler.cpp
+ * @brief Cooperative deadline scheduler of loop()
+ *
+ * @details This file contains the implementation of the scheduler. All times are differences of two clock
+ * readings, so the 32-bit wrap of the clock (71 minutes for micros()) does not disturb the policy.
+ *
+ * The release time of a frame is the time its hop became available. The ready function is only polled between
+ * tasks, so a frame is usually seen somewhat after its release. While the frames arrive regularly the release is
+ * therefore taken as the expected one, one period after the previous release, instead of the time it was seen.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+// Headers
+#include "task_scheduler.h"
+#include <climits>
+
+/*
+* @brief Constructor
+*
+* @param[in] clock  Returns the time in microseconds
+*/
+TaskScheduler::TaskScheduler(SchedulerClock clock) : clock(clock)
+{
+}
+
+/*
+* @brief Set deadline task function
+*
+* @param[in] name   Name for the statistics
+* @param[in] ready  Returns true when a frame can be processed
+* @param[in] run    Processes one frame
+* @param[in] preemptive True when an interrupt calls runDeadlineTask(), false to run it from service()
+*/
+void TaskScheduler::setDeadlineTask(const char *name, TaskReady ready, TaskFunction run, bool preemptive)
+{
+    deadline = Deadline();
+    deadline.name = name;
+    deadline.ready = ready;
+    deadline.run = run;
+    deadline.preemptive = preemptive;
+}
+
+/*
+* @brief Add task function
+*
+* @param[in] name       Name for the statistics
+* @param[in] run        The task function, runs to completion
+* @param[in] priority   Lower values run first, tasks with the same priority run in the order they were added
+* @param[in] budget     The longest time the task takes in us
+* @param[in] interval   Time between two runs in us, 0 to run every pass
+* @return False when there is no room for another task
+*/
+bool TaskScheduler::addTask(const char *name, TaskFunction run, uint8_t priority, uint32_t budget, uint32_t interval)
+{
+    if (tasks >= SCHEDULER_MAX_TASKS)
+        return false;
+
+    // Insert behind the tasks with the same or a higher priority
+    int index = tasks;
+    while (index > 0 && taskList[index - 1].priority > priority)
+    {
+        taskList[index] = taskList[index - 1];
+        index--;
+    }
+
+    Task &task = taskList[index];
+    task.name = name;
+    task.run = run;
+    task.priority = priority;
+    task.budget = budget;
+    task.interval = interval;
+    task.lastRun = clock() - interval; // Due right away
+    task.waiting = false;
+    task.stats = TaskStats();
+    tasks++;
+    return true;
+}
+
+/*
+* @brief Set period function
+*
+* @param[in] period The time between two frames in us
+*
+* @details Call when the hop size changes, the next deadlines use the new period.
+*/
+void TaskScheduler::setPeriod(uint32_t period)
+{
+    this->period = period;
+}
+
+/*
+* @brief Service function
+*
+* @details Call once per pass of loop(). Runs a ready frame first, then every background task that is due
+* and fits in the slack, with another check for a ready frame after each of them.
+*/
+void TaskScheduler::service()
+{
+    if (!deadline.preemptive)
+        runDeadlineTask();
+
+    for (int i = 0; i < tasks; i++)
+    {
+        Task &task = taskList[i];
+        const uint32_t now = clock();
+        if (task.interval > 0 && now - task.lastRun < task.interval)
+            continue;
+
+        if (slack() < (int32_t)task.budget)
+        {
+            task.stats.deferred += task.waiting ? 0 : 1;
+            task.waiting = true;
+            continue;
+        }
+
+        task.run();
+        const uint32_t elapsed = clock() - now;
+        task.lastRun = now;
+        task.waiting = false;
+        task.stats.runs++;
+        task.stats.overruns += (elapsed > task.budget) ? 1 : 0;
+        task.stats.maxTime = (elapsed > task.stats.maxTime) ? elapsed : task.stats.maxTime;
+
+        if (!deadline.preemptive)
+            runDeadlineTask();
+    }
+}
+
+/*
+* @brief Slack function
+*
+* @return The time in us a background task may take from now without making the next frame miss its deadline,
+* INT32_MAX while the frame timing is not known yet or when the frame preempts the background tasks
+*/
+int32_t TaskScheduler::slack() const
+{
+    if (!deadline.run || deadline.preemptive || !deadline.released || period == 0)
+        return INT32_MAX;
+
+    // The next frame is released at release + period and is due one period later
+    const uint32_t latestStart = deadline.release + 2 * period - deadline.cost;
+    return (int32_t)(latestStart - clock());
+}
+
+/*
+* @brief Reset statistics function
+*
+* @details The frame cost estimate is kept, it is part of the policy.
+* The frame counters are reset by the deadline task on its next frame, so an interrupt never sees a half reset.
+*/
+void TaskScheduler::resetStats()
+{
+    deadlineResetRequested.store(true, std::memory_order_release);
+    for (int i = 0; i < tasks; i++)
+    {
+        taskList[i].stats = TaskStats();
+    }
+}
+
+/*
+* @brief Run deadline task function
+*
+* @return True when a frame was processed
+*
+* @details Runs one frame when it is ready and checks it against its deadline. Called by service(), or by the
+* interrupt that owns a preemptive deadline task. A backlog is worked off one frame per call, in the cooperative case
+* the slack is negative meanwhile so no background task runs in between.
+*/
+bool TaskScheduler::runDeadlineTask()
+{
+    if (!deadline.run || !deadline.ready())
+        return false;
+
+    if (deadlineResetRequested.exchange(false, std::memory_order_acquire))
+        deadlineCounters = DeadlineStats();
+
+    const uint32_t start = clock();
+    uint32_t release = start;
+    if (deadline.released && period > 0)
+    {
+        const uint32_t expected = deadline.release + period;
+        const uint32_t behind = start - expected;
+        if ((int32_t)behind >= 0 && behind < SCHEDULER_RESYNC_PERIODS * period)
+            release = expected;
+    }
+
+    deadline.run();
+
+    const uint32_t finish = clock();
+    const uint32_t elapsed = finish - start;
+    deadline.cost = (elapsed > deadline.cost - deadline.cost / 64) ? elapsed : deadline.cost - deadline.cost / 64;
+    deadline.release = release;
+    deadline.released = true;
+
+    deadlineCounters.frames++;
+    deadlineCounters.maxTime = (elapsed > deadlineCounters.maxTime) ? elapsed : deadlineCounters.maxTime;
+    const uint32_t response = finish - release;
+    deadlineCounters.maxResponse = (response > deadlineCounters.maxResponse) ? response : deadlineCounters.maxResponse;
+    const int32_t lateness = (int32_t)(finish - (release + period));
+    if (period > 0 && lateness > 0)
+    {
+        deadlineCounters.misses++;
+        deadlineCounters.maxLateness = ((uint32_t)lateness > deadlineCounters.maxLateness) ? (uint32_t)lateness : deadlineCounters.maxLateness;
+    }
+    return true;
+}
@@ -0,0 +1,128 @@
+/**
+ * @file task_scheduler.h
+ * @brief Header file for the cooperative deadline scheduler of loop()
+ *
+ * @details This file contains the declaration of a small cooperative scheduler for the work of loop().
+ * There is one deadline task, the DSP frame, and a few background tasks (input, screens, display, telemetry).
+ *
+ * The deadline task is event driven: it runs as soon as its ready function reports a full hop of input,
+ * before any background task and again after every background task. A frame released at time r has to be finished
+ * before the next hop arrives at r + period, otherwise a deadline miss is counted.
+ *
+ * A preemptive deadline task is run from an interrupt instead, with runDeadlineTask(). service() then leaves it alone
+ * and the slack is unlimited, the interrupt preempts the background tasks so they can not delay a frame.
+ *
+ * Background tasks run in priority order, each only when its time budget fits in the slack: the time left until the
+ * next frame has to start to still meet its deadline. The start time is the expected release of the next frame plus
+ * one period minus the cost of a frame, where the cost is the slowly decaying peak of the measured frame times.
+ * A task that does not fit is deferred to a later pass, a smaller task behind it may still use the slack.
+ *
+ * The clock is a function passed to the constructor, micros() on the Teensy and a simulated clock on the host
+ * (see Tools/scheduler_sim.cpp), so the policy can be run deterministically without hardware.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+#ifndef TASK_SCHEDULER_H
+#define TASK_SCHEDULER_H
+
+// Headers
+#include <atomic>
+#include <cstdint>
+
+// Defines
+static const int SCHEDULER_MAX_TASKS = 8;
+static const uint32_t SCHEDULER_RESYNC_PERIODS = 4; // A frame later than this is taken as a restart of the stream
+
+typedef uint32_t (*SchedulerClock)();  // Microseconds, wraps at 32 bits
+typedef bool (*TaskReady)();
+typedef void (*TaskFunction)();
+
+/*
+* @struct TaskStats
+* @brief Counters of one background task
+*/
+struct TaskStats
+{
+    uint32_t runs = 0;
+    uint32_t deferred = 0;  // Runs that had to wait because the task did not fit in the slack
+    uint32_t overruns = 0;  // Runs that took longer than the budget
+    uint32_t maxTime = 0;   // Longest run in us
+};
+
+/*
+* @struct DeadlineStats
+* @brief Counters of the deadline task
+*/
+struct DeadlineStats
+{
+    uint32_t frames = 0;
+    uint32_t misses = 0;        // Frames finished after the next release
+    uint32_t maxLateness = 0;   // us after the deadline, worst miss
+    uint32_t maxResponse = 0;   // us from the release to the end of a frame, capture to playback queue
+    uint32_t maxTime = 0;       // Longest frame in us
+};
+
+/*
+* @class TaskScheduler
+* @brief Runs the DSP frame on its deadline and the other tasks of loop() in the slack
+*
+* @details Call service() once per pass of loop(). The scheduler never preempts a task,
+* the budgets are what keeps a background task from delaying the next frame.
+*/
+class TaskScheduler
+{
+    public:
+        explicit TaskScheduler(SchedulerClock clock);
+
+        void setDeadlineTask(const char *name, TaskReady ready, TaskFunction run, bool preemptive = false);
+        bool runDeadlineTask();
+        bool addTask(const char *name, TaskFunction run, uint8_t priority, uint32_t budget, uint32_t interval = 0);
+        void setPeriod(uint32_t period);
+        void service();
+        int32_t slack() const;
+
+        int taskCount() const { return tasks; }
+        const char* taskName(int index) const { return taskList[index].name; }
+        const TaskStats& taskStats(int index) const { return taskList[index].stats; }
+        const char* deadlineName() const { return deadline.name; }
+        const DeadlineStats& deadlineStats() const { return deadlineCounters; }
+        uint32_t frameCost() const { return deadline.cost; }
+        void resetStats();
+
+    private:
+        struct Task
+        {
+            const char *name;
+            TaskFunction run;
+            uint8_t priority;   // Lower values run first
+            uint32_t budget;    // us the task may take
+            uint32_t interval;  // us between runs, 0 for every pass
+            uint32_t lastRun;
+            bool waiting;       // Due but deferred, counted once per run
+            TaskStats stats;
+        };
+
+        struct Deadline
+        {
+            const char *name = "";
+            TaskReady ready = nullptr;
+            TaskFunction run = nullptr;
+            bool preemptive = false; // Run from an interrupt, not by service()
+            bool released = false;  // A frame has run, `release` is valid
+            uint32_t release = 0;   // Release time of the last frame
+            uint32_t cost = 0;      // Decaying peak of the frame time
+        };
+
+        SchedulerClock clock;
+        uint32_t period = 0;        // us between two frames, 0 while unknown
+        Deadline deadline;
+        DeadlineStats deadlineCounters;
+        std::atomic<bool> deadlineResetRequested{false}; // Carried out by the deadline task, it may be an interrupt
+        int tasks = 0;
+        Task taskList[SCHEDULER_MAX_TASKS];
+};
+
+#endif // TASK_SCHEDULER_H
@@ -3,7 +3,7 @@
  * @brief Audio stream classes for processing audio data
  *  
  * @details This file contains the re-implementation of audio stream classes for processing audio data.
- * It includes classes for processing audio data from the carrier input, modulator input, and playback output.
+ * It includes classes for the synchronized capture of the carrier and modulator inputs and for the playback output.
  * 
  * @author Tim Wannet
  * @date 20-05-2025
@@ -12,101 +12,387 @@
 
 // Headers
 #include "audio_stream_classes.h"
+#include "profiler.h"
+#include <atomic>
+#include <cstring>
 
-/*
-* @class CarrierBufferProcessor
-* @brief Processes audio data from I2S input and stores it in a buffer
+static_assert(CAPTURE_BLOCK_SAMPLES == AUDIO_BLOCK_SAMPLES, "The capture alignment works on audio blocks");
+static_assert(CAPTURE_STREAMS <= CAPTURE_MAX_STREAMS, "Too many capture streams");
 
-* @details This class processes audio data from the I2S input, this is handled in a interrupt service routine.
-* The audio data is stored in a buffer and when the buffer is full, a flag is set to signal that processing can start.
-*/
+// Variables
+static void (*captureHandler)() = nullptr;
+static std::atomic<uint32_t> droppedCycles{0};  // Capture updates dropped because the capture queue was full
+static std::atomic<uint32_t> missedBlocks{0};   // Playback updates without a block
+static std::atomic<uint32_t> poolFailures{0};   // Failed allocations from the audio block pool
+CaptureSync captureSync;
 
-    CarrierBufferProcessor::CarrierBufferProcessor() : AudioStream(1, inputQueueArray) {} 
+/*
+* @class CaptureProcessor
+* @brief Captures the carrier voices and the modulator in lock-step and queues their blocks
+*
+* @details This class processes the audio data of all inputs in one interrupt service routine.
+* The blocks of one update are aligned on the shared sample clock first, a missing block is replaced
+* by a concealment block. Then the blocks of the active carrier voices and the modulator block are queued as one
+* cycle, they are kept and not copied. So the streams can not slip against each other and a hop is complete
+* for every stream at the same update.
+* If the DSP falls behind the queue overruns, the cycle is dropped and the overrun counter is incremented.
+* While the filter bank is selected nothing is queued. When it is selected the capture handler is called once more,
+* so the frame discards the cycles that are left with discardStale() and their blocks return to the pool at once.
+*/
+    CaptureProcessor::CaptureProcessor() : AudioStream(CAPTURE_STREAMS, inputQueueArray) {}
 
     //override base::update()
-    void CarrierBufferProcessor::update()
+    void CaptureProcessor::update()
     {
-        audio_block_t *block;
-        block = receiveReadOnly(0); // Receive audio data from I2S input
-        if (!block)
+        PROFILE_BEGIN(isrTimer);
+        CaptureCycle cycle;
+        const int16_t *blocks[CAPTURE_STREAMS];
+        for (int s = 0; s < CAPTURE_STREAMS; s++)
+        {
+            cycle.blocks[s] = receiveReadOnly(s);
+            blocks[s] = cycle.blocks[s] ? cycle.blocks[s]->data : nullptr;
+        }
+
+        const bool filterBank = getVocoderEngine() == VocoderEngine::FilterBank;
+        const bool switched = filterBank && !filterBankSelected;
+        filterBankSelected = filterBank;
+        if (switched)
+            dropCycles.store(true, std::memory_order_relaxed);
+
+        if (filterBank || !captureSync.alignCycle(blocks))
+        {
+            releaseCycle(cycle);
+            if (switched && captureHandler)
+                captureHandler();
+            PROFILE_LAP(isrTimer, ProfileStage::CaptureIsr);
             return;
+        }
 
-        static uint16_t index = 0;
-        for (int i = 0; i < AUDIO_BLOCK_SAMPLES && index < FFT_SIZE; i++)
+        const int voices = carrierVoices.voiceCount();
+        for (int s = 0; s < CAPTURE_STREAMS; s++)
         {
-            carrierBuffer[index++] = block->data[i]; // Store audio data in buffer
-            if (index >= FFT_SIZE) // Buffer full
+            if (s >= voices && s != CAPTURE_MODULATOR_INPUT)
             {
-                carrierBufferFull = true; // Signal that processing can start
-                index = 0;
+                if (cycle.blocks[s])
+                    release(cycle.blocks[s]);
+                cycle.blocks[s] = nullptr;
+            }
+            else if (!cycle.blocks[s] && blocks[s][0] != 0)
+            {
+                // Concealed, the ramp needs a block of its own. A ramp that starts at zero is silence.
+                cycle.blocks[s] = allocate();
+                if (cycle.blocks[s])
+                    memcpy(cycle.blocks[s]->data, blocks[s], sizeof(cycle.blocks[s]->data));
+                else
+                    poolFailures.fetch_add(1, std::memory_order_relaxed);
             }
         }
-        release(block);
-    }
 
+        if (cycleQueue.write(&cycle, 1) == 0)
+        {
+            releaseCycle(cycle);
+            droppedCycles.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if (captureHandler)
+            captureHandler();
+        PROFILE_LAP(isrTimer, ProfileStage::CaptureIsr);
+    }
 
 /*
-* @class ModulatorProcessor
-* @brief Processes audio data from the modulator and stores it in a buffer
-* 
-* @details This class processes audio data from the modulator, this is handled in a interrupt service routine.
-* The audio data is stored in a buffer and when the buffer is full, a flag is set to signal that processing can start.
+* @brief Available function (frame side)
+*
+* @return Number of captured samples per stream that the frame can read
 */
-        ModulatorProcessor::ModulatorProcessor() : AudioStream(1, inputQueueArray) {}
+    uint32_t CaptureProcessor::available() const
+    {
+        return cycleQueue.available() * AUDIO_BLOCK_SAMPLES + (AUDIO_BLOCK_SAMPLES - readPosition);
+    }
 
-        void ModulatorProcessor::update()
+/*
+* @brief Read hop function (frame side)
+*
+* @param[out] carriers  One destination per carrier voice
+* @param[in] voices     Number of carrier voices to read, the other voices are skipped
+* @param[out] modulator The destination for the modulator
+* @param[in] count      Number of samples per stream
+*
+* @details The samples are copied straight out of the queued blocks, every block is released as soon as it is read.
+* A silent block reads as zeros, a hop that is not captured yet is zero filled.
+*/
+    void CaptureProcessor::readHop(int16_t *const carriers[], int voices, int16_t *modulator, int count)
+    {
+        int16_t *destinations[CAPTURE_STREAMS];
+        for (int s = 0; s < CAPTURE_STREAMS; s++)
         {
-            audio_block_t *block;
-            block = receiveReadOnly(0);
-            if (!block)
-                return;
+            destinations[s] = (s == CAPTURE_MODULATOR_INPUT) ? modulator : (s < voices) ? carriers[s] : nullptr;
+        }
 
-            static uint16_t index = 0;
-            for (int i = 0; i < AUDIO_BLOCK_SAMPLES && index < FFT_SIZE; i++)
+        int done = 0;
+        while (done < count)
+        {
+            if (readPosition == AUDIO_BLOCK_SAMPLES)
             {
-                modulatorBuffer[index++] = block->data[i]; //32767
+                if (cycleQueue.available() == 0)
+                    break;
+                cycleQueue.read(&readCycle, 1);
+                readPosition = 0;
             }
 
-            if (index >= FFT_SIZE) // Buffer full
+            const int n = (count - done < AUDIO_BLOCK_SAMPLES - readPosition) ? count - done : AUDIO_BLOCK_SAMPLES - readPosition;
+            for (int s = 0; s < CAPTURE_STREAMS; s++)
             {
-                modulatorBufferFull = true; // Signal that processing can start
-                index = 0;
+                if (!destinations[s])
+                    continue;
+                if (readCycle.blocks[s])
+                    memcpy(destinations[s] + done, readCycle.blocks[s]->data + readPosition, n * sizeof(int16_t));
+                else
+                    memset(destinations[s] + done, 0, n * sizeof(int16_t));
             }
-            release(block);
+
+            done += n;
+            readPosition += n;
+            if (readPosition == AUDIO_BLOCK_SAMPLES)
+                releaseCycle(readCycle);
+        }
+
+        for (int s = 0; s < CAPTURE_STREAMS && done < count; s++)
+        {
+            if (destinations[s])
+                memset(destinations[s] + done, 0, (count - done) * sizeof(int16_t));
+        }
+    }
+
+/*
+* @brief Discard stale function (frame side)
+*
+* @details After the filter bank was selected the cycles that are still queued, and the one the frame was reading,
+* hold audio from before the switch. They are released, so they do not hold pool blocks and the first hop after
+* a switch back does not join old samples to new ones. Call before the frame checks for a full hop.
+*/
+    void CaptureProcessor::discardStale()
+    {
+        if (!dropCycles.exchange(false, std::memory_order_relaxed))
+            return;
+
+        releaseCycle(readCycle);
+        readPosition = AUDIO_BLOCK_SAMPLES;
+
+        CaptureCycle cycle;
+        while (cycleQueue.available() > 0)
+        {
+            cycleQueue.read(&cycle, 1);
+            releaseCycle(cycle);
+        }
+    }
+
+/*
+* @brief Release cycle function
+*
+* @param[in,out] cycle  The cycle, all its blocks are released and cleared
+*/
+    void CaptureProcessor::releaseCycle(CaptureCycle &cycle)
+    {
+        for (int s = 0; s < CAPTURE_STREAMS; s++)
+        {
+            if (cycle.blocks[s])
+                release(cycle.blocks[s]);
+            cycle.blocks[s] = nullptr;
         }
+    }
 
 
 /*
 * @class PlaybackProcessor
-* @brief Processes audio data from a buffer and plays it back
+* @brief Transmits the blocks the frame has filled
 *
-* @details This class processes audio data from the buffer and plays it back using the I2S output.
-* This is handled in a interrupt service routine and the audio data is played back in chunks of 128 samples (according to the Audio Library).
+* @details This class transmits the queued block pairs on output 0 (left) and output 1 (right), the blocks are passed on
+* and not copied. This is handled in a interrupt service routine and the audio data is played back in chunks of
+* 128 samples (according to the Audio Library).
+* Playback starts once the first hop is available, after that a late hop is silent and counted as underrun.
+* Only active when an FFT engine is selected. While the filter bank is selected the queued pairs are released
+* and the frame drops the pair it was filling at its next hop, so a switch back starts from fresh audio.
 */
     PlaybackProcessor::PlaybackProcessor() : AudioStream(0, NULL) {}
 
     //override base::update()
     void PlaybackProcessor::update()  
     {
-        if (!playbackReady) 
+        PROFILE_BEGIN(isrTimer);
+        PlaybackBlocks blocks;
+        if (getVocoderEngine() == VocoderEngine::FilterBank)
+        {
+            while (blockQueue.available() > 0)
+            {
+                blockQueue.read(&blocks, 1);
+                release(blocks.left);
+                release(blocks.right);
+            }
+            dropWriteBlocks.store(true, std::memory_order_relaxed);
+            playing = false;
+            PROFILE_LAP(isrTimer, ProfileStage::PlaybackIsr);
             return;
-        
-        audio_block_t *block = allocate(); 
-        
-        if (!block) 
+        }
+
+        if (!playing)
+        {
+            if (blockQueue.available() * AUDIO_BLOCK_SAMPLES < (uint32_t)hopSize)
+            {
+                PROFILE_LAP(isrTimer, ProfileStage::PlaybackIsr);
+                return;
+            }
+            playing = true;
+        }
+
+        if (blockQueue.available() == 0)
+        {
+            missedBlocks.fetch_add(1, std::memory_order_relaxed);
+            PROFILE_LAP(isrTimer, ProfileStage::PlaybackIsr);
             return;
+        }
+        blockQueue.read(&blocks, 1);
+
+        transmit(blocks.left, 0);
+        transmit(blocks.right, 1);
+        release(blocks.left);
+        release(blocks.right);
+        PROFILE_LAP(isrTimer, ProfileStage::PlaybackIsr);
+    }
+
+/*
+* @brief Write hop function (frame side)
+*
+* @param[in] left   The left output samples
+* @param[in] right  The right output samples
+* @param[in] count  Number of samples per channel
+*
+* @details The samples are copied straight into a pair of blocks from the pool, every full pair is queued for update().
+* When the pool is exhausted the rest of the hop is dropped and counted as pool failure.
+* A pair that was being filled before the filter bank was selected is released first, its samples are stale.
+*/
+    void PlaybackProcessor::writeHop(const int16_t *left, const int16_t *right, int count)
+    {
+        if (dropWriteBlocks.exchange(false, std::memory_order_relaxed) && writeBlocks.left)
+        {
+            release(writeBlocks.left);
+            release(writeBlocks.right);
+            writeBlocks = {};
+        }
+
+        int done = 0;
+        while (done < count)
+        {
+            if (!writeBlocks.left)
+            {
+                writeBlocks.left = allocate();
+                writeBlocks.right = allocate();
+                if (!writeBlocks.left || !writeBlocks.right)
+                {
+                    if (writeBlocks.left)
+                        release(writeBlocks.left);
+                    if (writeBlocks.right)
+                        release(writeBlocks.right);
+                    writeBlocks = {};
+                    poolFailures.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                writePosition = 0;
+            }
+
+            const int n = (count - done < AUDIO_BLOCK_SAMPLES - writePosition) ? count - done : AUDIO_BLOCK_SAMPLES - writePosition;
+            memcpy(writeBlocks.left->data + writePosition, left + done, n * sizeof(int16_t));
+            memcpy(writeBlocks.right->data + writePosition, right + done, n * sizeof(int16_t));
+            done += n;
+            writePosition += n;
+
+            if (writePosition == AUDIO_BLOCK_SAMPLES)
+            {
+                if (blockQueue.write(&writeBlocks, 1) == 0)
+                {
+                    release(writeBlocks.left);
+                    release(writeBlocks.right);
+                }
+                writeBlocks = {};
+            }
+        }
+    }
+
 
-        static uint16_t index = 0;
+/*
+* @class FilterBankProcessor
+* @brief Runs the filter-bank vocoder inside the audio update chain
+*
+* @details Input 0 is the carrier, input 1 the modulator. Each block is vocoded directly in the
+* interrupt, so the latency is a single audio block. Only active when the filter-bank engine is selected.
+*/
+    FilterBankProcessor::FilterBankProcessor() : AudioStream(2, inputQueueArray) {}
+
+    //override base::update()
+    void FilterBankProcessor::update()
+    {
+        PROFILE_BEGIN(isrTimer);
+        audio_block_t *carrier = receiveReadOnly(0);
+        audio_block_t *modulator = receiveReadOnly(1);
 
-        for (int i = 0; i < AUDIO_BLOCK_SAMPLES; i++) 
+        if (carrier && modulator && getVocoderEngine() == VocoderEngine::FilterBank)
         {
-            block->data[i] = fftFloatBuffer[index++];
-            if (index >= FFT_SIZE)
+            audio_block_t *block = allocate();
+            if (block)
             {
-                index = 0;
-                playbackReady = false;
+                filterBankVocoder.process(carrier->data, modulator->data, block->data, AUDIO_BLOCK_SAMPLES);
+                transmit(block);
+                release(block);
+                PROFILE_LAP(isrTimer, ProfileStage::FilterBankIsr);
             }
         }
-        transmit(block);
-        release(block);
-    }
\ No newline at end of file
+
+        if (carrier)
+            release(carrier);
+        if (modulator)
+            release(modulator);
+    }
+
+
+/*
+* @brief Capture overruns function
+*
+* @return Number of captured samples per input dropped because the DSP fell behind
+*/
+uint32_t captureOverruns()
+{
+    return droppedCycles.load(std::memory_order_relaxed) * AUDIO_BLOCK_SAMPLES;
+}
+
+/*
+* @brief Playback underruns function
+*
+* @return Number of output samples played as silence because a hop was late
+*/
+uint32_t playbackUnderruns()
+{
+    return missedBlocks.load(std::memory_order_relaxed) * AUDIO_BLOCK_SAMPLES;
+}
+
+/*
+* @brief Audio pool failures function
+*
+* @return Number of times a block could not be allocated from the pool of AudioMemory(), the audio of that block
+* is dropped (playback) or silent (a concealment block of the capture)
+*/
+uint32_t audioPoolFailures()
+{
+    return poolFailures.load(std::memory_order_relaxed);
+}
+
+/*
+* @brief Set capture handler function
+*
+* @param[in] handler    Called from the audio interrupt after every captured update of the carrier and modulator
+*
+* @details The handler checks whether a full hop is captured and triggers the frame processing. It is called once more
+* when the filter bank is selected, so the frame can release the capture that is left, see CaptureProcessor::stale().
+*/
+void setCaptureHandler(void (*handler)())
+{
+    captureHandler = handler;
+}
@@ -3,7 +3,13 @@
  * @brief Header file for audio stream classes
  * 
  * @details This file contains class declarations for processing audio data streams.
- * It includes classes for processing audio data from the carrier input, modulator input, and playback output.
+ * It includes classes for the synchronized capture of the carrier and modulator inputs and for the playback output.
+ * The carrier has one input per carrier voice, the playback is stereo.
+ *
+ * The samples are not copied in the audio interrupts. The capture keeps the reference-counted audio blocks it
+ * receives in a queue and the frame copies its hop straight out of them, the frame writes its output hop straight
+ * into newly allocated blocks that the playback only has to transmit. All queued blocks come from the pool of
+ * AudioMemory(), `AUDIO_QUEUE_BLOCKS` is what the queues can hold at most.
  * 
  * @author Tim Wannet
  * @date 20-05-2025
@@ -17,70 +23,132 @@
 #include "Audio.h"
 #include "Wire.h"
 #include "SPI.h"
+#include <atomic>
+#include "ring_buffer.h"
+#include "vocoder.h"
+#include "capture_sync.h"
+
+// Inputs of the CaptureProcessor
+static const int CAPTURE_MODULATOR_INPUT = MAX_CARRIER_VOICES;
+static const int CAPTURE_STREAMS = MAX_CARRIER_VOICES + 1;
+
+// Queues between the audio interrupts and the frame interrupt, they hold several hops so capture, DSP and playback can overlap
+static const int CAPTURE_QUEUE_CYCLES = 16;     // Audio updates, 2048 samples
+static const int PLAYBACK_QUEUE_BLOCKS = 16;    // Stereo block pairs, 2048 samples
+static const int CAPTURE_CONNECTED_STREAMS = 3; // Line in left and right, analog in
+// Blocks the queues hold at most, plus the cycle the frame reads from and the pair it writes to
+static const int AUDIO_QUEUE_BLOCKS = CAPTURE_CONNECTED_STREAMS * (CAPTURE_QUEUE_CYCLES + 1) + 2 * (PLAYBACK_QUEUE_BLOCKS + 1);
 
-// External variables
-extern const int FFT_SIZE;
+/*
+* @struct CaptureCycle
+* @brief The blocks of all capture inputs of one audio update, nullptr is a silent block
+*/
+struct CaptureCycle
+{
+    audio_block_t *blocks[CAPTURE_STREAMS];
+};
 
-extern volatile bool carrierBufferFull;
-extern volatile bool modulatorBufferFull;
-extern volatile bool playbackReady;
+/*
+* @struct PlaybackBlocks
+* @brief The left and right block of one playback update, queued together so the channels can not slip
+*/
+struct PlaybackBlocks
+{
+    audio_block_t *left;
+    audio_block_t *right;
+};
+
+// External variables
+extern int hopSize;
+extern CaptureSync captureSync;
 
-extern int16_t carrierBuffer[];
-extern int16_t modulatorBuffer[];
-extern int16_t fftFloatBuffer[];
+// Function prototypes
+uint32_t captureOverruns();
+uint32_t playbackUnderruns();
+uint32_t audioPoolFailures();
+void setCaptureHandler(void (*handler)());
 
 /*
-* @class CarrierBufferProcessor
-* @brief Processes audio data from I2S input and stores it in a buffer
-
-* @details This class processes audio data from the I2S input, this is handled in a interrupt service routine.
-* The audio data is stored in a buffer and when the buffer is full, a flag is set to signal that processing can start.
+* @class CaptureProcessor
+* @brief Captures the carrier voices and the modulator in lock-step and stores them in ring buffers
+*
+* @details This class processes the audio data of all inputs in one interrupt service routine.
+* Input N (0 to `MAX_CARRIER_VOICES` - 1) is carrier voice N, input `CAPTURE_MODULATOR_INPUT` is the modulator.
+* The blocks of one update are aligned by `captureSync` (see capture_sync.h), a missing block is concealed,
+* and the blocks of all streams are queued together as one cycle, so the hops of all streams cover the same window.
+* The capture handler is called after every update so the frame can start as soon as a full hop is available.
+*
+* Interrupt side: update(). Frame side: available(), readHop() and discardStale(), they release every block once it is read.
 */
-class CarrierBufferProcessor : public AudioStream 
+class CaptureProcessor : public AudioStream 
 {
     public:
-        CarrierBufferProcessor();
+        CaptureProcessor();
 
         //override base::update()
         void update() override;
 
+        uint32_t available() const;
+        void readHop(int16_t *const carriers[], int voices, int16_t *modulator, int count);
+        void discardStale();
+        bool stale() const { return dropCycles.load(std::memory_order_relaxed); }
 
     private:
-    audio_block_t *inputQueueArray[1]; 
+        static void releaseCycle(CaptureCycle &cycle);
+
+        audio_block_t *inputQueueArray[CAPTURE_STREAMS];
+        SpscRingBuffer<CaptureCycle, CAPTURE_QUEUE_CYCLES> cycleQueue;
+        CaptureCycle readCycle = {};    // The cycle the frame reads from, frame side only
+        int readPosition = AUDIO_BLOCK_SAMPLES;
+        std::atomic<bool> dropCycles{false};    // Set by update() when the filter bank is selected
+        bool filterBankSelected = false;        // Interrupt side only
 };
 
 /*
-* @class ModulatorProcessor
-* @brief Processes audio data from the modulator and stores it in a buffer
-* 
-* @details This class processes audio data from the modulator, this is handled in a interrupt service routine.
-* The audio data is stored in a buffer and when the buffer is full, a flag is set to signal that processing can start.
+* @class PlaybackProcessor
+* @brief Processes audio data from a ring buffer and plays it back
+*
+* @details This class transmits the blocks the frame has filled on output 0 (left) and output 1 (right).
+* This is handled in a interrupt service routine and the audio data is played back in chunks of 128 samples
+* (according to the Audio Library). Only active when an FFT engine is selected.
+*
+* Frame side: writeHop(). Interrupt side: update().
 */
-class ModulatorProcessor : public AudioStream 
+class PlaybackProcessor : public AudioStream 
 {
-    public:
-        ModulatorProcessor();
+public:
+    PlaybackProcessor();
 
-        void update() override;
+    //override base::update()
+    void update() override;
 
-    private:
-        audio_block_t *inputQueueArray[1];
+    void writeHop(const int16_t *left, const int16_t *right, int count);
+
+private:
+    bool playing = false;
+    SpscRingBuffer<PlaybackBlocks, PLAYBACK_QUEUE_BLOCKS> blockQueue;
+    PlaybackBlocks writeBlocks = {};    // The pair the frame writes to, frame side only
+    int writePosition = 0;
+    std::atomic<bool> dropWriteBlocks{false}; // Set by update() while the filter bank is selected
 };
 
 /*
-* @class PlaybackProcessor
-* @brief Processes audio data from a buffer and plays it back
+* @class FilterBankProcessor
+* @brief Runs the filter-bank vocoder inside the audio update chain
 *
-* @details This class processes audio data from the buffer and plays it back using the I2S output.
-* This is handled in a interrupt service routine and the audio data is played back in chunks of 128 samples (according to the Audio Library).
+* @details Input 0 is the carrier, input 1 the modulator. Each block is vocoded directly in the
+* interrupt, so the latency is a single audio block. Only active when the filter-bank engine is selected.
 */
-class PlaybackProcessor : public AudioStream 
+class FilterBankProcessor : public AudioStream 
 {
 public:
-    PlaybackProcessor();
+    FilterBankProcessor();
 
     //override base::update()
     void update() override;
+
+private:
+    audio_block_t *inputQueueArray[2];
 };
 
 #endif // AUDIO_STREAM_CLASSES_H
\ No newline at end of file
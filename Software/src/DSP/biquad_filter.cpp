@@ -0,0 +1,116 @@
+/**
+ * @file biquad_filter.cpp
+ * @brief Block biquad filter
+ *
+ * @details This file contains the implementation of the Butterworth biquad cascade.
+ * The second order sections use the Audio EQ Cookbook formulas with the Butterworth pole Q values
+ * Q_k = 1 / (2 sin((2k + 1) pi / 2N)), the first order section uses the bilinear transform.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+// Headers
+#include "biquad_filter.h"
+#include <cstring>
+
+/*
+* @brief Begin function
+*
+* @param[in] type           High-pass or low-pass
+* @param[in] order          Filter order, 1 to `BIQUAD_MAX_ORDER`
+* @param[in] cutoff         The -3 dB frequency in Hz
+* @param[in] sampleRate     The sample rate in Hz
+* @return False when the order or cutoff is not supported
+*
+* @details This function designs the coefficients and clears the state.
+*/
+bool BiquadFilter::begin(FilterType type, int order, float cutoff, float sampleRate)
+{
+    if (order < 1 || order > BIQUAD_MAX_ORDER)
+        return false;
+
+    filterType = type;
+    filterOrder = order;
+    if (!setCutoff(cutoff, sampleRate))
+        return false;
+
+    arm_biquad_cascade_df2T_init_f32(&instance, (order + 1) / 2, coefficients, state);
+    return true;
+}
+
+/*
+* @brief Set cutoff function
+*
+* @param[in] cutoff         The -3 dB frequency in Hz
+* @param[in] sampleRate     The sample rate in Hz
+* @return False when the cutoff is not supported
+*
+* @details This function redesigns the coefficients and keeps the state, so the cutoff can be moved
+* between two blocks while the filter runs. Small steps do not click.
+*/
+bool BiquadFilter::setCutoff(float cutoff, float sampleRate)
+{
+    if (cutoff <= 0.0f || cutoff >= sampleRate / 2.0f)
+        return false;
+
+    cutoffFreq = cutoff;
+    const int order = filterOrder;
+    const FilterType type = filterType;
+
+    const float w0 = 2.0f * PI * cutoff / sampleRate;
+    const float cosW0 = cosf(w0);
+    const float sinW0 = sinf(w0);
+    const bool highpass = (type == FilterType::Highpass);
+    float *c = coefficients;
+
+    for (int k = 0; k < order / 2; k++)
+    {
+        const float q = 1.0f / (2.0f * sinf((2 * k + 1) * PI / (2.0f * order)));
+        const float alpha = sinW0 / (2.0f * q);
+        const float a0 = 1.0f + alpha;
+        const float b1 = highpass ? -(1.0f + cosW0) : (1.0f - cosW0);
+
+        c[0] = (b1 * (highpass ? -0.5f : 0.5f)) / a0;
+        c[1] = b1 / a0;
+        c[2] = c[0];
+        c[3] = (2.0f * cosW0) / a0;     // -a1
+        c[4] = -(1.0f - alpha) / a0;    // -a2
+        c += 5;
+    }
+
+    if (order % 2)
+    {
+        const float k = tanf(w0 / 2.0f);
+        const float norm = 1.0f / (1.0f + k);
+
+        c[0] = highpass ? norm : k * norm;
+        c[1] = highpass ? -norm : k * norm;
+        c[2] = 0.0f;
+        c[3] = (1.0f - k) * norm;       // -a1
+        c[4] = 0.0f;
+    }
+    return true;
+}
+
+/*
+* @brief Reset function
+*
+* @details This function clears the filter state.
+*/
+void BiquadFilter::reset()
+{
+    memset(state, 0, sizeof(state));
+}
+
+/*
+* @brief Process function
+*
+* @param[in,out] block  The samples, filtered in place
+* @param[in] samples    Number of samples
+*/
+void BiquadFilter::process(float *block, int samples)
+{
+    arm_biquad_cascade_df2T_f32(&instance, block, block, samples);
+}
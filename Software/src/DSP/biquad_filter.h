@@ -0,0 +1,58 @@
+/**
+ * @file biquad_filter.h
+ * @brief Header file for the block biquad filter
+ *
+ * @details This file contains the declaration of a Butterworth high-pass or low-pass filter of selectable order,
+ * built as a cascade of biquads. Every instance has its own state, so each stream can have its own
+ * conditioning filter. Blocks of float samples are filtered in place with the CMSIS
+ * arm_biquad_cascade_df2T_f32() on the Teensy and its portable version on the native build.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+#ifndef BIQUAD_FILTER_H
+#define BIQUAD_FILTER_H
+
+// Headers
+#include "HAL/hal.h"
+
+// Defines
+static const int BIQUAD_MAX_ORDER = 8;
+static const int BIQUAD_MAX_STAGES = (BIQUAD_MAX_ORDER + 1) / 2;
+
+enum class FilterType
+{
+    Highpass,
+    Lowpass
+};
+
+/*
+* @class BiquadFilter
+* @brief Butterworth filter as a cascade of transposed direct form II biquads
+*
+* @details An odd order adds a first order section, stored as a biquad with b2 = a2 = 0.
+*/
+class BiquadFilter
+{
+    public:
+        bool begin(FilterType type, int order, float cutoff, float sampleRate);
+        bool setCutoff(float cutoff, float sampleRate);
+        void reset();
+        void process(float *block, int samples);
+
+        int order() const { return filterOrder; }
+        float cutoff() const { return cutoffFreq; }
+
+    private:
+        FilterType filterType = FilterType::Highpass;
+        int filterOrder = 0;
+        float cutoffFreq = 0.0f;
+
+        arm_biquad_cascade_df2T_instance_f32 instance;
+        float coefficients[5 * BIQUAD_MAX_STAGES]; // {b0, b1, b2, -a1, -a2} per stage
+        float state[2 * BIQUAD_MAX_STAGES];
+};
+
+#endif // BIQUAD_FILTER_H
@@ -0,0 +1,93 @@
+/**
+ * @file capture_sync.cpp
+ * @brief Synchronized capture of the carrier and modulator streams
+ *
+ * @details This file contains the implementation of the alignment per audio update. An update in which no stream
+ * delivered a block (the capture is stopped) does not advance the clock, so a stopped capture is not counted as drift.
+ * The alignment is per block: a stream that runs slower than the clock is kept within one block of it,
+ * the remaining part of a block is reported as drift but not resampled.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+// Headers
+#include "capture_sync.h"
+#include <cstring>
+
+/*
+* @brief Begin function
+*
+* @param[in] streams    Number of streams, up to `CAPTURE_MAX_STREAMS`
+*/
+void CaptureSync::begin(int streams)
+{
+    this->streams = (streams > CAPTURE_MAX_STREAMS) ? CAPTURE_MAX_STREAMS : streams;
+    sampleClock = 0;
+    memset(firstTimestamp, 0, sizeof(firstTimestamp));
+    memset(lastTimestamp, 0, sizeof(lastTimestamp));
+    memset(delivered, 0, sizeof(delivered));
+    memset(concealed, 0, sizeof(concealed));
+    memset(lastSample, 0, sizeof(lastSample));
+}
+
+/*
+* @brief Align cycle function
+*
+* @param[in,out] blocks The block of every stream of this audio update, nullptr when missing.
+* Missing blocks are replaced by a concealment block.
+* @return False when no stream delivered a block, nothing has to be written then
+*/
+bool CaptureSync::alignCycle(const int16_t *blocks[])
+{
+    bool any = false;
+    for (int s = 0; s < streams; s++)
+    {
+        any = any || blocks[s] != nullptr;
+    }
+    if (!any)
+        return false;
+
+    for (int s = 0; s < streams; s++)
+    {
+        if (blocks[s])
+        {
+            firstTimestamp[s] = (delivered[s] == 0) ? sampleClock : firstTimestamp[s];
+            lastTimestamp[s] = sampleClock;
+            lastSample[s] = blocks[s][CAPTURE_BLOCK_SAMPLES - 1];
+            delivered[s]++;
+            continue;
+        }
+
+        // Ramp from the last sample to silence, after that the stream stays silent until it delivers again
+        int16_t *block = concealment[s];
+        for (int i = 0; i < CAPTURE_BLOCK_SAMPLES; i++)
+        {
+            block[i] = (int16_t)(lastSample[s] * (CAPTURE_BLOCK_SAMPLES - 1 - i) / CAPTURE_BLOCK_SAMPLES);
+        }
+        lastSample[s] = 0;
+        concealed[s] += (delivered[s] > 0) ? 1 : 0;
+        blocks[s] = block;
+    }
+
+    sampleClock += CAPTURE_BLOCK_SAMPLES;
+    return true;
+}
+
+/*
+* @brief Stats function
+*
+* @param[in] stream The stream
+* @return The counters of the stream
+*/
+CaptureStreamStats CaptureSync::stats(int stream) const
+{
+    CaptureStreamStats stats;
+    const uint32_t clock = (delivered[stream] > 0) ? sampleClock - firstTimestamp[stream] : 0;
+    stats.blocks = delivered[stream];
+    stats.concealed = concealed[stream];
+    stats.offset = (int32_t)(stats.blocks * CAPTURE_BLOCK_SAMPLES - clock);
+    stats.driftPpm = (clock > 0) ? stats.offset * 1e6f / clock : 0.0f;
+    return stats;
+}
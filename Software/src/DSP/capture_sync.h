@@ -0,0 +1,76 @@
+/**
+ * @file capture_sync.h
+ * @brief Header file for the synchronized capture of the carrier and modulator streams
+ *
+ * @details This file contains the declaration of the stage that keeps the captured input streams aligned on one
+ * sample clock. The carrier comes from the I2S input and the modulator from the ADC, which has its own conversion
+ * timing, so a modulator block can be missing from an audio update while the carrier block is there.
+ * Without compensation the modulator ring would from then on lag the carrier rings by a block,
+ * and the two FFTs of a frame would analyze different time windows.
+ *
+ * The shared sample clock counts `CAPTURE_BLOCK_SAMPLES` per audio update, the update rate is set by the I2S clock.
+ * Every delivered block is timestamped with that clock. A stream whose block is missing gets a concealment block
+ * at its timestamp instead: a ramp from its last sample to silence, so the gap does not click. All rings are then
+ * written in lock-step and every hop of every stream covers the same samples of the shared clock.
+ *
+ * Per stream the offset (delivered samples minus the clock since its first block, the skew that would exist without
+ * compensation) and the drift in ppm are measured. A stream that never delivered a block, an unconnected input,
+ * is silent and not counted.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+#ifndef CAPTURE_SYNC_H
+#define CAPTURE_SYNC_H
+
+// Headers
+#include <cstdint>
+
+// Defines
+static const int CAPTURE_MAX_STREAMS = 8;
+static const int CAPTURE_BLOCK_SAMPLES = 128; // AUDIO_BLOCK_SAMPLES
+
+/*
+* @struct CaptureStreamStats
+* @brief Counters of one captured stream
+*/
+struct CaptureStreamStats
+{
+    uint32_t blocks;        // Delivered blocks
+    uint32_t concealed;     // Missing blocks replaced by a concealment block
+    int32_t offset;         // Delivered samples minus the shared clock since the first block, negative when slower
+    float driftPpm;         // Offset relative to the clock
+};
+
+/*
+* @class CaptureSync
+* @brief Aligns the blocks of several input streams on one sample clock
+*
+* @details alignCycle() is called once per audio update from the capture interrupt, the statistics
+* can be read from any context.
+*/
+class CaptureSync
+{
+    public:
+        void begin(int streams);
+        bool alignCycle(const int16_t *blocks[]);
+
+        int streamCount() const { return streams; }
+        uint32_t clock() const { return sampleClock; }
+        uint32_t timestamp(int stream) const { return lastTimestamp[stream]; }
+        CaptureStreamStats stats(int stream) const;
+
+    private:
+        int streams = 0;
+        uint32_t sampleClock = 0;                                           // Samples since begin()
+        uint32_t firstTimestamp[CAPTURE_MAX_STREAMS] = {};                  // Clock of the first delivered block
+        uint32_t lastTimestamp[CAPTURE_MAX_STREAMS] = {};                   // Clock of the last delivered block
+        uint32_t delivered[CAPTURE_MAX_STREAMS] = {};                       // Delivered blocks
+        uint32_t concealed[CAPTURE_MAX_STREAMS] = {};
+        int16_t lastSample[CAPTURE_MAX_STREAMS] = {};
+        int16_t concealment[CAPTURE_MAX_STREAMS][CAPTURE_BLOCK_SAMPLES] = {};
+};
+
+#endif // CAPTURE_SYNC_H
@@ -0,0 +1,162 @@
+/**
+ * @file dsp_arena.cpp
+ * @brief DSP memory arena
+ *
+ * @details This file contains the implementation of the DSP memory arena and its memory report.
+ * The report uses one CSV line per buffer, like the profiler output:
+ * mem,<arena>,<buffer>,<offset>,<bytes>,<stage> and a closing mem,<arena>,total,<required>,<size> line.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+// Headers
+#include "dsp_arena.h"
+#include <cstdio>
+
+/*
+* @brief Begin function
+*
+* @param[in] name   Name of the arena for the memory report
+* @param[in] region The memory region, aligned to `DSP_ARENA_ALIGNMENT`
+* @param[in] size   Size of the region in bytes
+*
+* @details This function resets the arena, all earlier allocations become invalid.
+*/
+void DspArena::begin(const char *name, void *region, size_t size)
+{
+    arenaName = name;
+    this->region = static_cast<uint8_t*>(region);
+    regionSize = size;
+    top = 0;
+    failed = false;
+    depth = 0;
+    entries = 0;
+}
+
+/*
+* @brief Allocate function
+*
+* @param[in] name   Name of the buffer for the memory report
+* @param[in] bytes  Size of the buffer in bytes
+* @return The buffer aligned to `DSP_ARENA_ALIGNMENT`, nullptr when the region is too small
+*/
+void* DspArena::allocate(const char *name, size_t bytes)
+{
+    const size_t offset = (top + DSP_ARENA_ALIGNMENT - 1) & ~(DSP_ARENA_ALIGNMENT - 1);
+    top = offset + bytes;
+    if (depth > 0 && top > overlayEnd[depth - 1])
+        overlayEnd[depth - 1] = top;
+
+    if (entries < DSP_ARENA_MAX_ENTRIES)
+    {
+        ArenaEntry &entry = entryList[entries++];
+        entry.name = name;
+        entry.offset = offset;
+        entry.bytes = bytes;
+        for (int i = 0; i < DSP_ARENA_MAX_DEPTH; i++)
+        {
+            entry.stage[i] = (i < depth) ? stageName[i] : nullptr;
+        }
+    }
+    else
+    {
+        failed = true;
+    }
+
+    if (top > regionSize)
+    {
+        failed = true;
+        return nullptr;
+    }
+    return region + offset;
+}
+
+/*
+* @brief Begin overlay function
+*
+* @return False when the overlays are nested too deep
+*
+* @details Call beginStage() before the first allocation of the overlay.
+*/
+bool DspArena::beginOverlay()
+{
+    if (depth >= DSP_ARENA_MAX_DEPTH)
+    {
+        failed = true;
+        return false;
+    }
+
+    overlayBase[depth] = top;
+    overlayEnd[depth] = top;
+    stageName[depth] = nullptr;
+    depth++;
+    return true;
+}
+
+/*
+* @brief Begin stage function
+*
+* @param[in] name   Name of the stage for the memory report
+*
+* @details The following allocations start at the base of the innermost overlay,
+* so they share memory with the allocations of the earlier stages.
+*/
+void DspArena::beginStage(const char *name)
+{
+    if (depth == 0)
+        return;
+
+    top = overlayBase[depth - 1];
+    stageName[depth - 1] = name;
+}
+
+/*
+* @brief End overlay function
+*
+* @details The overlay takes the size of its largest stage. In a nested overlay
+* that size also counts for the stage of the outer overlay.
+*/
+void DspArena::endOverlay()
+{
+    if (depth == 0)
+        return;
+
+    depth--;
+    top = overlayEnd[depth];
+    if (depth > 0 && top > overlayEnd[depth - 1])
+        overlayEnd[depth - 1] = top;
+}
+
+/*
+* @brief Format entry function
+*
+* @param[in] index  The entry
+* @param[out] line  The CSV line
+* @param[in] size   Size of the line buffer
+* @return Number of characters written, 0 for an invalid index
+*/
+int DspArena::formatEntry(int index, char *line, size_t size) const
+{
+    if (index < 0 || index >= entries)
+        return 0;
+
+    const ArenaEntry &entry = entryList[index];
+    const char *outer = entry.stage[0] ? entry.stage[0] : "-";
+    const char *inner = entry.stage[1];
+    return snprintf(line, size, "mem,%s,%s,%lu,%lu,%s%s%s", arenaName, entry.name, (unsigned long)entry.offset,
+                    (unsigned long)entry.bytes, outer, inner ? "/" : "", inner ? inner : "");
+}
+
+/*
+* @brief Format summary function
+*
+* @param[out] line  The CSV line
+* @param[in] size   Size of the line buffer
+* @return Number of characters written
+*/
+int DspArena::formatSummary(char *line, size_t size) const
+{
+    return snprintf(line, size, "mem,%s,total,%lu,%lu", arenaName, (unsigned long)top, (unsigned long)regionSize);
+}
@@ -0,0 +1,103 @@
+/**
+ * @file dsp_arena.h
+ * @brief Header file for the DSP memory arena
+ *
+ * @details This file contains the declaration of a bump allocator over one statically sized memory region.
+ * All large DSP buffers are assigned from an arena at boot instead of being separate global arrays,
+ * so the memory map is explicit: every buffer has a name, an offset and a placement in fast or slow memory,
+ * and the complete map can be printed as a memory report.
+ *
+ * Buffers whose lifetimes do not overlap can share memory. Allocations between beginOverlay() and endOverlay()
+ * are grouped in stages: every stage starts at the same address and the overlay takes the size of its largest stage.
+ * Overlays can be nested once, so a stage can be split into shorter lived stages again.
+ *
+ * @note Nothing is ever freed, begin() resets the whole arena. The region is not cleared, every owner of a buffer
+ * initializes it (the slow region is not zeroed at startup on the Teensy).
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+#ifndef DSP_ARENA_H
+#define DSP_ARENA_H
+
+// Headers
+#include <cstddef>
+#include <cstdint>
+
+// Defines
+static const size_t DSP_ARENA_ALIGNMENT = 32; // Cortex-M7 cache line
+static const int DSP_ARENA_MAX_ENTRIES = 32;
+static const int DSP_ARENA_MAX_DEPTH = 2;     // Nesting depth of overlays
+
+/*
+* @struct ArenaEntry
+* @brief One named allocation of an arena
+*/
+struct ArenaEntry
+{
+    const char *name;
+    const char *stage[DSP_ARENA_MAX_DEPTH]; // The overlay stages from outer to inner, nullptr outside an overlay
+    size_t offset;
+    size_t bytes;
+};
+
+/*
+* @class DspArena
+* @brief Bump allocator with overlays for buffers with disjoint lifetimes
+*
+* @details An allocation that does not fit returns nullptr, the arena then keeps counting,
+* so required() reports the size the region would need.
+*/
+class DspArena
+{
+    public:
+        void begin(const char *name, void *region, size_t size);
+        void* allocate(const char *name, size_t bytes);
+
+        /*
+        * @brief Typed allocate function
+        *
+        * @tparam T         Element type
+        * @param[in] name   Name of the buffer for the memory report
+        * @param[in] count  Number of elements
+        * @return The buffer, nullptr when the region is too small
+        */
+        template <typename T>
+        T* allocate(const char *name, size_t count)
+        {
+            return static_cast<T*>(allocate(name, count * sizeof(T)));
+        }
+
+        bool beginOverlay();
+        void beginStage(const char *name);
+        void endOverlay();
+
+        const char* name() const { return arenaName; }
+        size_t size() const { return regionSize; }
+        size_t required() const { return top; }
+        bool fits() const { return top <= regionSize && !failed; }
+
+        int entryCount() const { return entries; }
+        const ArenaEntry& entry(int index) const { return entryList[index]; }
+        int formatEntry(int index, char *line, size_t size) const;
+        int formatSummary(char *line, size_t size) const;
+
+    private:
+        const char *arenaName = "";
+        uint8_t *region = nullptr;
+        size_t regionSize = 0;
+        size_t top = 0;             // Next free offset
+        bool failed = false;        // An allocation did not fit or there were too many entries
+
+        int depth = 0;
+        size_t overlayBase[DSP_ARENA_MAX_DEPTH];
+        size_t overlayEnd[DSP_ARENA_MAX_DEPTH];
+        const char *stageName[DSP_ARENA_MAX_DEPTH];
+
+        int entries = 0;
+        ArenaEntry entryList[DSP_ARENA_MAX_ENTRIES];
+};
+
+#endif // DSP_ARENA_H
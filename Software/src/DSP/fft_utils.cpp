@@ -5,6 +5,8 @@
  * @details This file contains utility functions for performing FFT operations.
  * It includes functions for getting FFT configuration, extracting magnitude and phase,
  * performing inverse FFT, and processing FFT.
+ * The audio is real, so a real FFT is used and only the fftSize / 2 + 1 unique bins are processed.
+ * Spectra use the CMSIS packed format: [Re X(0), Re X(N/2), Re X(1), Im X(1), Re X(2), Im X(2), ...].
  *  
  * @author Tim Wannet
  * @date 20-05-2025
@@ -13,56 +15,95 @@
 
 // Headers
 #include "fft_utils.h"
+#include "spectral_kernel.h"
+#include <cstring>
 
 // Variables
-const float sampleRate = 44100.0; // Sample rate in Hz
-const float cutoffFreq = 100.0; // Cutoff frequency for highpass filter
-
-float prev_input = 0.0;
-float prev_output = 0.0;
-float RC = 1.0 / (2 * PI * cutoffFreq);  // e.g., 200 Hz
-float dt = 1.0 / sampleRate;
-float alpha = RC / (RC + dt);
-
-float noiseUnvoiced = static_cast<float>(rand()) / RAND_MAX - 0.5f; // -0.5 to +0.5
-float unvoicedNoiseStrength = 0.9f; // scale to taste
-float noiseVoiced = static_cast<float>(rand()) / RAND_MAX - 0.5f;
-float voicedNoiseStrength = 0.4f;
+float unvoicedNoiseStrength = 0.0f; // Set per frame from the parameter registry (see parameters.h)
+float noiseVoiced = static_cast<float>(rand()) / RAND_MAX - 0.5f; // -0.5 to +0.5
+float voicedNoiseStrength = 0.0f;
+static NoiseGenerator excitationNoise; // Unvoiced frames, a new value per bin
+float formantShiftRatio = 1.0f; // Frequency ratio of the modulator formants, 1 is unshifted
+
+GainCurve gainCurve; // Gain curve: carrier * modulator^exponent
+float gainScale;
+
+arm_rfft_fast_instance_f32 rfftInstances[6]; // One planned instance per supported size
+
 /*
 * @brief Get FFT Configuration function
 *
 * @param[in] size The FFT size
 *
-* @details This function returns the FFT configuration based on the FFT size.
+* @details This function returns the real FFT configuration based on the FFT size.
+* Every size has its own instance, planned on first use, so switching sizes at runtime is free.
 */
-const arm_cfft_instance_f32* getFFTConfig(int size) 
+arm_rfft_fast_instance_f32* getFFTConfig(int size) 
 {
+    int index;
     switch (size)
     {
-        case 128:  return &arm_cfft_sR_f32_len128;
-        case 256:  return &arm_cfft_sR_f32_len256;
-        case 512:  return &arm_cfft_sR_f32_len512;
-        case 1024: return &arm_cfft_sR_f32_len1024;
-        case 2048: return &arm_cfft_sR_f32_len2048;
-        case 4096: return &arm_cfft_sR_f32_len4096;
+        case 128:  index = 0; break;
+        case 256:  index = 1; break;
+        case 512:  index = 2; break;
+        case 1024: index = 3; break;
+        case 2048: index = 4; break;
+        case 4096: index = 5; break;
         default:   return nullptr; // Handle error
     }
+
+    arm_rfft_fast_instance_f32 *instance = &rfftInstances[index];
+    if (instance->fftLenRFFT != size && arm_rfft_fast_init_f32(instance, size) != ARM_MATH_SUCCESS)
+        return nullptr;
+    return instance;
+}
+
+/*
+* @brief Set gain exponent function
+*
+* @param[in] exponent   The exponent of the modulator in the gain curve
+*
+* @details This function precomputes the modulator gain curve lookup table, called by the DSP between two frames.
+* The modulator and carrier are normalized to the 16-bit range (32768), the output is scaled back to 30768.
+*/
+void setGainExponent(float exponent)
+{
+    gainCurve.begin(exponent);
+    gainScale = (30768.0f / 32768.0f) * powf(32768.0f, -exponent);
+}
+
+/*
+* @brief Reset excitation noise function
+*
+* @details Restarts the noise of the unvoiced frames, called by initVocoder() so every render starts the same.
+*/
+void resetExcitationNoise()
+{
+    excitationNoise.seed();
 }
 
 /*
 * @brief Get Magnitude and Phase function
 *
-* @param[in] buffer         The audio data buffer
-* @param[out] magnitude     The magnitude information
-* @param[out] phase         The phase information
+* @param[in] buffer         The packed spectrum of fftSize floats
+* @param[out] magnitude     The magnitude information, fftSize / 2 + 1 bins
+* @param[out] phase         The phase information, fftSize / 2 + 1 bins
 *
 * @details This function extracts the magnitude and phase from the buffer in the frequency domain.
 * The magnitude is calculated as the square root of the sum of the squares of the real and imaginary parts.
 * The phase is calculated as the arctangent of the imaginary part divided by the real part.
+* DC and Nyquist are purely real and stored in the first two floats of the packed spectrum.
 */
 void getMagnitudeAndPhase(float *buffer, float *magnitude, float *phase)
 {
-    for (int i = 0; i < FFT_SIZE; i++)
+    const int nyquist = fftSize / 2;
+
+    magnitude[0] = fabsf(buffer[0]);
+    phase[0] = (buffer[0] < 0.0f) ? PI : 0.0f;
+    magnitude[nyquist] = fabsf(buffer[1]);
+    phase[nyquist] = (buffer[1] < 0.0f) ? PI : 0.0f;
+
+    for (int i = 1; i < nyquist; i++)
     {
         float real = buffer[2 * i];
         float imag = buffer[2 * i + 1];
@@ -72,7 +113,7 @@ void getMagnitudeAndPhase(float *buffer, float *magnitude, float *phase)
 
     // // Debug print: Print first 8 bins of magnitude and phase
     // Serial.println("FFT Debug Output:");
-    // for (int i = 0; i < 8 && i < FFT_SIZE; i++) {
+    // for (int i = 0; i < 8 && i < fftSize; i++) {
     //     Serial.print("Bin ");
     //     Serial.print(i);
     //     Serial.print(": Magnitude = ");
@@ -82,128 +123,120 @@ void getMagnitudeAndPhase(float *buffer, float *magnitude, float *phase)
     // }
 }
 
-bool isUnvoiced(const float* magnitude) 
+/*
+* @brief Modulator gain function
+*
+* @param[in] modulatorMagnitude The modulator magnitude information
+* @param[out] modulatorGain     The modulator part of the gain per bin (fftSize / 2 + 1 bins),
+* the noise amplitude per bin for unvoiced frames
+* @return True when the frame is unvoiced
+*
+* @details This function computes everything of the vocoding gain that depends on the modulator only:
+* the voicing decision (see voicing_detector.h) and the gain curve of the smoothed modulator envelope
+* (see spectral_envelope.h), so the modulator pitch harmonics are not imprinted on the carrier.
+* An unvoiced frame is replaced by noise with the spectrum of the modulator, so a sibilant keeps its color.
+* Both gains are warped by `formantShiftRatio`, which moves the formants without touching the carrier pitch.
+* It runs once per frame, every carrier voice then only adds its own term in vocodeCarrier().
+*/
+bool computeModulatorGain(const float *modulatorMagnitude, float *modulatorGain)
 {
-    constexpr float SAMPLE_RATE = 44100.0f;
-    constexpr int FFT_SIZE = 2048;
-    constexpr float BIN_WIDTH = SAMPLE_RATE / FFT_SIZE;
-
-    // Define band ranges (you can tune these further)
-    const int lowStart = (int)(80 / BIN_WIDTH);
-    const int lowEnd   = (int)(500 / BIN_WIDTH);
-
-    const int highStart = (int)(3000 / BIN_WIDTH);
-    const int highEnd   = (int)(8000 / BIN_WIDTH);
-
-    float lowEnergy = 0.0f;
-    float highEnergy = 0.0f;
-
-    for (int i = lowStart; i < lowEnd; i++) {
-        lowEnergy += magnitude[i];
+    const int bins = fftSize / 2 + 1;
+    if (voicingDetector.classify(modulatorMagnitude))
+    {
+        const float level = unvoicedNoiseStrength * NOISE_RMS_SCALE;
+        for (int i = 0; i < bins; i++)
+        {
+            modulatorGain[i] = level * modulatorMagnitude[i];
+        }
+        warpSpectrum(modulatorGain, bins, formantShiftRatio);
+        return true;
     }
 
-    for (int i = highStart; i < highEnd; i++) {
-        highEnergy += magnitude[i];
+    if (modulatorEnvelope.method() == EnvelopeMethod::None)
+    {
+        computeCurveGain(modulatorMagnitude, modulatorGain, bins, gainCurve, gainScale);
     }
-
-    // Avoid divide-by-zero
-    if (lowEnergy < 1e-5f) lowEnergy = 1e-5f;
-
-    float ratio = highEnergy / lowEnergy;
-
-    // You can tune this threshold — try values between 3.0 and 6.0
-    return (ratio > 4.0f);
+    else
+    {
+        modulatorEnvelope.process(modulatorMagnitude);
+        modulatorEnvelope.expandGain(gainCurve, gainScale, modulatorGain, bins);
+    }
+    warpSpectrum(modulatorGain, bins, formantShiftRatio);
+    return false;
 }
 
 /*
-* @brief Inverse FFT function
+* @brief Vocode carrier function
 *
-* @param[in] buffer             The audio data buffer
+* @param[in,out] buffer         The packed carrier spectrum of fftSize floats, replaced by the output spectrum
+* @param[out] outputBuffer      The reconstructed time domain frame, fftSize floats
 * @param[in] carrierMagnitude   The carrier magnitude information
-* @param[in] carrierPhase       The carrier phase information
-* @param[in] modulatorMagnitude The modulator magnitude information
-* @param[in] modulatorPhase     The modulator phase information
+* @param[in] modulatorGain      The modulator gain from computeModulatorGain()
+* @param[in] unvoiced           The voicing decision from computeModulatorGain()
+* @param[out] gain              The applied gain per bin (fftSize / 2 + 1 bins), may be the modulator gain buffer
 *
-* @details This function reconstructs the signal from the magnitude and phase information.
-* It then performs an inverse FFT to return to the time domain.
+* @details This function vocodes the carrier spectrum with the modulator gain.
+* Voiced frames scale the complex carrier bins by the gain plus the voiced noise, which keeps the carrier phase
+* without converting to polar form. Unvoiced frames replace the spectrum by noise, a new random value per bin
+* with the amplitude from computeModulatorGain(), so every voice and every frame gets its own noise.
+* It then performs an inverse real FFT to return to the time domain.
 */
-void inverseFFT(float *buffer, float *carrierMagnitude, float *carrierPhase, float *modulatorMagnitude, float *modulatorPhase)
+void vocodeCarrier(float *buffer, float *outputBuffer, const float *carrierMagnitude, const float *modulatorGain, bool unvoiced, float *gain)
 {
+    const int nyquist = fftSize / 2;
 
-    float lowEnergy = 0.0f;
-    float highEnergy = 0.0f;
-
-    for (int i = 0; i < FFT_SIZE / 2; i++) {
-        if (i < FFT_SIZE / 16) { // Low frequencies (e.g. ~0–500Hz)
-            lowEnergy += modulatorMagnitude[i];
-        } else if (i > FFT_SIZE / 10) { // High frequencies (e.g. >1kHz)
-            highEnergy += modulatorMagnitude[i];
-        }
-    }
-
-    // bool isUnvoiced = (highEnergy > lowEnergy * 1.0f) && (highEnergy > 0.01f);
-    bool is_unvoiced = isUnvoiced(modulatorMagnitude);
-
-    if (is_unvoiced) 
+    if (unvoiced) 
     {
-        for (int i = 0; i < FFT_SIZE / 2; i++) 
-        {
-            buffer[2 * i] = noiseUnvoiced * unvoicedNoiseStrength; // real
-            buffer[2 * i + 1] = noiseUnvoiced * unvoicedNoiseStrength; // imaginary
-        }
+        applyNoiseExcitation(buffer, modulatorGain, fftSize, excitationNoise);
     }
     else
     {
-        for (int i = 0; i < FFT_SIZE; i++) 
-        {
-            float normalizedMod = modulatorMagnitude[i] / 32768.0f;  // Assuming 16-bit range
-            float normalizedCarrier = carrierMagnitude[i] / 32768.0f;
-            float fftMagnitude = normalizedCarrier * pow(normalizedMod, 0.4f) * 30768.0f; // Scale back
-            fftMagnitude += noiseVoiced * voicedNoiseStrength * 30768.0f;; // Add noise to voiced signal 
-
-            buffer[2 * i] = fftMagnitude * cosf(carrierPhase[i]); // Real part
-            buffer[2 * i + 1] = fftMagnitude * sinf(carrierPhase[i]); // Imaginary part
-        }
+        // |carrier| * scale * modulator^0.4 plus the voiced noise, along the carrier phase
+        float voicedOffset = noiseVoiced * voicedNoiseStrength * 30768.0f;
+        if (gain != modulatorGain)
+            memcpy(gain, modulatorGain, (nyquist + 1) * sizeof(float));
+        addCarrierOffset(carrierMagnitude, gain, nyquist + 1, voicedOffset);
+        applySpectralGain(buffer, gain, fftSize);
     }
     // Perform Inverse FFT
-    arm_cfft_f32(fftConfig, buffer, 1, 1);
+    arm_rfft_fast_f32(fftConfig, buffer, outputBuffer, 1);
 
 }
 
 /*
-* @brief Process FFT function
+* @brief Inverse FFT function
 *
-* @param[in] buffer         The audio data buffer
-* @param[in] floatBuffer    The float buffer
-* @param[out] magnitude     The magnitude information
-* @param[out] phase         The phase information 
+* @param[in,out] buffer         The packed carrier spectrum of fftSize floats, replaced by the output spectrum
+* @param[out] outputBuffer      The reconstructed time domain frame, fftSize floats
+* @param[in] carrierMagnitude   The carrier magnitude information
+* @param[in] modulatorMagnitude The modulator magnitude information
+* @param[out] gain              The applied gain per bin (fftSize / 2 + 1 bins)
 *
-* @details This function performs the FFT on the audio data in the buffer.
-* It converts the audio data to float, performs the FFT, and extracts the magnitude and phase information.
+* @details This function vocodes a single carrier with the modulator magnitude,
+* it is computeModulatorGain() followed by vocodeCarrier().
 */
-void processFFT(float *floatBuffer, float *magnitude, float *phase)
+void inverseFFT(float *buffer, float *outputBuffer, float *carrierMagnitude, float *modulatorMagnitude, float *gain)
 {
-    // Perform FFT
-    arm_cfft_f32(fftConfig, floatBuffer, 0, 1);
-    
-    // Extract magnitude and phase
-    getMagnitudeAndPhase(floatBuffer, magnitude, phase);
-
+    const bool unvoiced = computeModulatorGain(modulatorMagnitude, gain);
+    vocodeCarrier(buffer, outputBuffer, carrierMagnitude, gain, unvoiced, gain);
 }
 
 /*
-* @brief Highpass filter function
+* @brief Process FFT function
 *
-* @param[in] input The input audio data
-* @return The filtered output
+* @param[in] floatBuffer    The real audio frame of fftSize floats, overwritten by the FFT
+* @param[out] spectrum      The packed spectrum of fftSize floats
+* @param[out] magnitude     The magnitude information
 *
-* @details This function implements a simple highpass filter using a single pole IIR filter.
-* The filter is designed to remove low-frequency components from the audio signal.
+* @details This function performs the real FFT on the audio data in the buffer,
+* and extracts the magnitude information. The phase stays in the complex spectrum.
 */
-float highpass(int16_t input)
+void processFFT(float *floatBuffer, float *spectrum, float *magnitude)
 {
-    float output = alpha * (prev_output + input - prev_input);
-    prev_input = input;
-    prev_output = output;
-    return output;
+    // Perform FFT
+    arm_rfft_fast_f32(fftConfig, floatBuffer, spectrum, 0);
+    
+    // Extract magnitude
+    computeMagnitude(spectrum, magnitude, fftSize);
+
 }
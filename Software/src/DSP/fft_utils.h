@@ -11,19 +11,35 @@
     * @version 0.01
 */
 
+#ifndef FFT_UTILS_H
+#define FFT_UTILS_H
+
 // Headers
-#include <arm_math.h>
 #include <cmath>
-#include "arm_const_structs.h"
+#include "HAL/hal.h"
+#include "spectral_envelope.h"
+#include "voicing_detector.h"
 
 // Function prototypes
-const arm_cfft_instance_f32* getFFTConfig(int size);
+arm_rfft_fast_instance_f32* getFFTConfig(int size);
+void setGainExponent(float exponent);
+void resetExcitationNoise();
 void getMagnitudeAndPhase(float *buffer, float *magnitude, float *phase);
-void inverseFFT(float *buffer, float *carrierMagnitude, float *carrierPhase, float *modulatorMagnitude, float *modulatorPhase);
-void processFFT(float *floatBuffer, float *magnitude, float *phase);
-float highpass(int16_t input);
-bool SilentFrame(int16_t *buffer, int size, int threshold);
+bool computeModulatorGain(const float *modulatorMagnitude, float *modulatorGain);
+void vocodeCarrier(float *buffer, float *outputBuffer, const float *carrierMagnitude, const float *modulatorGain, bool unvoiced, float *gain);
+void inverseFFT(float *buffer, float *outputBuffer, float *carrierMagnitude, float *modulatorMagnitude, float *gain);
+void processFFT(float *floatBuffer, float *spectrum, float *magnitude);
 
 // External variables
-extern const arm_cfft_instance_f32* fftConfig;
-extern const int FFT_SIZE;
\ No newline at end of file
+extern arm_rfft_fast_instance_f32* fftConfig;
+extern int fftSize;
+extern SpectralEnvelope modulatorEnvelope;
+extern GainCurve gainCurve;
+extern float gainScale;
+extern float unvoicedNoiseStrength;
+extern float noiseVoiced;
+extern float voicedNoiseStrength;
+extern float formantShiftRatio;
+extern VoicingDetector voicingDetector;
+
+#endif // FFT_UTILS_H
@@ -0,0 +1,150 @@
+/**
+ * @file filterbank_vocoder.cpp
+ * @brief Filter-bank vocoder engine
+ *
+ * @details This file contains the implementation of the classic channel vocoder.
+ * Each band is a cascade of constant-peak band-pass biquads (RBJ cookbook), the modulator band
+ * is rectified and smoothed by an attack/release envelope follower, and the carrier band is
+ * scaled by that envelope. The bands are summed to form the output.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+// Headers
+#include "filterbank_vocoder.h"
+#include <cmath>
+#include <cstring>
+
+/*
+* @brief Begin function
+*
+* @param[in] bands      Number of bands, 1 to FILTERBANK_MAX_BANDS
+* @param[in] lowFreq    Center frequency of the lowest band in Hz
+* @param[in] highFreq   Center frequency of the highest band in Hz
+* @param[in] sampleRate The sample rate in Hz
+* @return True when the configuration is valid
+*
+* @details The center frequencies are spaced logarithmically, the Q is chosen so that
+* neighbouring bands cross at their -3 dB points.
+*/
+bool FilterBankVocoder::begin(int bands, float lowFreq, float highFreq, float sampleRate)
+{
+    if (bands < 1 || bands > FILTERBANK_MAX_BANDS || lowFreq <= 0.0f || highFreq >= sampleRate / 2 || lowFreq >= highFreq)
+        return false;
+
+    this->bandCount = bands;
+    this->sampleRate = sampleRate;
+
+    const float ratio = (bands > 1) ? powf(highFreq / lowFreq, 1.0f / (bands - 1)) : 2.0f;
+    const float q = sqrtf(ratio) / (ratio - 1.0f);
+
+    for (int b = 0; b < bands; b++)
+    {
+        float w0 = 2.0f * (float)M_PI * lowFreq * powf(ratio, (float)b) / sampleRate;
+        float alpha = sinf(w0) / (2.0f * q);
+        float a0 = 1.0f + alpha;
+
+        for (int s = 0; s < FILTERBANK_STAGES; s++)
+        {
+            b0[s][b] = alpha / a0;
+            b2[s][b] = -alpha / a0;
+            a1[s][b] = -2.0f * cosf(w0) / a0;
+            a2[s][b] = (1.0f - alpha) / a0;
+        }
+    }
+
+    // Envelopes are in 16-bit units, scale to roughly the output level of the FFT engine
+    outputGain = 32.0f / (32768.0f * sqrtf((float)bands));
+
+    setEnvelopeTimes(2.0f, 30.0f);
+    reset();
+    return true;
+}
+
+/*
+* @brief Set envelope times function
+*
+* @param[in] attackMs   Attack time constant in milliseconds
+* @param[in] releaseMs  Release time constant in milliseconds
+*/
+void FilterBankVocoder::setEnvelopeTimes(float attackMs, float releaseMs)
+{
+    attackCoeff = 1.0f - expf(-1000.0f / (attackMs * sampleRate));
+    releaseCoeff = 1.0f - expf(-1000.0f / (releaseMs * sampleRate));
+}
+
+/*
+* @brief Reset function
+*
+* @details This function clears the filter state and the envelopes.
+*/
+void FilterBankVocoder::reset()
+{
+    memset(carrierZ1, 0, sizeof(carrierZ1));
+    memset(carrierZ2, 0, sizeof(carrierZ2));
+    memset(modulatorZ1, 0, sizeof(modulatorZ1));
+    memset(modulatorZ2, 0, sizeof(modulatorZ2));
+    memset(envelope, 0, sizeof(envelope));
+}
+
+/*
+* @brief Process function
+*
+* @param[in] carrier    The carrier samples
+* @param[in] modulator  The modulator samples
+* @param[out] output    The vocoded samples
+* @param[in] samples    Number of samples, any block size works (typically 16 to 128)
+*
+* @details Per sample, every band of every stage is updated in one loop over the bands.
+*/
+void FilterBankVocoder::process(const int16_t *carrier, const int16_t *modulator, int16_t *output, int samples)
+{
+    float carrierBand[FILTERBANK_MAX_BANDS];
+    float modulatorBand[FILTERBANK_MAX_BANDS];
+
+    for (int n = 0; n < samples; n++)
+    {
+        const float c = carrier[n];
+        const float m = modulator[n];
+
+        for (int b = 0; b < bandCount; b++)
+        {
+            carrierBand[b] = c;
+            modulatorBand[b] = m;
+        }
+
+        for (int s = 0; s < FILTERBANK_STAGES; s++)
+        {
+            for (int b = 0; b < bandCount; b++)
+            {
+                float x = carrierBand[b];
+                float y = b0[s][b] * x + carrierZ1[s][b];
+                carrierZ1[s][b] = carrierZ2[s][b] - a1[s][b] * y;
+                carrierZ2[s][b] = b2[s][b] * x - a2[s][b] * y;
+                carrierBand[b] = y;
+
+                x = modulatorBand[b];
+                y = b0[s][b] * x + modulatorZ1[s][b];
+                modulatorZ1[s][b] = modulatorZ2[s][b] - a1[s][b] * y;
+                modulatorZ2[s][b] = b2[s][b] * x - a2[s][b] * y;
+                modulatorBand[b] = y;
+            }
+        }
+
+        float sum = 0.0f;
+        for (int b = 0; b < bandCount; b++)
+        {
+            float rectified = fabsf(modulatorBand[b]);
+            float coeff = (rectified > envelope[b]) ? attackCoeff : releaseCoeff;
+            envelope[b] += coeff * (rectified - envelope[b]);
+            sum += carrierBand[b] * envelope[b];
+        }
+
+        float out = sum * outputGain;
+        if (out > 32767.0f) out = 32767.0f;
+        if (out < -32768.0f) out = -32768.0f;
+        output[n] = (int16_t)out;
+    }
+}
@@ -0,0 +1,65 @@
+/**
+ * @file filterbank_vocoder.h
+ * @brief Header file for the filter-bank vocoder engine
+ *
+ * @details This file contains the declaration of the classic channel vocoder: a bank of log-spaced
+ * band-pass filters on the carrier and the modulator, with an envelope follower per modulator band
+ * that sets the level of the matching carrier band.
+ * It runs sample by sample, so its latency is one audio block instead of one FFT frame.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+#ifndef FILTERBANK_VOCODER_H
+#define FILTERBANK_VOCODER_H
+
+// Headers
+#include <cstdint>
+
+// Defines
+static const int FILTERBANK_MAX_BANDS = 40;
+static const int FILTERBANK_STAGES = 2; // Biquads per band, 2 gives 24 dB/octave skirts
+
+/*
+* @class FilterBankVocoder
+* @brief Band-pass filter-bank vocoder
+*
+* @details The filter state is stored per stage as arrays over the bands (structure of arrays),
+* so the inner loops run across the bands and are vectorized by the compiler.
+*/
+class FilterBankVocoder
+{
+    public:
+        bool begin(int bands, float lowFreq, float highFreq, float sampleRate);
+        void setEnvelopeTimes(float attackMs, float releaseMs);
+        void reset();
+        void process(const int16_t *carrier, const int16_t *modulator, int16_t *output, int samples);
+
+        int bands() const { return bandCount; }
+        const float* envelopes() const { return envelope; }
+
+    private:
+        int bandCount = 0;
+        float sampleRate = 44100.0f;
+
+        // Band-pass biquad coefficients (b1 is zero), normalized to a0 = 1
+        float b0[FILTERBANK_STAGES][FILTERBANK_MAX_BANDS];
+        float b2[FILTERBANK_STAGES][FILTERBANK_MAX_BANDS];
+        float a1[FILTERBANK_STAGES][FILTERBANK_MAX_BANDS];
+        float a2[FILTERBANK_STAGES][FILTERBANK_MAX_BANDS];
+
+        // Transposed direct form II state
+        float carrierZ1[FILTERBANK_STAGES][FILTERBANK_MAX_BANDS];
+        float carrierZ2[FILTERBANK_STAGES][FILTERBANK_MAX_BANDS];
+        float modulatorZ1[FILTERBANK_STAGES][FILTERBANK_MAX_BANDS];
+        float modulatorZ2[FILTERBANK_STAGES][FILTERBANK_MAX_BANDS];
+
+        float envelope[FILTERBANK_MAX_BANDS];
+        float attackCoeff = 0.0f;
+        float releaseCoeff = 0.0f;
+        float outputGain = 1.0f;
+};
+
+#endif // FILTERBANK_VOCODER_H
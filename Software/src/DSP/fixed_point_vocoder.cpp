@@ -0,0 +1,563 @@
+/**
+ * @file fixed_point_vocoder.cpp
+ * @brief Fixed-point FFT vocoder engine
+ *
+ * @details This file contains the implementation of the fixed-point FFT vocoder.
+ * The real FFT of length N is a complex FFT of length N / 2 (arm_cfft_q31) plus a split step,
+ * the same algorithm as the native arm_rfft_fast_f32(). arm_cfft_q31() scales its output down by N / 2,
+ * the split step adds another 1 / 2, so the packed spectrum is the DFT divided by N.
+ *
+ * Block exponents, so every value v of a buffer stands for v * 2^exponent in the float engine:
+ * - Frame: the windowed samples (times 2^15) are shifted up until the peak is just below 2^30.
+ * - Magnitude: 2.30 format from arm_cmplx_mag_q31(), the exponent is log2(N) - 14 - shift.
+ * - Output spectrum: chosen from an upper bound of gain * |carrier| + offset, so the peak is below 2^29.
+ *   The inverse split step needs these 2 bits of headroom.
+ * - Accumulator: fixed, ACCUMULATOR_BITS fractional bits.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+// Headers
+#include "fixed_point_vocoder.h"
+#include <cstring>
+#include "fft_utils.h"
+#include "frame_size_manager.h"
+
+// Variables
+static const int ACCUMULATOR_BITS = 11; // Fractional bits of the overlap-add accumulator, 3 bits headroom above 4x full scale
+static const int OUTPUT_SCALE_BITS = 2; // The output is scaled down by 4, like convertFloatToInt16()
+
+static q31_t splitTwiddle[MAX_FFT_SIZE / 2 + 2]; // exp(-j*2*pi*k/MAX_FFT_SIZE) for k <= MAX_FFT_SIZE / 4, interleaved
+static bool splitTwiddleReady = false;
+
+/*
+* @brief Multiply Q31 function
+*
+* @param[in] a  First factor in Q31
+* @param[in] b  Second factor in Q31
+* @return The product in Q31
+*/
+static inline q31_t multiplyQ31(q31_t a, q31_t b)
+{
+    return (q31_t)(((q63_t)a * b) >> 31);
+}
+
+/*
+* @brief Shift Q63 function
+*
+* @param[in] value  The value
+* @param[in] shift  Right shift, negative for a left shift
+* @return value * 2^-shift, zero when every bit is shifted out
+*/
+static inline q63_t shiftQ63(q63_t value, int shift)
+{
+    if (shift >= 63)
+        return 0;
+    if (shift >= 0)
+        return value >> shift;
+    return value * ((q63_t)1 << -shift);
+}
+
+/*
+* @brief Saturate Q31 function
+*
+* @param[in] value  The value
+* @return The value clamped to the Q31 range
+*/
+static inline q31_t saturateQ31(q63_t value)
+{
+    return (value > INT32_MAX) ? INT32_MAX : (value < INT32_MIN) ? INT32_MIN : (q31_t)value;
+}
+
+/*
+* @brief Float to Q15 function
+*
+* @param[in] value  The value, -1 to 1
+* @return The value in Q15, +1 saturates to 32767
+*/
+static inline q15_t floatToQ15(float value)
+{
+    long scaled = lrintf(value * 32768.0f);
+    return (q15_t)((scaled > 32767) ? 32767 : (scaled < -32768) ? -32768 : scaled);
+}
+
+/*
+* @brief Float to Q31 function
+*
+* @param[in] value  The value, -1 to 1
+* @return The value in Q31, +1 saturates to 2^31 - 1
+*/
+static inline q31_t floatToQ31(float value)
+{
+    const double scaled = (double)value * 2147483648.0;
+    return (scaled >= 2147483647.0) ? INT32_MAX : (scaled <= -2147483648.0) ? INT32_MIN : (q31_t)llround(scaled);
+}
+
+/*
+* @brief Unit vector function
+*
+* @param[in] real           Real part of the bin
+* @param[in] imag           Imaginary part of the bin
+* @param[in] magnitude      Magnitude of the bin in 2.30 format, half the Q31 magnitude
+* @param[out] unitReal      Real part of bin / |bin| in Q15
+* @param[out] unitImag      Imaginary part of bin / |bin| in Q15
+*
+* @details Both parts share one 32-bit division: the magnitude is reduced to 15 bits, its reciprocal
+* is then exact to 15 bits as well. A zero bin has no direction and gives a zero vector.
+*/
+static inline void unitVector(q31_t real, q31_t imag, q31_t magnitude, q31_t &unitReal, q31_t &unitImag)
+{
+    if (magnitude <= 0)
+    {
+        unitReal = 0;
+        unitImag = 0;
+        return;
+    }
+
+    const int leadingZeros = __builtin_clz((uint32_t)magnitude);
+    const int shift = (leadingZeros < 17) ? 17 - leadingZeros : 0; // magnitude >> shift < 2^15
+    const q31_t reciprocal = (1 << 29) / (magnitude >> shift);
+
+    // real / (2 * magnitude) * 2^15 = (real >> shift) * 2^29 / (magnitude >> shift) / 2^15
+    unitReal = (q31_t)(((q63_t)(real >> shift) * reciprocal) >> 15);
+    unitImag = (q31_t)(((q63_t)(imag >> shift) * reciprocal) >> 15);
+}
+
+/*
+* @brief Get complex FFT instance function
+*
+* @param[in] length The complex FFT length, half the real FFT length
+* @return The CMSIS instance, or nullptr for an unsupported length
+*/
+static const arm_cfft_instance_q31* getCfftInstance(int length)
+{
+    switch (length)
+    {
+        case 64:   return &arm_cfft_sR_q31_len64;
+        case 128:  return &arm_cfft_sR_q31_len128;
+        case 256:  return &arm_cfft_sR_q31_len256;
+        case 512:  return &arm_cfft_sR_q31_len512;
+        case 1024: return &arm_cfft_sR_q31_len1024;
+        case 2048: return &arm_cfft_sR_q31_len2048;
+        default:   return nullptr;
+    }
+}
+
+/*
+* @brief Begin function
+*
+* @param[in] maxFrameSize               The largest frame size, at most `MAX_FFT_SIZE`
+* @param[in] voices                     Number of carrier voices, each has its own overlap-add accumulator
+* @param[in] carrierSpectrumBuffer      Buffer of `maxFrameSize` Q31 values for the carrier spectrum and the output frame
+* @param[in] modulatorSpectrumBuffer    Buffer of `maxFrameSize` Q31 values for the modulator spectrum
+* @param[in] carrierMagnitudeBuffer     Buffer of `maxFrameSize` / 2 + 1 Q31 values
+* @param[in] modulatorMagnitudeBuffer   Buffer of `maxFrameSize` / 2 + 1 Q31 values, also used for the gains
+* @param[in] accumulatorBuffer          Buffer of `voices` * `maxFrameSize` Q31 values for the overlap-add
+* @param[in] analysisWindowBuffer       Buffer of `maxFrameSize` Q31 coefficients
+* @param[in] synthesisWindowBuffer      Buffer of `maxFrameSize` Q15 coefficients
+*
+* @details This function stores the buffers and computes the split step twiddle factors once.
+*/
+void FixedPointVocoder::begin(int maxFrameSize, int voices, q31_t *carrierSpectrumBuffer, q31_t *modulatorSpectrumBuffer,
+                              q31_t *carrierMagnitudeBuffer, q31_t *modulatorMagnitudeBuffer, q31_t *accumulatorBuffer,
+                              q31_t *analysisWindowBuffer, q15_t *synthesisWindowBuffer)
+{
+    this->maxFrameSize = maxFrameSize;
+    this->voices = voices;
+    this->carrierSpectrumBuffer = carrierSpectrumBuffer;
+    this->modulatorSpectrumBuffer = modulatorSpectrumBuffer;
+    this->carrierMagnitudeBuffer = carrierMagnitudeBuffer;
+    this->modulatorMagnitudeBuffer = modulatorMagnitudeBuffer;
+    this->accumulatorBuffer = accumulatorBuffer;
+    this->analysisWindowBuffer = analysisWindowBuffer;
+    this->synthesisWindowBuffer = synthesisWindowBuffer;
+
+    if (!splitTwiddleReady)
+    {
+        for (int k = 0; k <= MAX_FFT_SIZE / 4; k++)
+        {
+            const double angle = 2.0 * PI * k / MAX_FFT_SIZE;
+            const double c = cos(angle) * 2147483648.0;
+            splitTwiddle[2 * k] = (c >= 2147483647.0) ? INT32_MAX : (q31_t)llround(c);
+            splitTwiddle[2 * k + 1] = (q31_t)llround(-sin(angle) * 2147483648.0);
+        }
+        splitTwiddleReady = true;
+    }
+    reset();
+}
+
+/*
+* @brief Set frame size function
+*
+* @param[in] frameSize          The FFT size, a power of two from 128 to `maxFrameSize`
+* @param[in] hopSize            Number of output samples per frame
+* @param[in] analysisWindow     The active analysis window of the float engine
+* @param[in] synthesisWindow    The active, normalized synthesis window of the float engine
+*
+* @details The windows are converted to fixed-point, so both engines use the same windows. The accumulator is cleared.
+*/
+void FixedPointVocoder::setFrameSize(int frameSize, int hopSize, const float *analysisWindow, const float *synthesisWindow)
+{
+    this->frameSize = frameSize;
+    this->hopSize = hopSize;
+    cfft = getCfftInstance(frameSize / 2);
+
+    frameBits = 0;
+    while ((1 << frameBits) < frameSize)
+        frameBits++;
+
+    for (int i = 0; i < frameSize; i++)
+    {
+        analysisWindowBuffer[i] = floatToQ31(analysisWindow[i]);
+        synthesisWindowBuffer[i] = floatToQ15(synthesisWindow[i]);
+    }
+    reset();
+}
+
+/*
+* @brief Reset function
+*
+* @details This function clears the overlap-add accumulators of all voices, the output then fades in.
+* The noise of the unvoiced frames restarts.
+*/
+void FixedPointVocoder::reset()
+{
+    if (accumulatorBuffer)
+        memset(accumulatorBuffer, 0, voices * maxFrameSize * sizeof(q31_t));
+    outputExponent = 0;
+    noise.seed();
+}
+
+/*
+* @brief Reset voice function
+*
+* @param[in] voice  The carrier voice
+*
+* @details This function clears the overlap-add accumulator of one voice.
+*/
+void FixedPointVocoder::resetVoice(int voice)
+{
+    if (accumulatorBuffer && voice >= 0 && voice < voices)
+        memset(accumulatorBuffer + voice * maxFrameSize, 0, maxFrameSize * sizeof(q31_t));
+}
+
+/*
+* @brief Analyze carrier function
+*
+* @param[in] frame  The most recent `frameSize` carrier samples
+*/
+void FixedPointVocoder::analyzeCarrier(const int16_t *frame)
+{
+    carrierExponent = analyze(frame, carrierSpectrumBuffer, carrierMagnitudeBuffer);
+}
+
+/*
+* @brief Analyze modulator function
+*
+* @param[in] frame  The most recent `frameSize` modulator samples
+*
+* @details The voicing decision and the modulator gain are computed here, once per frame,
+* and reused by every carrier voice in synthesize().
+*/
+void FixedPointVocoder::analyzeModulator(const int16_t *frame)
+{
+    modulatorExponent = analyze(frame, modulatorSpectrumBuffer, modulatorMagnitudeBuffer);
+    computeGain();
+}
+
+/*
+* @brief Analyze function
+*
+* @param[in] frame      The most recent `frameSize` samples
+* @param[out] spectrum  The packed spectrum, the DFT of the normalized frame divided by `frameSize`
+* @param[out] magnitude The magnitude of the `frameSize` / 2 + 1 bins in 2.30 format
+* @return The magnitude block exponent
+*
+* @details This function applies the analysis window, normalizes the frame and runs the real FFT.
+* The peak is found with an OR of the absolute values, which is enough to count the leading zeros.
+*/
+int FixedPointVocoder::analyze(const int16_t *frame, q31_t *spectrum, q31_t *magnitude)
+{
+    uint32_t peak = 0;
+    for (int i = 0; i < frameSize; i++)
+    {
+        const q31_t sample = (q31_t)(((q63_t)frame[i] * analysisWindowBuffer[i]) >> 16);
+        spectrum[i] = sample;
+        peak |= (uint32_t)(sample ^ (sample >> 31));
+    }
+
+    // 16-bit samples times the window times 2^15 are below 2^30, so the shift is never negative
+    const int shift = peak ? __builtin_clz(peak) - 2 : 0;
+    if (shift > 0)
+    {
+        for (int i = 0; i < frameSize; i++)
+        {
+            spectrum[i] = (q31_t)((uint32_t)spectrum[i] << shift);
+        }
+    }
+
+    arm_cfft_q31(cfft, spectrum, 0, 1);
+    forwardSplit(spectrum);
+
+    // The FFT scales by 1 / frameSize to stay safe for a full-scale sine, real frames leave most of that
+    // headroom unused, normalize again so the quiet bins keep their precision
+    peak = 0;
+    for (int i = 0; i < frameSize; i++)
+    {
+        peak |= (uint32_t)(spectrum[i] ^ (spectrum[i] >> 31));
+    }
+    const int spectrumShift = peak ? __builtin_clz(peak) - 2 : 0;
+    if (spectrumShift > 0)
+    {
+        for (int i = 0; i < frameSize; i++)
+        {
+            spectrum[i] = (q31_t)((uint32_t)spectrum[i] << spectrumShift);
+        }
+    }
+
+    const int nyquist = frameSize / 2;
+    arm_cmplx_mag_q31(spectrum + 2, magnitude + 1, nyquist - 1);
+    magnitude[0] = abs(spectrum[0]) >> 1;
+    magnitude[nyquist] = abs(spectrum[1]) >> 1;
+
+    // |X| = magnitude * 2 * frameSize / 2^(15 + shift + spectrumShift)
+    return frameBits - 14 - shift - spectrumShift;
+}
+
+/*
+* @brief Forward split function
+*
+* @param[in,out] buffer The complex FFT of the even and odd samples, replaced by the packed real spectrum
+*
+* @details X(k) = (E(k) + W^k O(k)) / 2 and X(N/2 - k) = conj(E(k) - W^k O(k)) / 2, so bins k and N/2 - k
+* are computed together and the split works in place. The inputs are divided by 4 first, which
+* covers the 1 / 2 of E and O and the 1 / 2 of the scaling.
+*/
+void FixedPointVocoder::forwardSplit(q31_t *buffer) const
+{
+    const int half = frameSize / 2;
+    const int stride = MAX_FFT_SIZE / frameSize;
+
+    const q31_t zr = buffer[0];
+    const q31_t zi = buffer[1];
+    buffer[0] = (zr >> 1) + (zi >> 1); // DC
+    buffer[1] = (zr >> 1) - (zi >> 1); // Nyquist
+
+    for (int k = 1; k <= half / 2; k++)
+    {
+        q31_t *a = &buffer[2 * k];          // Z(k)
+        q31_t *b = &buffer[2 * (half - k)]; // Z(N/2 - k)
+        const q31_t ar = a[0] >> 2, ai = a[1] >> 2;
+        const q31_t br = b[0] >> 2, bi = -(b[1] >> 2); // conj(Z(N/2 - k))
+        const q31_t wr = splitTwiddle[2 * k * stride], wi = splitTwiddle[2 * k * stride + 1];
+
+        const q31_t er = ar + br, ei = ai + bi;  // E(k) / 2
+        const q31_t or_ = ai - bi, oi = br - ar; // O(k) / 2
+        const q31_t tr = multiplyQ31(wr, or_) - multiplyQ31(wi, oi);
+        const q31_t ti = multiplyQ31(wr, oi) + multiplyQ31(wi, or_);
+
+        b[0] = er - tr;
+        b[1] = ti - ei;
+        a[0] = er + tr;
+        a[1] = ei + ti;
+    }
+}
+
+/*
+* @brief Inverse split function
+*
+* @param[in,out] buffer The packed real spectrum, replaced by the input of the inverse complex FFT
+*
+* @details Z(k) = E(k) + j O(k) with E(k) = (X(k) + conj(X(N/2 - k))) / 2 and O(k) = W^-k (X(k) - conj(X(N/2 - k))) / 2,
+* and Z(N/2 - k) = conj(E(k)) + j conj(O(k)). The spectrum must be below 2^29, Z can grow by 2 bits.
+*/
+void FixedPointVocoder::inverseSplit(q31_t *buffer) const
+{
+    const int half = frameSize / 2;
+    const int stride = MAX_FFT_SIZE / frameSize;
+
+    const q31_t dc = buffer[0];
+    const q31_t nyquist = buffer[1];
+    buffer[0] = (dc >> 1) + (nyquist >> 1);
+    buffer[1] = (dc >> 1) - (nyquist >> 1);
+
+    for (int k = 1; k <= half / 2; k++)
+    {
+        q31_t *a = &buffer[2 * k];          // X(k)
+        q31_t *b = &buffer[2 * (half - k)]; // X(N/2 - k)
+        const q31_t ar = a[0] >> 1, ai = a[1] >> 1;
+        const q31_t br = b[0] >> 1, bi = -(b[1] >> 1); // conj(X(N/2 - k)) / 2
+        const q31_t wr = splitTwiddle[2 * k * stride], wi = splitTwiddle[2 * k * stride + 1]; // W^k, conjugated below
+
+        const q31_t er = ar + br, ei = ai + bi;
+        const q31_t dr = ar - br, di = ai - bi;
+        const q31_t or_ = multiplyQ31(dr, wr) + multiplyQ31(di, wi);
+        const q31_t oi = multiplyQ31(di, wr) - multiplyQ31(dr, wi);
+
+        b[0] = er + oi;
+        b[1] = or_ - ei;
+        a[0] = er - oi;
+        a[1] = ei + or_;
+    }
+}
+
+/*
+* @brief Compute gain function
+*
+* @details This function makes the voicing decision and, for voiced frames, replaces the modulator magnitude
+* by the modulator gain per bin. The gains are Q31 with one block exponent per frame (see gainFractionalBits()).
+*/
+void FixedPointVocoder::computeGain()
+{
+    const int nyquist = frameSize / 2;
+    q31_t *gain = modulatorMagnitudeBuffer;
+
+    unvoiced = voicingDetector.classify(modulatorMagnitudeBuffer, modulatorExponent);
+    if (unvoiced)
+        return; // The magnitude is the shape of the noise, see vocode()
+
+    if (modulatorEnvelope.method() == EnvelopeMethod::None)
+    {
+        // Per bin curve, the magnitude is only converted to float for the lookup
+        q31_t peak = 0;
+        for (int i = 0; i <= nyquist; i++)
+        {
+            peak = (gain[i] > peak) ? gain[i] : peak;
+        }
+        gainBits = gainFractionalBits(gainScale * gainCurve(ldexpf((float)peak, modulatorExponent)));
+        for (int i = 0; i <= nyquist; i++)
+        {
+            gain[i] = (q31_t)lrintf(ldexpf(gainScale * gainCurve(ldexpf((float)gain[i], modulatorExponent)), gainBits));
+        }
+    }
+    else
+    {
+        modulatorEnvelope.process(modulatorMagnitudeBuffer, modulatorExponent);
+        gainBits = modulatorEnvelope.expandGain(gainCurve, gainScale, gain, nyquist + 1);
+    }
+}
+
+/*
+* @brief Vocode function
+*
+* @return The block exponent of the vocoded carrier spectrum
+*
+* @details Same model as vocodeCarrier(): unvoiced frames are replaced by noise with the spectrum of the modulator,
+* voiced frames get gain * carrier + offset along the carrier phase, with the gain from computeGain().
+* The output exponent comes from an upper bound of the result, so the spectrum is scaled in one pass without overflow checks.
+*/
+int FixedPointVocoder::vocode()
+{
+    const int nyquist = frameSize / 2;
+    q31_t *spectrum = carrierSpectrumBuffer;
+    const q31_t *gain = modulatorMagnitudeBuffer;
+    int exponent = 0;
+
+    if (unvoiced)
+    {
+        // Noise amplitude = strength * modulator magnitude, the per bin scale is done in float like the gain lookup
+        const float level = unvoicedNoiseStrength * NOISE_RMS_SCALE;
+        q31_t peak = 0;
+        for (int i = 0; i <= nyquist; i++)
+        {
+            peak = (gain[i] > peak) ? gain[i] : peak;
+        }
+        frexpf(ldexpf(level * peak, modulatorExponent), &exponent);
+        const int spectrumExponent = exponent - 29;
+        const float scale = ldexpf(level, modulatorExponent - spectrumExponent);
+
+        spectrum[0] = multiplyQ31((q31_t)(gain[0] * scale), (q31_t)noise.next());
+        spectrum[1] = multiplyQ31((q31_t)(gain[nyquist] * scale), (q31_t)noise.next());
+        for (int i = 1; i < nyquist; i++)
+        {
+            const q31_t amplitude = (q31_t)(gain[i] * scale);
+            spectrum[2 * i] = multiplyQ31(amplitude, (q31_t)noise.next());
+            spectrum[2 * i + 1] = multiplyQ31(amplitude, (q31_t)noise.next());
+        }
+        return spectrumExponent;
+    }
+
+    q31_t peakMagnitude = 0;
+    for (int i = 0; i <= nyquist; i++)
+    {
+        peakMagnitude = (carrierMagnitudeBuffer[i] > peakMagnitude) ? carrierMagnitudeBuffer[i] : peakMagnitude;
+    }
+
+    // |output| <= gain * |carrier| + |offset|, with gain < 2^(30 - gainBits)
+    const float offset = noiseVoiced * voicedNoiseStrength * 30768.0f;
+    const float bound = ldexpf((float)peakMagnitude, carrierExponent + 30 - gainBits) + fabsf(offset);
+    frexpf(bound, &exponent);
+    const int spectrumExponent = exponent - 29;
+
+    // The carrier spectrum is 2 * magnitude, so its exponent is one less than the magnitude exponent
+    const int gainShift = gainBits + spectrumExponent - (carrierExponent - 1);
+    const q31_t offsetValue = (q31_t)lrintf(ldexpf(offset, -spectrumExponent));
+    q31_t unitReal;
+    q31_t unitImag;
+
+    // DC and Nyquist are real
+    unitVector(spectrum[0], 0, carrierMagnitudeBuffer[0], unitReal, unitImag);
+    spectrum[0] = (q31_t)(shiftQ63((q63_t)gain[0] * spectrum[0], gainShift) + (((q63_t)offsetValue * unitReal) >> 15));
+    unitVector(spectrum[1], 0, carrierMagnitudeBuffer[nyquist], unitReal, unitImag);
+    spectrum[1] = (q31_t)(shiftQ63((q63_t)gain[nyquist] * spectrum[1], gainShift) + (((q63_t)offsetValue * unitReal) >> 15));
+
+    for (int i = 1; i < nyquist; i++)
+    {
+        q31_t *bin = &spectrum[2 * i];
+        unitVector(bin[0], bin[1], carrierMagnitudeBuffer[i], unitReal, unitImag);
+        bin[0] = (q31_t)(shiftQ63((q63_t)gain[i] * bin[0], gainShift) + (((q63_t)offsetValue * unitReal) >> 15));
+        bin[1] = (q31_t)(shiftQ63((q63_t)gain[i] * bin[1], gainShift) + (((q63_t)offsetValue * unitImag) >> 15));
+    }
+    return spectrumExponent;
+}
+
+/*
+* @brief Synthesize function
+*
+* @details This function vocodes the carrier spectrum and runs the inverse real FFT in place.
+* The output frame is left in the carrier spectrum buffer for readHop().
+*/
+void FixedPointVocoder::synthesize()
+{
+    outputExponent = vocode();
+    inverseSplit(carrierSpectrumBuffer);
+    arm_cfft_q31(cfft, carrierSpectrumBuffer, 1, 1);
+}
+
+/*
+* @brief Read hop function
+*
+* @param[out] hop       The `hopSize` finished output samples
+* @param[in] fadeOut    True to fade the hop out linearly, before a frame size change
+* @param[in] voice      The carrier voice, selects the overlap-add accumulator
+*
+* @details This function windows the output frame, adds it to the accumulator and returns the finished samples,
+* which combines OverlapAddSynthesizer::addFrame(), readHop() and convertFloatToInt16().
+* Like the float engine the output is divided by 4 and rounded toward zero, but it saturates instead of wrapping.
+*/
+void FixedPointVocoder::readHop(int16_t *hop, bool fadeOut, int voice)
+{
+    const q31_t *frame = carrierSpectrumBuffer;
+    q31_t *accumulatorBuffer = this->accumulatorBuffer + voice * maxFrameSize;
+
+    // frame * 2^outputExponent * window (Q15) into the accumulator (ACCUMULATOR_BITS)
+    const int shift = 15 - ACCUMULATOR_BITS - outputExponent;
+    for (int i = 0; i < frameSize; i++)
+    {
+        accumulatorBuffer[i] = saturateQ31(accumulatorBuffer[i] + shiftQ63((q63_t)frame[i] * synthesisWindowBuffer[i], shift));
+    }
+
+    for (int i = 0; i < hopSize; i++)
+    {
+        q63_t sample = accumulatorBuffer[i];
+        if (fadeOut)
+            sample = sample * (hopSize - 1 - i) / hopSize;
+        sample /= (1 << (ACCUMULATOR_BITS + OUTPUT_SCALE_BITS));
+        hop[i] = (int16_t)((sample > 32767) ? 32767 : (sample < -32768) ? -32768 : sample);
+    }
+
+    memmove(accumulatorBuffer, accumulatorBuffer + hopSize, (frameSize - hopSize) * sizeof(q31_t));
+    memset(accumulatorBuffer + frameSize - hopSize, 0, hopSize * sizeof(q31_t));
+}
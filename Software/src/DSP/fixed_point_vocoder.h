@@ -0,0 +1,86 @@
+/**
+ * @file fixed_point_vocoder.h
+ * @brief Header file for the fixed-point FFT vocoder engine
+ *
+ * @details This file contains the declaration of the fixed-point version of the FFT vocoder.
+ * It runs the same chain as the float engine (analysis window, real FFT, modulator envelope, gain,
+ * inverse real FFT and overlap-add) with Q31 spectra, a Q31 output accumulator and a Q15 synthesis window,
+ * using the CMSIS arm_cfft_q31(). Block floating point keeps the precision: every frame and spectrum
+ * is normalized to the full Q31 range before it is transformed, and a block exponent per buffer
+ * tracks the scale. Only the O(bands) envelope smoothing uses float.
+ *
+ * The spectra stay 32-bit: with Q15 the FFT round trip loses about 2 * log2(fftSize) bits to the
+ * internal downscaling, which leaves too little for a 16-bit output. The analysis window is Q31 as well,
+ * the rounding noise of a Q15 window is only 96 dB down and the cepstral envelope follows bands that quiet.
+ *
+ * @note The class does not allocate memory, all buffers are provided by the caller in begin().
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+#ifndef FIXED_POINT_VOCODER_H
+#define FIXED_POINT_VOCODER_H
+
+// Headers
+#include <cstdint>
+#include "HAL/hal.h"
+#include "spectral_kernel.h"
+
+/*
+* @class FixedPointVocoder
+* @brief FFT vocoder in Q15/Q31 arithmetic
+*
+* @details Per hop: analyzeModulator() windows and transforms the most recent modulator frame and computes the gains,
+* then per carrier voice analyzeCarrier() transforms the carrier frame, synthesize() vocodes the carrier and
+* transforms it back and readHop() overlap-adds the frame into the accumulator of that voice and returns the
+* finished output samples. Magnitudes are kept in the CMSIS 2.30 format,
+* so a magnitude times 2^exponent is the magnitude of the float engine.
+*/
+class FixedPointVocoder
+{
+    public:
+        void begin(int maxFrameSize, int voices, q31_t *carrierSpectrumBuffer, q31_t *modulatorSpectrumBuffer,
+                   q31_t *carrierMagnitudeBuffer, q31_t *modulatorMagnitudeBuffer, q31_t *accumulatorBuffer,
+                   q31_t *analysisWindowBuffer, q15_t *synthesisWindowBuffer);
+        void setFrameSize(int frameSize, int hopSize, const float *analysisWindow, const float *synthesisWindow);
+        void reset();
+        void resetVoice(int voice);
+
+        void analyzeCarrier(const int16_t *frame);
+        void analyzeModulator(const int16_t *frame);
+        void synthesize();
+        void readHop(int16_t *hop, bool fadeOut, int voice = 0);
+
+    private:
+        int analyze(const int16_t *frame, q31_t *spectrum, q31_t *magnitude);
+        void computeGain();
+        int vocode();
+        void forwardSplit(q31_t *buffer) const;
+        void inverseSplit(q31_t *buffer) const;
+
+        int maxFrameSize = 0;
+        int voices = 1;
+        int frameSize = 0;
+        int hopSize = 0;
+        int frameBits = 0; // log2(frameSize)
+        const arm_cfft_instance_q31 *cfft = nullptr; // Half length complex FFT
+
+        int carrierExponent = 0;
+        int modulatorExponent = 0;
+        int outputExponent = 0;
+        int gainBits = 0;       // Fractional bits of the modulator gain
+        bool unvoiced = false;  // Voicing decision of the modulator frame
+        NoiseGenerator noise;   // Noise excitation of unvoiced frames
+
+        q31_t *carrierSpectrumBuffer = nullptr;     // maxFrameSize, packed spectrum, then the output frame
+        q31_t *modulatorSpectrumBuffer = nullptr;   // maxFrameSize, packed spectrum
+        q31_t *carrierMagnitudeBuffer = nullptr;    // maxFrameSize / 2 + 1
+        q31_t *modulatorMagnitudeBuffer = nullptr;  // maxFrameSize / 2 + 1, then the gain per bin
+        q31_t *accumulatorBuffer = nullptr;         // voices * maxFrameSize, output samples * 2^ACCUMULATOR_BITS
+        q31_t *analysisWindowBuffer = nullptr;      // frameSize coefficients
+        q15_t *synthesisWindowBuffer = nullptr;     // frameSize coefficients
+};
+
+#endif // FIXED_POINT_VOCODER_H
@@ -0,0 +1,113 @@
+/**
+ * @file frame_size_manager.cpp
+ * @brief Runtime FFT size manager
+ *
+ * @details This file contains the implementation of the frame size manager.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+// Headers
+#include "frame_size_manager.h"
+#include "fft_utils.h"
+
+/*
+* @brief Begin function
+*
+* @param[in] initialSize    The FFT size to start with
+* @return True when the FFT instances for all supported sizes are available
+*
+* @details This function plans the real FFT instances of every supported size.
+*/
+bool FrameSizeManager::begin(int initialSize)
+{
+    for (int size = MIN_FFT_SIZE; size <= MAX_FFT_SIZE; size *= 2)
+    {
+        if (!getFFTConfig(size))
+            return false;
+    }
+
+    if (!isSupported(initialSize))
+        return false;
+
+    currentSize = initialSize;
+    pendingSize.store(0);
+    return true;
+}
+
+/*
+* @brief Request size function
+*
+* @param[in] size   The new FFT size
+* @return False when the size is not supported
+*
+* @details Safe to call from any context, the change is applied between two frames.
+*/
+bool FrameSizeManager::requestSize(int size)
+{
+    if (!isSupported(size))
+        return false;
+
+    pendingSize.store(size == currentSize ? 0 : size);
+    return true;
+}
+
+/*
+* @brief Has pending change function
+*
+* @return True when a different size has been requested
+*/
+bool FrameSizeManager::hasPendingChange() const
+{
+    return pendingSize.load() != 0;
+}
+
+/*
+* @brief Apply pending change function
+*
+* @return The new FFT size
+*
+* @details Only call from the DSP, between two frames.
+*/
+int FrameSizeManager::applyPendingChange()
+{
+    int size = pendingSize.exchange(0);
+    if (size != 0)
+        currentSize = size;
+    return currentSize;
+}
+
+/*
+* @brief Requested size function
+*
+* @return The pending size, or the current size when nothing is pending
+*/
+int FrameSizeManager::requestedSize() const
+{
+    int size = pendingSize.load();
+    return size ? size : currentSize;
+}
+
+/*
+* @brief Is supported function
+*
+* @param[in] size   The FFT size
+* @return True for powers of two from `MIN_FFT_SIZE` to `MAX_FFT_SIZE`
+*/
+bool FrameSizeManager::isSupported(int size)
+{
+    return size >= MIN_FFT_SIZE && size <= MAX_FFT_SIZE && (size & (size - 1)) == 0;
+}
+
+/*
+* @brief Next size function
+*
+* @param[in] size   The current FFT size
+* @return The next larger supported size, wrapping around to the smallest
+*/
+int FrameSizeManager::nextSize(int size)
+{
+    return (size >= MAX_FFT_SIZE) ? MIN_FFT_SIZE : size * 2;
+}
@@ -0,0 +1,55 @@
+/**
+ * @file frame_size_manager.h
+ * @brief Header file for the runtime FFT size manager
+ *
+ * @details This file contains the declaration of the frame size manager, which lets the FFT size be
+ * changed while the vocoder is running. All DSP buffers are sized for `MAX_FFT_SIZE` and the FFT
+ * instances for every supported size are planned at boot, so a change needs no allocation.
+ * A change is requested from any context (UI, Serial) and applied by the DSP between two frames.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+#ifndef FRAME_SIZE_MANAGER_H
+#define FRAME_SIZE_MANAGER_H
+
+// Headers
+#include <atomic>
+
+// Defines
+static const int MIN_FFT_SIZE = 128;
+static const int MAX_FFT_SIZE = 4096;
+static const int DEFAULT_FFT_SIZE = 1024; // Startup FFT size
+static const int OVERLAP_FACTOR = 4; // Hop size is FFT size / 4 (75% overlap)
+static const int MAX_HOP_SIZE = MAX_FFT_SIZE / OVERLAP_FACTOR;
+
+/*
+* @class FrameSizeManager
+* @brief Runtime FFT size selection
+*
+* @details The requested size is stored atomically, the DSP polls hasPendingChange() after each frame
+* and calls applyPendingChange() once the current frame has been faded out.
+*/
+class FrameSizeManager
+{
+    public:
+        bool begin(int initialSize);
+        bool requestSize(int size);
+        bool hasPendingChange() const;
+        int applyPendingChange();
+
+        int size() const { return currentSize; }
+        int hopSize() const { return currentSize / OVERLAP_FACTOR; }
+        int requestedSize() const;
+
+        static bool isSupported(int size);
+        static int nextSize(int size);
+
+    private:
+        int currentSize = 0;
+        std::atomic<int> pendingSize{0};
+};
+
+#endif // FRAME_SIZE_MANAGER_H
@@ -0,0 +1,173 @@
+/**
+ * @file noise_gate.cpp
+ * @brief Adaptive noise gate of the modulator
+ *
+ * @details This file contains the implementation of the level detection, the gate state and the gain ramps.
+ * The levels are measured once per hop, the only per-sample work is the sum of squares, the peak and,
+ * during a ramp, the output gain.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+// Headers
+#include "noise_gate.h"
+#include <climits>
+#include <cmath>
+
+// Defines
+static const float FULL_SCALE = 32768.0f;
+static const float MIN_LEVEL = -120.0f; // dBFS, the level of digital silence
+
+/*
+* @brief Level function
+*
+* @param[in] amplitude  The amplitude, int16 full scale
+* @return The level in dBFS, at least `MIN_LEVEL`
+*/
+static inline float levelDb(float amplitude)
+{
+    return (amplitude > 0.0f) ? fmaxf(20.0f * log10f(amplitude / FULL_SCALE), MIN_LEVEL) : MIN_LEVEL;
+}
+
+/*
+* @brief Begin function
+*
+* @param[in] sampleRate The sample rate in Hz
+*
+* @details The counters restart, see reset() for the gate.
+*/
+void NoiseGate::begin(float sampleRate)
+{
+    this->sampleRate = sampleRate;
+    reset();
+    frameCount = 0;
+    skippedCount = 0;
+}
+
+/*
+* @brief Reset function
+*
+* @details The gate starts open with an unknown noise floor and a full hold, so the start of the output is never faded.
+* A silent modulator closes it after the hold. The counters are kept.
+*/
+void NoiseGate::reset()
+{
+    floorValid = false;
+    rmsLevel = MIN_LEVEL;
+    gateOpen = true;
+    holdRemaining = (holdHops > 0) ? holdHops : INT_MAX; // Shortened to the hold by setFrameSize()
+    startGain = 1.0f;
+    endGain = 1.0f;
+    resume = false;
+}
+
+/*
+* @brief Set frame size function
+*
+* @param[in] fftSize    The FFT size
+* @param[in] hopSize    The hop size
+*
+* @details Converts the times to hops, the gate state and the gain are kept. The output lags the key by one frame,
+* the attack is shortened to fit in it at the small sizes, so the gain is up before the onset is output.
+*/
+void NoiseGate::setFrameSize(int fftSize, int hopSize)
+{
+    this->hopSize = hopSize;
+
+    const float hopTime = hopSize / sampleRate;
+    holdHops = (int)ceilf(GATE_HOLD_TIME / hopTime) + fftSize / hopSize + 1;
+    attackStep = fminf(fmaxf(hopTime / GATE_ATTACK_TIME, (float)hopSize / fftSize), 1.0f); // Done before the onset is output
+    releaseStep = fminf(hopTime / GATE_RELEASE_TIME, 1.0f);
+    floorRise = GATE_FLOOR_RISE * hopTime;
+    holdRemaining = (holdRemaining < holdHops) ? holdRemaining : holdHops;
+}
+
+/*
+* @brief Threshold function
+*
+* @return The level in dBFS that opens the gate, the set threshold or the noise floor plus its margin
+*/
+float NoiseGate::threshold() const
+{
+    if (thresholdLevel <= GATE_OFF_LEVEL || !floorValid)
+        return thresholdLevel;
+    return fmaxf(thresholdLevel, fminf(floorLevel, GATE_FLOOR_LIMIT) + GATE_FLOOR_MARGIN);
+}
+
+/*
+* @brief Update function
+*
+* @param[in] hop    The `hopSize` new modulator samples, after the high-pass
+*
+* @details Measures the hop, updates the noise floor and the gate state and moves the gain one hop along its ramp.
+* Only a hop below the threshold updates the floor, so a steady modulator is never taken for the room,
+* and the first hops do not seed the floor with signal.
+*/
+void NoiseGate::update(const float *hop)
+{
+    float squares = 0.0f;
+    float peak = 0.0f;
+    for (int i = 0; i < hopSize; i++)
+    {
+        squares += hop[i] * hop[i];
+        peak = fmaxf(peak, fabsf(hop[i]));
+    }
+    rmsLevel = levelDb(sqrtf(squares / hopSize));
+    const float peakLevel = levelDb(peak);
+
+    const float openLevel = threshold();
+    if (rmsLevel < openLevel)
+    {
+        floorLevel = (!floorValid || rmsLevel < floorLevel) ? rmsLevel : fminf(floorLevel + floorRise, GATE_FLOOR_LIMIT);
+        floorValid = true;
+    }
+    if (thresholdLevel <= GATE_OFF_LEVEL || rmsLevel >= openLevel || peakLevel >= openLevel + GATE_PEAK_CREST)
+    {
+        gateOpen = true;
+        holdRemaining = holdHops;
+    }
+    else if (gateOpen && rmsLevel >= openLevel - GATE_HYSTERESIS)
+    {
+        holdRemaining = holdHops;
+    }
+    else if (holdRemaining > 0)
+    {
+        holdRemaining--;
+    }
+    else
+    {
+        gateOpen = false;
+    }
+
+    const bool skipped = skip();
+    startGain = (thresholdLevel <= GATE_OFF_LEVEL) ? 1.0f : endGain; // Off is a bypass
+    endGain = gateOpen ? fminf(startGain + attackStep, 1.0f) : fmaxf(startGain - releaseStep, 0.0f);
+    resume = skipped && !skip();
+
+    frameCount++;
+    skippedCount += skip() ? 1 : 0;
+}
+
+/*
+* @brief Apply function
+*
+* @param[in,out] left   The `hopSize` left output samples
+* @param[in,out] right  The `hopSize` right output samples
+*
+* @details Ramps the gain linearly over the hop, nothing is done while the gate is fully open.
+*/
+void NoiseGate::apply(int16_t *left, int16_t *right) const
+{
+    if (startGain == 1.0f && endGain == 1.0f)
+        return;
+
+    const float step = (endGain - startGain) / hopSize;
+    for (int i = 0; i < hopSize; i++)
+    {
+        const float gain = startGain + step * (i + 1);
+        left[i] = (int16_t)lrintf(left[i] * gain);
+        right[i] = (int16_t)lrintf(right[i] * gain);
+    }
+}
@@ -0,0 +1,94 @@
+/**
+ * @file noise_gate.h
+ * @brief Header file for the adaptive noise gate of the modulator
+ *
+ * @details This file contains the declaration of the gate that closes the FFT engines while the modulator is silent,
+ * in the gaps of speech. A closed gate fades the output out, and once it is faded out the frames are skipped:
+ * no FFT, no vocoding and no inverse FFT, only the analysis windows are kept up to date.
+ *
+ * The key is the high-passed modulator hop:
+ * - The gate opens when the RMS level of a hop reaches the threshold, or its peak level the threshold plus
+ *   `GATE_PEAK_CREST`, so a short onset opens it at once.
+ * - It stays open while the RMS level is above the threshold minus `GATE_HYSTERESIS`, and for `GATE_HOLD_TIME`
+ *   plus one frame after that. The output lags the input by one frame, the hold covers it, so the end of a word is
+ *   never cut.
+ * - The threshold adapts to the room: it is at least `GATE_FLOOR_MARGIN` above the noise floor, the lowest recent
+ *   RMS level of the hops below the threshold. The floor follows a lower level at once, rises by `GATE_FLOOR_RISE`
+ *   only and stops at `GATE_FLOOR_LIMIT`. A hop that reaches the threshold is signal and is never taken for the floor.
+ *
+ * The output gain ramps up over `GATE_ATTACK_TIME` and down over `GATE_RELEASE_TIME`, per sample, so the gate
+ * never clicks. When the gate opens again the overlap-add restarts from an empty accumulator, like after a
+ * change of the FFT size.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+#ifndef NOISE_GATE_H
+#define NOISE_GATE_H
+
+// Headers
+#include <cstdint>
+
+// Defines
+static const float GATE_OFF_LEVEL = -96.0f;     // dBFS, a threshold at or below this disables the gate
+static const float GATE_PEAK_CREST = 12.0f;     // dB, the peak level that opens the gate is this much above the threshold
+static const float GATE_HYSTERESIS = 6.0f;      // dB
+static const float GATE_FLOOR_MARGIN = 12.0f;   // dB above the noise floor
+static const float GATE_FLOOR_RISE = 2.0f;      // dB/s
+static const float GATE_FLOOR_LIMIT = -50.0f;   // dBFS, a louder floor is not a gap
+static const float GATE_ATTACK_TIME = 0.005f;   // s
+static const float GATE_HOLD_TIME = 0.1f;       // s
+static const float GATE_RELEASE_TIME = 0.05f;   // s
+
+/*
+* @class NoiseGate
+* @brief Adaptive RMS/peak gate with attack, hold and release, decides per hop whether a frame can be skipped
+*
+* @details Per hop: update() with the new high-passed modulator samples, then skip(). A frame that is not skipped
+* runs the engine and applies the gain ramp to the output with apply(). The counters are only written by update().
+*/
+class NoiseGate
+{
+    public:
+        void begin(float sampleRate);
+        void setFrameSize(int fftSize, int hopSize);
+        void setThreshold(float level) { thresholdLevel = level; }
+        void reset();
+
+        void update(const float *hop);
+        bool skip() const { return startGain == 0.0f && endGain == 0.0f; }
+        bool resuming() const { return resume; }
+        void apply(int16_t *left, int16_t *right) const;
+
+        bool open() const { return gateOpen; }
+        float level() const { return rmsLevel; }
+        float threshold() const;
+        uint32_t frames() const { return frameCount; }
+        uint32_t skippedFrames() const { return skippedCount; }
+
+    private:
+        float sampleRate = 44100.0f;
+        int hopSize = 0;
+        int holdHops = 0;           // The hold in hops, including one frame of latency
+        float attackStep = 1.0f;    // Gain change per hop
+        float releaseStep = 1.0f;
+        float floorRise = 0.0f;     // dB per hop
+
+        float thresholdLevel = GATE_OFF_LEVEL;
+        float floorLevel = 0.0f;    // dBFS
+        bool floorValid = false;
+        float rmsLevel = GATE_OFF_LEVEL;
+
+        bool gateOpen = true;
+        int holdRemaining = 0;
+        float startGain = 1.0f;     // At the start and the end of the hop
+        float endGain = 1.0f;
+        bool resume = false;        // The previous frame was skipped
+
+        uint32_t frameCount = 0;
+        uint32_t skippedCount = 0;
+};
+
+#endif // NOISE_GATE_H
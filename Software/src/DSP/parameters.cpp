@@ -0,0 +1,211 @@
+/**
+ * @file parameters.cpp
+ * @brief Vocoder parameter registry
+ *
+ * @details This file contains the parameter table and the implementation of the registry.
+ * The defaults are the values the vocoder was tuned with. The voicing threshold is a decision, not a level,
+ * so it is not smoothed. The MIDI controls are the sound controllers 70 to 77.
+ * The noise gate threshold is a decision too, at its minimum the gate is off.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+// Headers
+#include "parameters.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+// Variables
+static const ParamInfo PARAM_INFO[] =
+{
+    // name             label               unit    min     max     default step    smoothing   MIDI
+    {"highpass",        "High-pass",        "Hz",   20.0f,  500.0f, 100.0f, 10.0f,  0.05f,      70},
+    {"exponent",        "Gain exponent",    "",     0.1f,   1.0f,   0.4f,   0.05f,  0.05f,      71},
+    {"unvoiced_noise",  "Unvoiced noise",   "",     0.0f,   2.0f,   0.9f,   0.05f,  0.02f,      72},
+    {"voiced_noise",    "Voiced noise",     "",     0.0f,   2.0f,   0.4f,   0.05f,  0.02f,      73},
+    {"unvoiced_ratio",  "Unvoiced ratio",   "",     1.0f,   16.0f,  4.0f,   0.25f,  0.0f,       74},
+    {"pitch",           "Pitch shift",      "st",   -12.0f, 12.0f,  0.0f,   1.0f,   0.05f,      75},
+    {"formant",         "Formant shift",    "st",   -12.0f, 12.0f,  0.0f,   0.5f,   0.05f,      76},
+    {"gate",            "Noise gate",       "dB",   -96.0f, -20.0f, -60.0f, 1.0f,   0.0f,       77},
+};
+static_assert(sizeof(PARAM_INFO) / sizeof(PARAM_INFO[0]) == (size_t)ParamId::Count, "One entry per parameter");
+
+static const float SNAP_FRACTION = 0.01f; // A value within this fraction of a step of its target is set to the target
+
+/*
+* @brief Constructor
+*
+* @details Sets every target and value to its default.
+*/
+ParameterRegistry::ParameterRegistry()
+{
+    for (int i = 0; i < COUNT; i++)
+    {
+        targets[0][i] = PARAM_INFO[i].defaultValue;
+        targets[1][i] = PARAM_INFO[i].defaultValue;
+        current[i] = PARAM_INFO[i].defaultValue;
+    }
+}
+
+/*
+* @brief Settle function
+*
+* @details DSP side, sets every value to its target without smoothing.
+*/
+void ParameterRegistry::settle()
+{
+    memcpy(current, targets[front.load(std::memory_order_acquire)], sizeof(current));
+}
+
+/*
+* @brief Set function
+*
+* @param[in] id     The parameter
+* @param[in] value  The new target, clamped to the range of the parameter
+* @return False when the value is not a number
+*
+* @details Writer side, at thread level.
+*/
+bool ParameterRegistry::set(ParamId id, float value)
+{
+    if (std::isnan(value))
+        return false;
+
+    const ParamInfo &param = info(id);
+    const int published = front.load(std::memory_order_relaxed);
+    const int back = 1 - published;
+
+    memcpy(targets[back], targets[published], sizeof(targets[back]));
+    targets[back][(int)id] = (value < param.minValue) ? param.minValue : (value > param.maxValue) ? param.maxValue : value;
+    front.store(back, std::memory_order_release);
+    writes.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+/*
+* @brief Set normalized function
+*
+* @param[in] id         The parameter
+* @param[in] fraction   0 for the minimum to 1 for the maximum, as sent by a MIDI controller
+* @return False when the fraction is not a number
+*/
+bool ParameterRegistry::setNormalized(ParamId id, float fraction)
+{
+    const ParamInfo &param = info(id);
+    return set(id, param.minValue + fraction * (param.maxValue - param.minValue));
+}
+
+/*
+* @brief Step function
+*
+* @param[in] id     The parameter
+* @param[in] steps  Number of steps up, negative for down
+* @return True
+*
+* @details The target is rounded to a whole number of steps, so stepping always returns to the same values.
+*/
+bool ParameterRegistry::step(ParamId id, int steps)
+{
+    const ParamInfo &param = info(id);
+    return set(id, param.step * (roundf(target(id) / param.step) + steps));
+}
+
+/*
+* @brief Update function
+*
+* @param[in] frameTime  The time between two frames in s
+* @return The mask of the parameters whose value changed, see paramBit()
+*
+* @details DSP side, called once at the start of a frame. Copies the published targets
+* and moves every value one frame closer to its target.
+*/
+uint32_t ParameterRegistry::update(float frameTime)
+{
+    float latest[COUNT];
+    memcpy(latest, targets[front.load(std::memory_order_acquire)], sizeof(latest));
+
+    uint32_t changed = 0;
+    for (int i = 0; i < COUNT; i++)
+    {
+        if (current[i] == latest[i])
+            continue;
+
+        const ParamInfo &param = PARAM_INFO[i];
+        const float coefficient = (param.smoothingTime > 0.0f) ? 1.0f - expf(-frameTime / param.smoothingTime) : 1.0f;
+        current[i] += coefficient * (latest[i] - current[i]);
+        if (fabsf(latest[i] - current[i]) < SNAP_FRACTION * param.step)
+            current[i] = latest[i];
+        changed |= 1u << i;
+    }
+    return changed;
+}
+
+/*
+* @brief Info function
+*
+* @param[in] id The parameter
+* @return The fixed properties of the parameter
+*/
+const ParamInfo& ParameterRegistry::info(ParamId id)
+{
+    return PARAM_INFO[(int)id];
+}
+
+/*
+* @brief Find function
+*
+* @param[in] name   The name of the parameter
+* @param[out] id    The parameter
+* @return False when there is no parameter with this name
+*/
+bool ParameterRegistry::find(const char *name, ParamId &id)
+{
+    for (int i = 0; i < COUNT; i++)
+    {
+        if (strcmp(name, PARAM_INFO[i].name) == 0)
+        {
+            id = (ParamId)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+* @brief Find control function
+*
+* @param[in] control    The MIDI control change number
+* @param[out] id        The parameter
+* @return False when no parameter is mapped to this control
+*/
+bool ParameterRegistry::findControl(uint8_t control, ParamId &id)
+{
+    for (int i = 0; i < COUNT; i++)
+    {
+        if (PARAM_INFO[i].midiControl == control)
+        {
+            id = (ParamId)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+* @brief Format function
+*
+* @param[in] id     The parameter
+* @param[in] value  The value to format
+* @param[out] buffer The value with its unit
+* @param[in] size   Size of the buffer
+* @return The number of characters written
+*/
+int ParameterRegistry::format(ParamId id, float value, char *buffer, size_t size)
+{
+    const ParamInfo &param = info(id);
+    const int decimals = (param.step >= 1.0f) ? 0 : 2;
+    return snprintf(buffer, size, "%.*f%s%s", decimals, value, param.unit[0] ? " " : "", param.unit);
+}
@@ -0,0 +1,107 @@
+/**
+ * @file parameters.h
+ * @brief Header file for the vocoder parameter registry
+ *
+ * @details This file contains the declaration of the registry of the tunable vocoder parameters. Every parameter
+ * has a fixed range, step, default and smoothing time (see parameters.cpp), it can be written by name from Serial,
+ * by MIDI control change and from the settings screen.
+ *
+ * The values reach the DSP through a double-buffered snapshot of the targets: a writer copies the published buffer
+ * into the other one, changes it there and publishes it with one atomic store. The DSP copies the published buffer
+ * once per frame. All writers run at thread level, one at a time, and the DSP runs in an interrupt above them,
+ * so a copy is never interrupted by a writer and neither side ever waits or allocates.
+ *
+ * The DSP moves every value towards its target with a one-pole smoother per frame. The frames are overlap-added,
+ * so a step between two frames is crossfaded over a hop and a smoothed change is free of zipper noise.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+#ifndef PARAMETERS_H
+#define PARAMETERS_H
+
+// Headers
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+enum class ParamId
+{
+    HighpassCutoff, // Modulator high-pass cutoff in Hz
+    GainExponent,   // Gain curve: carrier * modulator^exponent
+    UnvoicedNoise,  // Noise level of unvoiced frames
+    VoicedNoise,    // Noise offset of voiced frames
+    UnvoicedRatio,  // High to low band energy ratio above which a frame is unvoiced
+    PitchShift,     // Carrier pitch shift in semitones
+    FormantShift,   // Modulator formant shift in semitones
+    GateThreshold,  // Noise gate threshold in dBFS, the minimum is off
+    Count
+};
+
+/*
+* @struct ParamInfo
+* @brief The fixed properties of a parameter
+*/
+struct ParamInfo
+{
+    const char *name;       // For Serial and the tools
+    const char *label;      // For the settings screen
+    const char *unit;
+    float minValue;
+    float maxValue;
+    float defaultValue;
+    float step;             // One encoder step
+    float smoothingTime;    // Time constant in s, 0 applies a change at the next frame
+    uint8_t midiControl;    // MIDI control change number
+};
+
+/*
+* @class ParameterRegistry
+* @brief Lock-free hand-over of the parameter targets to the DSP, with per-frame smoothing
+*
+* @details Writer side, at thread level: set(), setNormalized() and step(). DSP side, once per frame: update(),
+* then value(). settle() is called before the DSP starts, so it starts at the targets without a ramp.
+*/
+class ParameterRegistry
+{
+    public:
+        ParameterRegistry();
+        void settle();
+
+        bool set(ParamId id, float value);
+        bool setNormalized(ParamId id, float fraction);
+        bool step(ParamId id, int steps);
+        float target(ParamId id) const { return targets[front.load(std::memory_order_acquire)][(int)id]; }
+        uint32_t revision() const { return writes.load(std::memory_order_acquire); }
+
+        uint32_t update(float frameTime);
+        float value(ParamId id) const { return current[(int)id]; }
+
+        static const ParamInfo& info(ParamId id);
+        static bool find(const char *name, ParamId &id);
+        static bool findControl(uint8_t control, ParamId &id);
+        static int format(ParamId id, float value, char *buffer, size_t size);
+
+    private:
+        static const int COUNT = (int)ParamId::Count;
+
+        float targets[2][COUNT] = {};
+        std::atomic<int> front{0};          // The published buffer
+        std::atomic<uint32_t> writes{0};    // Counts the writes, for the displays
+        float current[COUNT] = {};          // Smoothed values, DSP only
+};
+
+/*
+* @brief Parameter bit function
+*
+* @param[in] id The parameter
+* @return The bit of the parameter in the mask of update()
+*/
+static inline uint32_t paramBit(ParamId id)
+{
+    return 1u << (int)id;
+}
+
+#endif // PARAMETERS_H
@@ -0,0 +1,242 @@
+/**
+ * @file phase_vocoder.cpp
+ * @brief Phase-vocoder pitch shifter of the carrier
+ *
+ * @details This file contains the implementation of the phase-locked pitch shifter.
+ * The phase of every bin comes from a polynomial arctangent, its error below 1e-5 rad is far below what the
+ * phase unwrapping needs. The only sine and cosine are the rotation of one region per peak,
+ * all other work per bin is a few multiplications and additions.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+// Headers
+#include "phase_vocoder.h"
+#include "HAL/hal.h"
+#include <cmath>
+#include <cstring>
+
+// Defines
+static const float PHASE_PERIOD = 2.0f * PI;
+
+/*
+* @brief Fast arctangent function
+*
+* @param[in] y  The imaginary part
+* @param[in] x  The real part
+* @return Approximation of atan2f(y, x), 0 for 0
+*
+* @details The argument is reduced to 0..1, where a polynomial in z^2 has an error below 1e-5 rad.
+*/
+static inline float fastAtan2(float y, float x)
+{
+    const float absX = fabsf(x);
+    const float absY = fabsf(y);
+    const float largest = (absX > absY) ? absX : absY;
+    if (largest == 0.0f)
+        return 0.0f;
+
+    const float z = ((absX < absY) ? absX : absY) / largest;
+    const float z2 = z * z;
+    float angle = z * (0.99997726f + z2 * (-0.33262347f + z2 * (0.19354346f + z2 * (-0.11643287f + z2 * (0.05265332f - z2 * 0.01172120f)))));
+
+    angle = (absY > absX) ? 0.5f * PI - angle : angle;
+    angle = (x < 0.0f) ? PI - angle : angle;
+    return (y < 0.0f) ? -angle : angle;
+}
+
+/*
+* @brief Wrap phase function
+*
+* @param[in] phase  The phase in rad
+* @return The phase wrapped to -pi..pi
+*/
+static inline float wrapPhase(float phase)
+{
+    return phase - PHASE_PERIOD * rintf(phase * (1.0f / PHASE_PERIOD));
+}
+
+/*
+* @brief Begin function
+*
+* @param[in] maxFrameSize           The largest frame length (FFT size)
+* @param[in] voicePhaseBuffers      Buffer of `MAX_CARRIER_VOICES` * 2 * (`maxFrameSize` / 2 + 1) floats, the phases per voice
+* @param[in] advanceBuffer          Buffer of `maxFrameSize` / 2 + 1 floats, the expected phase advance per bin
+* @param[in] analysisPhaseBuffer    Buffer of `maxFrameSize` / 2 + 1 floats, scratch
+* @param[in] synthesisPhaseBuffer   Buffer of `maxFrameSize` / 2 + 1 floats, scratch
+* @param[in] peakBuffer             Buffer of `maxFrameSize` / 4 + 1 values, scratch
+*
+* @details The ratio starts at 1, so the shifter is bypassed. Call setFrameSize() before the first frame.
+*/
+void PhaseVocoder::begin(int maxFrameSize, float *voicePhaseBuffers, float *advanceBuffer,
+                         float *analysisPhaseBuffer, float *synthesisPhaseBuffer, int16_t *peakBuffer)
+{
+    maxBins = maxFrameSize / 2 + 1;
+    this->voicePhaseBuffers = voicePhaseBuffers;
+    this->advanceBuffer = advanceBuffer;
+    this->analysisPhaseBuffer = analysisPhaseBuffer;
+    this->synthesisPhaseBuffer = synthesisPhaseBuffer;
+    this->peakBuffer = peakBuffer;
+
+    pitchRatio = 1.0f;
+    reset();
+}
+
+/*
+* @brief Set frame size function
+*
+* @param[in] frameSize  The FFT size
+* @param[in] hopSize    Number of samples per hop
+*
+* @details Computes the expected phase advance per hop of every bin, 2 pi k hop / N.
+* The phases of the previous size belong to other bins, so all voices start over.
+*/
+void PhaseVocoder::setFrameSize(int frameSize, int hopSize)
+{
+    this->frameSize = frameSize;
+    bins = frameSize / 2 + 1;
+    radiansPerBin = PHASE_PERIOD * hopSize / frameSize;
+
+    for (int k = 0; k < bins; k++)
+    {
+        advanceBuffer[k] = radiansPerBin * k;
+    }
+    reset();
+}
+
+/*
+* @brief Set pitch ratio function
+*
+* @param[in] ratio  The frequency ratio, clamped to `MIN_PITCH_RATIO` to `MAX_PITCH_RATIO`, 1 bypasses the shifter
+*/
+void PhaseVocoder::setPitchRatio(float ratio)
+{
+    pitchRatio = (ratio < MIN_PITCH_RATIO) ? MIN_PITCH_RATIO : (ratio > MAX_PITCH_RATIO) ? MAX_PITCH_RATIO : ratio;
+    if (!active())
+        reset();
+}
+
+/*
+* @brief Reset function
+*
+* @details Every voice starts from its analysis phase at the next shift().
+*/
+void PhaseVocoder::reset()
+{
+    memset(primed, 0, sizeof(primed));
+}
+
+/*
+* @brief Find peaks function
+*
+* @param[in] magnitude  The magnitude of the frame
+* @return Number of peaks written to the peak buffer, in ascending order
+*
+* @details A peak is larger than its `PEAK_NEIGHBORS` neighbors on both sides, so two peaks are more than
+* that many bins apart and at most a quarter frame of peaks is found.
+*/
+int PhaseVocoder::findPeaks(const float *magnitude)
+{
+    const int nyquist = frameSize / 2;
+    int count = 0;
+
+    for (int k = 1; k < nyquist; k++)
+    {
+        const float value = magnitude[k];
+        bool peak = value > 0.0f;
+        for (int n = 1; n <= PEAK_NEIGHBORS && peak; n++)
+        {
+            peak = (k - n < 0 || value > magnitude[k - n]) && (k + n > nyquist || value >= magnitude[k + n]);
+        }
+
+        if (peak)
+        {
+            peakBuffer[count++] = (int16_t)k;
+            k += PEAK_NEIGHBORS;
+        }
+    }
+    return count;
+}
+
+/*
+* @brief Shift function
+*
+* @param[in] voice      The carrier voice, its phases of the previous frame are used and updated
+* @param[in] spectrum   The packed carrier spectrum of fftSize floats
+* @param[in] magnitude  The carrier magnitude per bin
+* @param[out] shifted   The packed shifted spectrum of fftSize floats, must not be the input spectrum
+*
+* @details Every region runs from halfway to the previous peak to halfway to the next peak.
+* The instantaneous frequency of its peak is the bin plus the unwrapped phase deviation from the expected advance.
+* The region moves by the whole number of bins closest to the shifted frequency, and it is rotated so the peak
+* phase advances by the shifted frequency since the previous frame, so the output frequency is exact even though
+* the bins are not. DC and Nyquist are left empty. Where regions overlap after a shift down, every bin keeps the
+* stronger one, so its phase stays locked to the partial that owns it.
+*/
+void PhaseVocoder::shift(int voice, const float *spectrum, const float *magnitude, float *shifted)
+{
+    const int nyquist = frameSize / 2;
+    float *previousPhase = voicePhaseBuffers + voice * 2 * maxBins;
+    float *synthesisPhase = previousPhase + maxBins;
+    const bool continuing = primed[voice];
+
+    analysisPhaseBuffer[0] = (spectrum[0] < 0.0f) ? PI : 0.0f;
+    analysisPhaseBuffer[nyquist] = (spectrum[1] < 0.0f) ? PI : 0.0f;
+    for (int k = 1; k < nyquist; k++)
+    {
+        analysisPhaseBuffer[k] = fastAtan2(spectrum[2 * k + 1], spectrum[2 * k]);
+    }
+
+    memset(shifted, 0, frameSize * sizeof(float));
+    memcpy(synthesisPhaseBuffer, synthesisPhase, bins * sizeof(float)); // Bins without output keep their phase
+
+    const int peaks = findPeaks(magnitude);
+    int regionStart = 1;
+    for (int p = 0; p < peaks; p++)
+    {
+        const int peak = peakBuffer[p];
+        const int regionEnd = (p + 1 < peaks) ? (peak + peakBuffer[p + 1] + 1) / 2 : nyquist;
+
+        // Instantaneous frequency of the peak, in bins
+        float frequency = (float)peak;
+        float peakPhase = analysisPhaseBuffer[peak];
+        if (continuing)
+        {
+            const float deviation = wrapPhase(analysisPhaseBuffer[peak] - previousPhase[peak] - advanceBuffer[peak]);
+            frequency += deviation / radiansPerBin;
+        }
+
+        const int target = (int)lrintf(frequency * pitchRatio);
+        const int offset = target - peak;
+        if (target > 0 && target < nyquist && continuing)
+            peakPhase = wrapPhase(synthesisPhase[target] + frequency * pitchRatio * radiansPerBin);
+
+        const float rotation = peakPhase - analysisPhaseBuffer[peak];
+        const float rotationCos = cosf(rotation);
+        const float rotationSin = sinf(rotation);
+
+        const int first = (regionStart + offset < 1) ? 1 - offset : regionStart;
+        const int last = (regionEnd + offset > nyquist) ? nyquist - offset : regionEnd;
+        for (int k = first; k < last; k++)
+        {
+            const int bin = k + offset;
+            const float outputReal = shifted[2 * bin];
+            const float outputImag = shifted[2 * bin + 1];
+            if (outputReal * outputReal + outputImag * outputImag >= magnitude[k] * magnitude[k])
+                continue; // A stronger region already moved here
+
+            const float real = spectrum[2 * k];
+            const float imag = spectrum[2 * k + 1];
+            shifted[2 * bin] = real * rotationCos - imag * rotationSin;
+            shifted[2 * bin + 1] = real * rotationSin + imag * rotationCos;
+            synthesisPhaseBuffer[bin] = wrapPhase(analysisPhaseBuffer[k] + rotation);
+        }
+        regionStart = regionEnd;
+    }
+
+    memcpy(previousPhase, analysisPhaseBuffer, bins * sizeof(float));
+    memcpy(synthesisPhase, synthesisPhaseBuffer, bins * sizeof(float));
+    primed[voice] = true;
+}
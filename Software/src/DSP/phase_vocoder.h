@@ -0,0 +1,76 @@
+/**
+ * @file phase_vocoder.h
+ * @brief Header file for the phase-vocoder pitch shifter of the carrier
+ *
+ * @details This file contains the declaration of the pitch shifter that runs on the carrier spectrum of the FFT engine,
+ * between the carrier FFT and the vocoding gain. It uses the phase-locked shifting of Laroche and Dolson:
+ * - The phase of every bin is unwrapped against the phase of the previous frame and the expected advance of the bin,
+ *   which gives the instantaneous frequency of the bin.
+ * - The magnitude peaks split the spectrum into regions, one per partial. Every region is moved as a whole to the
+ *   bin of its shifted peak frequency.
+ * - The peak gets the phase that continues the partial at its shifted frequency. All bins of the region are rotated
+ *   by the same angle as the peak (identity phase locking), so the shape of the partial is kept and there is only
+ *   one sine and cosine per peak, not per bin.
+ *
+ * The modulator formants are shifted independently with warpSpectrum() on the modulator gain (see spectral_kernel.h).
+ *
+ * @note The class does not allocate memory, all buffers are provided by the caller in begin().
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+#ifndef PHASE_VOCODER_H
+#define PHASE_VOCODER_H
+
+// Headers
+#include <cstdint>
+#include "voice_pool.h"
+
+// Defines
+static const float MIN_PITCH_RATIO = 0.5f;  // One octave down
+static const float MAX_PITCH_RATIO = 2.0f;  // One octave up
+static const int PEAK_NEIGHBORS = 1;        // A peak is above this many bins on both sides
+
+/*
+* @class PhaseVocoder
+* @brief Phase-locked pitch shifter for the carrier voices
+*
+* @details The expected phase advance per bin is a table, computed in setFrameSize(). Every voice keeps the analysis
+* phase and the synthesis phase of the previous frame. The per-frame scratch buffers are shared by all voices,
+* they are only used within shift(). A voice that was reset, or was not shifted while the ratio was 1, starts from its
+* analysis phase, so enabling the shifter does not need the history of the bypassed frames.
+*/
+class PhaseVocoder
+{
+    public:
+        void begin(int maxFrameSize, float *voicePhaseBuffers, float *advanceBuffer,
+                   float *analysisPhaseBuffer, float *synthesisPhaseBuffer, int16_t *peakBuffer);
+        void setFrameSize(int frameSize, int hopSize);
+        void setPitchRatio(float ratio);
+        void reset();
+        void resetVoice(int voice) { primed[voice] = false; }
+
+        bool active() const { return pitchRatio != 1.0f; }
+        float ratio() const { return pitchRatio; }
+        void shift(int voice, const float *spectrum, const float *magnitude, float *shifted);
+
+    private:
+        int findPeaks(const float *magnitude);
+
+        int maxBins = 0;
+        int frameSize = 0;
+        int bins = 0;
+        float pitchRatio = 1.0f;
+        float radiansPerBin = 0.0f;             // Phase advance per hop of one bin of frequency
+
+        float *voicePhaseBuffers = nullptr;     // Per voice of the pool: 2 * maxBins, analysis then synthesis phase
+        float *advanceBuffer = nullptr;         // Expected phase advance per bin, maxBins
+        float *analysisPhaseBuffer = nullptr;   // Scratch, maxBins
+        float *synthesisPhaseBuffer = nullptr;  // Scratch, maxBins
+        int16_t *peakBuffer = nullptr;          // Scratch, maxFrameSize / 4 + 1 peak bins
+        bool primed[MAX_CARRIER_VOICES] = {};
+};
+
+#endif // PHASE_VOCODER_H
@@ -0,0 +1,239 @@
+/**
+ * @file profiler.cpp
+ * @brief Per-stage DSP profiler
+ *
+ * @details This file contains the implementation of the profiler. The histogram has 8 buckets per octave,
+ * so the reported 99th percentile is the upper edge of its bucket and at most 12.5% too high.
+ * Recording is a handful of instructions: no division, no floating point.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+// Headers
+#include "profiler.h"
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+
+// Defines
+static const int PROFILE_SUB_BUCKETS = 8;  // Buckets per octave
+static const int PROFILE_BUCKETS = 30 * PROFILE_SUB_BUCKETS;
+
+struct ProfileStats
+{
+    uint32_t count;
+    uint32_t minCycles;
+    uint32_t maxCycles;
+    uint64_t totalCycles;
+    uint32_t histogram[PROFILE_BUCKETS];
+    std::atomic<bool> resetRequested;
+};
+
+// Variables
+static ProfileStats profileStats[(int)ProfileStage::Count];
+
+static const char *const profileStageNames[(int)ProfileStage::Count] =
+{
+    "highpass", "window", "carrier_fft", "pitch_shift", "modulator_fft", "inverse_fft", "overlap_add", "output",
+    "frame", "capture_isr", "playback_isr", "filterbank_isr"
+};
+
+/*
+* @brief Bucket function
+*
+* @param[in] cycles     The measured cycles
+* @return The histogram bucket: 0-7 exact, then 8 buckets per octave
+*/
+static inline int bucketOf(uint32_t cycles)
+{
+    if (cycles < PROFILE_SUB_BUCKETS)
+        return cycles;
+
+    const int octave = 31 - __builtin_clz(cycles);
+    return (octave - 2) * PROFILE_SUB_BUCKETS + ((cycles >> (octave - 3)) & (PROFILE_SUB_BUCKETS - 1));
+}
+
+/*
+* @brief Bucket upper edge function
+*
+* @param[in] bucket     The histogram bucket
+* @return The largest cycle count that falls in the bucket
+*/
+static uint32_t bucketUpperEdge(int bucket)
+{
+    if (bucket < PROFILE_SUB_BUCKETS)
+        return bucket;
+
+    const int octave = bucket / PROFILE_SUB_BUCKETS + 2;
+    const uint32_t lower = (uint32_t)(PROFILE_SUB_BUCKETS + bucket % PROFILE_SUB_BUCKETS) << (octave - 3);
+    return lower + (1u << (octave - 3)) - 1;
+}
+
+/*
+* @brief Clear function
+*
+* @param[out] stats     The stage statistics to clear
+*/
+static void clearStats(ProfileStats &stats)
+{
+    stats.count = 0;
+    stats.minCycles = UINT32_MAX;
+    stats.maxCycles = 0;
+    stats.totalCycles = 0;
+    memset(stats.histogram, 0, sizeof(stats.histogram));
+}
+
+/*
+* @brief Profile record function
+*
+* @param[in] stage      The measured stage
+* @param[in] cycles     The measured cycles
+*
+* @details Call from the context that owns the stage only.
+*/
+void profileRecord(ProfileStage stage, uint32_t cycles)
+{
+    ProfileStats &stats = profileStats[(int)stage];
+
+    if (stats.resetRequested.load(std::memory_order_acquire))
+    {
+        clearStats(stats);
+        stats.resetRequested.store(false, std::memory_order_release);
+    }
+    else if (stats.count == 0)
+    {
+        stats.minCycles = UINT32_MAX;
+    }
+
+    stats.count++;
+    stats.totalCycles += cycles;
+    if (cycles < stats.minCycles) stats.minCycles = cycles;
+    if (cycles > stats.maxCycles) stats.maxCycles = cycles;
+    stats.histogram[bucketOf(cycles)]++;
+}
+
+/*
+* @brief Profile summary function
+*
+* @param[in] stage      The stage
+* @param[out] summary   The statistics since the last reset
+* @return False when the stage has not been recorded since the last reset
+*
+* @details Reading a stage that is recorded from an interrupt can mix two samples, that is fine for diagnostics.
+*/
+bool profileSummary(ProfileStage stage, ProfileSummary &summary)
+{
+    const ProfileStats &stats = profileStats[(int)stage];
+    const uint32_t count = stats.count;
+
+    if (count == 0 || stats.resetRequested.load(std::memory_order_acquire))
+    {
+        summary = ProfileSummary{0, 0, 0, 0, 0};
+        return false;
+    }
+
+    summary.count = count;
+    summary.minCycles = stats.minCycles;
+    summary.maxCycles = stats.maxCycles;
+    summary.avgCycles = (uint32_t)(stats.totalCycles / count);
+
+    const uint32_t target = count - count / 100; // ceil(0.99 * count)
+    uint32_t seen = 0;
+    summary.p99Cycles = stats.maxCycles;
+    for (int bucket = 0; bucket < PROFILE_BUCKETS; bucket++)
+    {
+        seen += stats.histogram[bucket];
+        if (seen >= target)
+        {
+            uint32_t edge = bucketUpperEdge(bucket);
+            summary.p99Cycles = (edge < stats.maxCycles) ? edge : stats.maxCycles;
+            break;
+        }
+    }
+    return true;
+}
+
+/*
+* @brief Profile reset function
+*
+* @details Requests a reset of all stages, each stage is cleared before its next sample.
+*/
+void profileReset()
+{
+    for (ProfileStats &stats : profileStats)
+    {
+        stats.resetRequested.store(true, std::memory_order_release);
+    }
+}
+
+/*
+* @brief Profile stage name function
+*
+* @param[in] stage  The stage
+* @return The stage name as used in the CSV output
+*/
+const char *profileStageName(ProfileStage stage)
+{
+    return profileStageNames[(int)stage];
+}
+
+/*
+* @brief Profile frame load function
+*
+* @param[in] hopSize        The active hop size
+* @param[in] sampleRate     The sample rate in Hz
+* @return The average vocoder frame time as a percentage of the hop period
+*/
+float profileFrameLoad(int hopSize, float sampleRate)
+{
+    ProfileSummary frame;
+    if (!profileSummary(ProfileStage::Frame, frame))
+        return 0.0f;
+
+    const float periodCycles = hopSize * (float)halCyclesPerSecond() / sampleRate;
+    return 100.0f * frame.avgCycles / periodCycles;
+}
+
+/*
+* @brief Profile ISR load function
+*
+* @param[in] blockSize      Samples per audio block (AUDIO_BLOCK_SAMPLES)
+* @param[in] sampleRate     The sample rate in Hz
+* @return The average time of the profiled audio interrupts per block as a percentage of the block period
+*/
+float profileIsrLoad(int blockSize, float sampleRate)
+{
+    const float periodCycles = blockSize * (float)halCyclesPerSecond() / sampleRate;
+    float load = 0.0f;
+
+    for (ProfileStage stage : {ProfileStage::CaptureIsr, ProfileStage::PlaybackIsr, ProfileStage::FilterBankIsr})
+    {
+        ProfileSummary isr;
+        if (profileSummary(stage, isr))
+            load += 100.0f * isr.avgCycles / periodCycles;
+    }
+    return load;
+}
+
+/*
+* @brief Profile format CSV function
+*
+* @param[in] stage      The stage
+* @param[out] buffer    The output line, without newline
+* @param[in] size       Size of the output buffer
+* @return Number of characters written, 0 when the stage has no samples
+*
+* @details Format: prof,<stage>,<count>,<min>,<avg>,<max>,<p99>, all times in cycles (ns on the native build).
+*/
+int profileFormatCsv(ProfileStage stage, char *buffer, size_t size)
+{
+    ProfileSummary summary;
+    if (!profileSummary(stage, summary))
+        return 0;
+
+    return snprintf(buffer, size, "prof,%s,%lu,%lu,%lu,%lu,%lu", profileStageName(stage),
+                    (unsigned long)summary.count, (unsigned long)summary.minCycles, (unsigned long)summary.avgCycles,
+                    (unsigned long)summary.maxCycles, (unsigned long)summary.p99Cycles);
+}
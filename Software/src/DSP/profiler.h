@@ -0,0 +1,79 @@
+/**
+ * @file profiler.h
+ * @brief Header file for the per-stage DSP profiler
+ *
+ * @details This file contains the declarations of a lightweight profiler that measures every stage of the
+ * processing chain and the audio interrupts with the cycle counter (see HAL/cycle_counter.h).
+ * Per stage it keeps the count, min, max, average and a log-scale histogram for the 99th percentile.
+ *
+ * Profiling is compiled in with the build flag `-DVOCODER_PROFILING=1`. Without it the PROFILE_* macros
+ * are empty and the stages cost nothing.
+ *
+ * Every stage is recorded from one context only (the frame interrupt or one audio interrupt), so no locking is needed.
+ * A reset is requested from the reporting side and carried out by the recording side on its next sample.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+// Headers
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "HAL/cycle_counter.h"
+
+#ifndef VOCODER_PROFILING
+    #define VOCODER_PROFILING 0
+#endif
+
+enum class ProfileStage : uint8_t
+{
+    Highpass,       // Modulator highpass
+    Window,         // STFT history push and convertInt16ToFloat
+    CarrierFFT,     // processFFT on the carrier
+    PitchShift,     // Phase-vocoder pitch shift of the carrier
+    ModulatorFFT,   // processFFT on the modulator
+    InverseFFT,     // Gain, vocoding and inverse FFT
+    OverlapAdd,     // Overlap-add and hop readout
+    Output,         // convertFloatToInt16
+    Frame,          // The whole processVocoderFrame()
+    CaptureIsr,     // CaptureProcessor update()
+    PlaybackIsr,    // PlaybackProcessor update()
+    FilterBankIsr,  // FilterBankProcessor update()
+    Count
+};
+
+struct ProfileSummary
+{
+    uint32_t count;
+    uint32_t minCycles;
+    uint32_t avgCycles;
+    uint32_t maxCycles;
+    uint32_t p99Cycles;
+};
+
+// Function prototypes
+void profileRecord(ProfileStage stage, uint32_t cycles);
+bool profileSummary(ProfileStage stage, ProfileSummary &summary);
+void profileReset();
+const char *profileStageName(ProfileStage stage);
+float profileFrameLoad(int hopSize, float sampleRate);
+float profileIsrLoad(int blockSize, float sampleRate);
+int profileFormatCsv(ProfileStage stage, char *buffer, size_t size);
+
+#if VOCODER_PROFILING
+    // Starts a lap timer
+    #define PROFILE_BEGIN(timer) uint32_t timer = halCycleCount()
+    // Records the time since the previous lap as `stage` and starts the next lap
+    #define PROFILE_LAP(timer, stage) \
+        do { uint32_t profileNow = halCycleCount(); profileRecord(stage, profileNow - timer); timer = profileNow; } while (0)
+#else
+    #define PROFILE_BEGIN(timer) do {} while (0)
+    #define PROFILE_LAP(timer, stage) do {} while (0)
+#endif
+
+#endif // PROFILER_H
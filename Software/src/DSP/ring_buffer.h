@@ -0,0 +1,154 @@
+/**
+ * @file ring_buffer.h
+ * @brief Lock-free single-producer/single-consumer ring buffer
+ *
+ * @details This file contains a templated ring buffer for passing samples between an
+ * audio interrupt and the frame interrupt. One side only writes and the other side only reads,
+ * so no locks are needed: the indices are published with release/acquire ordering, which
+ * also emits the memory barriers the Cortex-M7 needs.
+ * The buffer never blocks. Samples that do not fit are dropped and counted as overruns,
+ * reads that find too few samples are zero filled and counted as underruns.
+ *
+ * @note Capacity must be a power of two. One instance supports exactly one producer and one consumer.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+// Headers
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+/*
+* @class SpscRingBuffer
+* @brief Lock-free single-producer/single-consumer ring buffer
+*
+* @tparam T         Element type, must be trivially copyable
+* @tparam Capacity  Number of elements, power of two
+*
+* @details The head index is only written by the producer and the tail index only by the consumer.
+* Both run freely, the difference between them is the fill level.
+*/
+template <typename T, uint32_t Capacity>
+class SpscRingBuffer
+{
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    public:
+        /*
+        * @brief Write function (producer side)
+        *
+        * @param[in] data   The elements to write
+        * @param[in] count  Number of elements
+        * @return Number of elements written, the rest is dropped and counted as overrun
+        */
+        uint32_t write(const T *data, uint32_t count)
+        {
+            const uint32_t h = head.load(std::memory_order_relaxed);
+            const uint32_t free = Capacity - (h - tail.load(std::memory_order_acquire));
+
+            if (count > free)
+            {
+                overrunCount.fetch_add(count - free, std::memory_order_relaxed);
+                count = free;
+            }
+
+            copyIn(h, data, count);
+            head.store(h + count, std::memory_order_release);
+            return count;
+        }
+
+        /*
+        * @brief Read function (consumer side)
+        *
+        * @param[out] data  The destination for the elements
+        * @param[in] count  Number of elements
+        * @return Number of elements read, missing elements are zero filled and counted as underrun
+        */
+        uint32_t read(T *data, uint32_t count)
+        {
+            const uint32_t t = tail.load(std::memory_order_relaxed);
+            const uint32_t used = head.load(std::memory_order_acquire) - t;
+            uint32_t n = count;
+
+            if (n > used)
+            {
+                underrunCount.fetch_add(n - used, std::memory_order_relaxed);
+                memset(data + used, 0, (n - used) * sizeof(T));
+                n = used;
+            }
+
+            copyOut(t, data, n);
+            tail.store(t + n, std::memory_order_release);
+            return n;
+        }
+
+        /*
+        * @brief Discard function (consumer side)
+        *
+        * @return Number of elements dropped
+        *
+        * @details Drops everything that has been written so far, the next read starts at the newest data.
+        */
+        uint32_t discard()
+        {
+            const uint32_t t = tail.load(std::memory_order_relaxed);
+            const uint32_t h = head.load(std::memory_order_acquire);
+            tail.store(h, std::memory_order_release);
+            return h - t;
+        }
+
+        /*
+        * @brief Available function (consumer side)
+        *
+        * @return Number of elements that can be read
+        */
+        uint32_t available() const
+        {
+            return head.load(std::memory_order_acquire) - tail.load(std::memory_order_relaxed);
+        }
+
+        /*
+        * @brief Space function (producer side)
+        *
+        * @return Number of elements that can be written
+        */
+        uint32_t space() const
+        {
+            return Capacity - (head.load(std::memory_order_relaxed) - tail.load(std::memory_order_acquire));
+        }
+
+        uint32_t overruns() const { return overrunCount.load(std::memory_order_relaxed); }
+        uint32_t underruns() const { return underrunCount.load(std::memory_order_relaxed); }
+        static constexpr uint32_t capacity() { return Capacity; }
+
+    private:
+        void copyIn(uint32_t index, const T *data, uint32_t count)
+        {
+            const uint32_t start = index & (Capacity - 1);
+            const uint32_t first = (count < Capacity - start) ? count : Capacity - start;
+            memcpy(&buffer[start], data, first * sizeof(T));
+            memcpy(&buffer[0], data + first, (count - first) * sizeof(T));
+        }
+
+        void copyOut(uint32_t index, T *data, uint32_t count) const
+        {
+            const uint32_t start = index & (Capacity - 1);
+            const uint32_t first = (count < Capacity - start) ? count : Capacity - start;
+            memcpy(data, &buffer[start], first * sizeof(T));
+            memcpy(data + first, &buffer[0], (count - first) * sizeof(T));
+        }
+
+        T buffer[Capacity];
+        std::atomic<uint32_t> head{0};
+        std::atomic<uint32_t> tail{0};
+        std::atomic<uint32_t> overrunCount{0};
+        std::atomic<uint32_t> underrunCount{0};
+};
+
+#endif // RING_BUFFER_H
@@ -0,0 +1,389 @@
+/**
+ * @file spectral_envelope.cpp
+ * @brief Modulator spectral envelope
+ *
+ * @details This file contains the implementation of the spectral envelope stage.
+ * The modulator power spectrum is summed into mel-spaced bands, the band powers are smoothed and
+ * the result is scaled to the same energy as the band powers, so the output level does not depend
+ * on the method or order. The envelope is returned as a magnitude per band.
+ *
+ * Cepstral: log band power, orthonormal DCT, keep the first `order` coefficients, inverse DCT, exp.
+ * LPC: autocorrelation from the band powers (Wiener-Khinchin), Levinson-Durbin, 1 / |A(w)|^2 per band.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+// Headers
+#include "spectral_envelope.h"
+#include "HAL/hal.h"
+
+/*
+* @brief Begin function
+*
+* @param[in] bands          Number of bands, up to `MAX_ENVELOPE_BANDS`
+* @param[in] method         The smoothing method
+* @param[in] order          Number of cepstral coefficients or LPC order, up to `MAX_ENVELOPE_ORDER`
+* @param[in] sampleRate     The sample rate in Hz
+* @return False when the configuration is not supported
+*
+* @details This function designs the mel band grid and precomputes the cepstral basis and the
+* band center rotations used by the LPC method.
+*/
+bool SpectralEnvelope::begin(int bands, EnvelopeMethod method, int order, float sampleRate)
+{
+    if (bands < 2 || bands > MAX_ENVELOPE_BANDS || order < 1 || order > MAX_ENVELOPE_ORDER || order >= bands)
+        return false;
+
+    this->sampleRate = sampleRate;
+    envelopeMethod = method;
+    bandCount = bands;
+    envelopeOrder = order;
+
+    const float maxMel = 2595.0f * log10f(1.0f + (sampleRate / 2.0f) / 700.0f);
+    for (int b = 0; b <= bands; b++)
+    {
+        edgeHz[b] = 700.0f * (powf(10.0f, (maxMel * b / bands) / 2595.0f) - 1.0f);
+    }
+
+    for (int b = 0; b < bands; b++)
+    {
+        const float centerMel = maxMel * (b + 0.5f) / bands;
+        centerHz[b] = 700.0f * (powf(10.0f, centerMel / 2595.0f) - 1.0f);
+        widthHz[b] = edgeHz[b + 1] - edgeHz[b];
+        centerCos[b] = cosf(2.0f * PI * centerHz[b] / sampleRate);
+        centerSin[b] = sinf(2.0f * PI * centerHz[b] / sampleRate);
+        bandPower[b] = 0.0f;
+        bandEnvelope[b] = 0.0f;
+    }
+
+    for (int k = 0; k < order; k++)
+    {
+        const float norm = sqrtf((k == 0 ? 1.0f : 2.0f) / bands);
+        for (int b = 0; b < bands; b++)
+        {
+            cepstralBasis[k][b] = norm * cosf(PI * k * (b + 0.5f) / bands);
+        }
+    }
+
+    return true;
+}
+
+/*
+* @brief Set frame size function
+*
+* @param[in] fftSize    The FFT size
+*
+* @details This function maps the bands to FFT bins. Bands narrower than one bin share a bin.
+*/
+void SpectralEnvelope::setFrameSize(int fftSize)
+{
+    const int bins = fftSize / 2 + 1;
+    const float binsPerHz = fftSize / sampleRate;
+
+    for (int b = 0; b < bandCount; b++)
+    {
+        int first = (int)(edgeHz[b] * binsPerHz + 0.5f);
+        int last = (int)(edgeHz[b + 1] * binsPerHz + 0.5f);
+
+        if (first > bins - 1) first = bins - 1;
+        if (last <= first) last = first + 1;
+        if (last > bins) last = bins;
+
+        firstBin[b] = first;
+        lastBin[b] = last;
+        centerBin[b] = centerHz[b] * binsPerHz;
+    }
+}
+
+/*
+* @brief Process function
+*
+* @param[in] magnitude  The modulator magnitude of the fftSize / 2 + 1 bins
+*
+* @details This function computes the band powers and the smoothed envelope of one frame.
+*/
+void SpectralEnvelope::process(const float *magnitude)
+{
+    if (envelopeMethod == EnvelopeMethod::None)
+        return;
+
+    for (int b = 0; b < bandCount; b++)
+    {
+        float sum = 0.0f;
+        for (int i = firstBin[b]; i < lastBin[b]; i++)
+        {
+            sum += magnitude[i] * magnitude[i];
+        }
+        bandPower[b] = sum / (lastBin[b] - firstBin[b]);
+    }
+    updateEnvelope();
+}
+
+/*
+* @brief Process function, fixed-point
+*
+* @param[in] magnitude  The modulator magnitude of the fftSize / 2 + 1 bins, in Q31
+* @param[in] exponent   Block exponent, the magnitude is magnitude[i] * 2^exponent
+*
+* @details Same as the float version. The squares are summed in 64 bits with the 8 lowest bits dropped,
+* so even the widest band cannot overflow. The band powers are converted to float once per band.
+*/
+void SpectralEnvelope::process(const q31_t *magnitude, int exponent)
+{
+    if (envelopeMethod == EnvelopeMethod::None)
+        return;
+
+    for (int b = 0; b < bandCount; b++)
+    {
+        q63_t sum = 0;
+        for (int i = firstBin[b]; i < lastBin[b]; i++)
+        {
+            const q31_t value = magnitude[i] >> 8;
+            sum += (q63_t)value * value;
+        }
+        bandPower[b] = ldexpf((float)sum, 2 * (exponent + 8)) / (lastBin[b] - firstBin[b]);
+    }
+    updateEnvelope();
+}
+
+/*
+* @brief Update envelope function
+*
+* @details This function smooths the band powers of the current frame into the envelope.
+*/
+void SpectralEnvelope::updateEnvelope()
+{
+    float bandEnergy = 0.0f;
+    for (int b = 0; b < bandCount; b++)
+    {
+        bandEnergy += bandPower[b] * widthHz[b];
+    }
+
+    if (bandEnergy <= 0.0f)
+    {
+        memset(bandEnvelope, 0, sizeof(bandEnvelope));
+        return;
+    }
+
+    float model[MAX_ENVELOPE_BANDS];
+    if (envelopeMethod == EnvelopeMethod::Cepstral)
+        smoothCepstral(model);
+    else
+        smoothLpc(model);
+
+    // Scale the model to the energy of the band powers
+    float modelEnergy = 0.0f;
+    for (int b = 0; b < bandCount; b++)
+    {
+        modelEnergy += model[b] * widthHz[b];
+    }
+    const float scale = (modelEnergy > 0.0f) ? bandEnergy / modelEnergy : 0.0f;
+
+    for (int b = 0; b < bandCount; b++)
+    {
+        bandEnvelope[b] = sqrtf(scale * model[b]);
+    }
+}
+
+/*
+* @brief Smooth cepstral function
+*
+* @param[out] model     The smoothed band power, up to a constant factor
+*/
+void SpectralEnvelope::smoothCepstral(float *model) const
+{
+    const float floorPower = 1e-12f;
+    float logPower[MAX_ENVELOPE_BANDS];
+    float cepstrum[MAX_ENVELOPE_ORDER];
+
+    for (int b = 0; b < bandCount; b++)
+    {
+        logPower[b] = logf(bandPower[b] + floorPower);
+    }
+
+    // Only the low quefrencies are computed, that is the lifter.
+    // c0 is the mean log power, it is left out to keep expf() in range, the energy normalization restores the level.
+    for (int k = 1; k < envelopeOrder; k++)
+    {
+        float sum = 0.0f;
+        for (int b = 0; b < bandCount; b++)
+        {
+            sum += logPower[b] * cepstralBasis[k][b];
+        }
+        cepstrum[k] = sum;
+    }
+
+    for (int b = 0; b < bandCount; b++)
+    {
+        float sum = 0.0f;
+        for (int k = 1; k < envelopeOrder; k++)
+        {
+            sum += cepstrum[k] * cepstralBasis[k][b];
+        }
+        model[b] = expf(sum);
+    }
+}
+
+/*
+* @brief Smooth LPC function
+*
+* @param[out] model     The all-pole band power, up to a constant factor
+*
+* @details cos(k * w) and sin(k * w) are generated by rotating with the precomputed band center,
+* so there is no trigonometry per frame.
+*/
+void SpectralEnvelope::smoothLpc(float *model) const
+{
+    const int order = envelopeOrder;
+    float autocorrelation[MAX_ENVELOPE_ORDER + 1] = {0};
+
+    for (int b = 0; b < bandCount; b++)
+    {
+        const float power = bandPower[b] * widthHz[b];
+        float c = 1.0f;
+        float s = 0.0f;
+        for (int k = 0; k <= order; k++)
+        {
+            autocorrelation[k] += power * c;
+            const float next = c * centerCos[b] - s * centerSin[b];
+            s = s * centerCos[b] + c * centerSin[b];
+            c = next;
+        }
+    }
+
+    // Levinson-Durbin, with a -60 dB noise floor to keep the recursion stable
+    float lpc[MAX_ENVELOPE_ORDER + 1] = {1.0f};
+    float previous[MAX_ENVELOPE_ORDER + 1];
+    float error = autocorrelation[0] * 1.000001f;
+
+    for (int i = 1; i <= order && error > 0.0f; i++)
+    {
+        float acc = autocorrelation[i];
+        for (int j = 1; j < i; j++)
+        {
+            acc += lpc[j] * autocorrelation[i - j];
+        }
+        const float reflection = -acc / error;
+
+        memcpy(previous, lpc, sizeof(float) * i);
+        for (int j = 1; j < i; j++)
+        {
+            lpc[j] = previous[j] + reflection * previous[i - j];
+        }
+        lpc[i] = reflection;
+        error *= 1.0f - reflection * reflection;
+    }
+
+    for (int b = 0; b < bandCount; b++)
+    {
+        float real = 1.0f;
+        float imag = 0.0f;
+        float c = 1.0f;
+        float s = 0.0f;
+        for (int k = 1; k <= order; k++)
+        {
+            const float next = c * centerCos[b] - s * centerSin[b];
+            s = s * centerCos[b] + c * centerSin[b];
+            c = next;
+            real += lpc[k] * c;
+            imag -= lpc[k] * s;
+        }
+        const float response = real * real + imag * imag;
+        model[b] = (response > 0.0f) ? 1.0f / response : 0.0f;
+    }
+}
+
+/*
+* @brief Expand gain function
+*
+* @param[in] curve      The gain curve applied to the envelope
+* @param[in] scale      Output scale of the curve
+* @param[out] gain      The gain per bin
+* @param[in] bins       Number of bins (fftSize / 2 + 1)
+*
+* @details The curve is evaluated once per band and linearly interpolated between the band centers.
+* Bins below the first or above the last center get the gain of that band.
+*/
+void SpectralEnvelope::expandGain(const GainCurve &curve, float scale, float *gain, int bins) const
+{
+    float bandGain[MAX_ENVELOPE_BANDS];
+    for (int b = 0; b < bandCount; b++)
+    {
+        bandGain[b] = scale * curve(bandEnvelope[b]);
+    }
+
+    int i = 0;
+    for (; i < bins && i <= centerBin[0]; i++)
+    {
+        gain[i] = bandGain[0];
+    }
+
+    for (int b = 0; b + 1 < bandCount; b++)
+    {
+        const float span = centerBin[b + 1] - centerBin[b];
+        const float slope = (span > 0.0f) ? (bandGain[b + 1] - bandGain[b]) / span : 0.0f;
+        for (; i < bins && i <= centerBin[b + 1]; i++)
+        {
+            gain[i] = bandGain[b] + slope * (i - centerBin[b]);
+        }
+    }
+
+    for (; i < bins; i++)
+    {
+        gain[i] = bandGain[bandCount - 1];
+    }
+}
+
+/*
+* @brief Expand gain function, fixed-point
+*
+* @param[in] curve      The gain curve applied to the envelope
+* @param[in] scale      Output scale of the curve
+* @param[out] gain      The gain per bin, with the returned number of fractional bits
+* @param[in] bins       Number of bins (fftSize / 2 + 1)
+* @return Number of fractional bits of the gains, see gainFractionalBits()
+*
+* @details Same interpolation as the float version. The start of every band segment is computed in float,
+* the bins are then stepped with a 64-bit accumulator that has 16 extra fractional bits, so the
+* rounding of the slope does not build up over wide bands.
+*/
+int SpectralEnvelope::expandGain(const GainCurve &curve, float scale, q31_t *gain, int bins) const
+{
+    float bandGain[MAX_ENVELOPE_BANDS];
+    float peakGain = 0.0f;
+    for (int b = 0; b < bandCount; b++)
+    {
+        bandGain[b] = scale * curve(bandEnvelope[b]);
+        peakGain = (bandGain[b] > peakGain) ? bandGain[b] : peakGain;
+    }
+    const int fractionalBits = gainFractionalBits(peakGain);
+
+    int i = 0;
+    const q31_t firstGain = (q31_t)lrintf(ldexpf(bandGain[0], fractionalBits));
+    for (; i < bins && i <= centerBin[0]; i++)
+    {
+        gain[i] = firstGain;
+    }
+
+    for (int b = 0; b + 1 < bandCount; b++)
+    {
+        const float span = centerBin[b + 1] - centerBin[b];
+        const float slope = (span > 0.0f) ? (bandGain[b + 1] - bandGain[b]) / span : 0.0f;
+        q63_t value = llrintf(ldexpf(bandGain[b] + slope * (i - centerBin[b]), fractionalBits + 16));
+        const q63_t step = llrintf(ldexpf(slope, fractionalBits + 16));
+        for (; i < bins && i <= centerBin[b + 1]; i++)
+        {
+            gain[i] = (q31_t)(value >> 16);
+            value += step;
+        }
+    }
+
+    const q31_t lastGain = (q31_t)lrintf(ldexpf(bandGain[bandCount - 1], fractionalBits));
+    for (; i < bins; i++)
+    {
+        gain[i] = lastGain;
+    }
+    return fractionalBits;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file spectral_envelope.h
+ * @brief Header file for the modulator spectral envelope
+ *
+ * @details This file contains the declaration of the spectral envelope stage. It reduces the modulator
+ * magnitude spectrum to a smooth envelope on a small mel-spaced band grid, so the pitch harmonics of the
+ * modulator no longer leak into the output. The envelope is smoothed by cepstral liftering or by an
+ * LPC model (Levinson-Durbin), both with a configurable order.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+#ifndef SPECTRAL_ENVELOPE_H
+#define SPECTRAL_ENVELOPE_H
+
+// Headers
+#include "spectral_kernel.h"
+#include "HAL/hal.h"
+
+// Defines
+static const int MAX_ENVELOPE_BANDS = 40;
+static const int MAX_ENVELOPE_ORDER = 24;
+
+enum class EnvelopeMethod
+{
+    None,       // Per-bin modulator magnitude, no smoothing
+    Cepstral,   // Low-quefrency liftering of the log band energies
+    Lpc         // All-pole model from the band energies
+};
+
+/*
+* @class SpectralEnvelope
+* @brief Smooth modulator envelope on a decimated band grid
+*
+* @details The band grid and its tables are computed in begin(), setFrameSize() only maps the bands to FFT bins.
+* process() costs O(bins) additions for the band energies and O(bands * order) for the smoothing,
+* with one log/exp per band for the cepstral method and none for LPC.
+* expandGain() evaluates the gain curve once per band and interpolates it linearly over the bins.
+* The Q31 overloads serve the fixed-point engine: the band energies are summed in integers and only
+* the O(bands) smoothing is done in float.
+*/
+class SpectralEnvelope
+{
+    public:
+        bool begin(int bands, EnvelopeMethod method, int order, float sampleRate);
+        void setFrameSize(int fftSize);
+        void process(const float *magnitude);
+        void process(const q31_t *magnitude, int exponent);
+        void expandGain(const GainCurve &curve, float scale, float *gain, int bins) const;
+        int expandGain(const GainCurve &curve, float scale, q31_t *gain, int bins) const;
+
+        EnvelopeMethod method() const { return envelopeMethod; }
+        int bands() const { return bandCount; }
+        int order() const { return envelopeOrder; }
+        const float *envelope() const { return bandEnvelope; }
+
+    private:
+        void updateEnvelope();
+        void smoothCepstral(float *model) const;
+        void smoothLpc(float *model) const;
+
+        EnvelopeMethod envelopeMethod = EnvelopeMethod::None;
+        int bandCount = 0;
+        int envelopeOrder = 0;
+        float sampleRate = 44100.0f;
+
+        // Band grid, independent of the FFT size
+        float edgeHz[MAX_ENVELOPE_BANDS + 1];
+        float widthHz[MAX_ENVELOPE_BANDS];
+        float centerHz[MAX_ENVELOPE_BANDS];
+        float centerCos[MAX_ENVELOPE_BANDS];
+        float centerSin[MAX_ENVELOPE_BANDS];
+        float cepstralBasis[MAX_ENVELOPE_ORDER][MAX_ENVELOPE_BANDS];
+
+        // Band to bin mapping for the active FFT size
+        int firstBin[MAX_ENVELOPE_BANDS];
+        int lastBin[MAX_ENVELOPE_BANDS];
+        float centerBin[MAX_ENVELOPE_BANDS];
+
+        float bandPower[MAX_ENVELOPE_BANDS];
+        float bandEnvelope[MAX_ENVELOPE_BANDS];
+};
+
+#endif // SPECTRAL_ENVELOPE_H
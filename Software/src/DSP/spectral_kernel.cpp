@@ -0,0 +1,198 @@
+/**
+ * @file spectral_kernel.cpp
+ * @brief Complex-domain vocoding kernel
+ *
+ * @details This file contains the vocoding kernel. Instead of converting the carrier to magnitude and phase
+ * and back (sqrtf, atan2f, cosf, sinf and pow per bin), the carrier's complex bins are multiplied by a real gain:
+ * scaling a complex number keeps its phase, so the result is the same without any trigonometry.
+ * The complex parts use the CMSIS vector functions, which are SIMD optimized on the Teensy and
+ * auto-vectorized plain loops on the native build.
+ *
+ * All spectra use the CMSIS packed real FFT format: [Re X(0), Re X(N/2), Re X(1), Im X(1), ...].
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+// Headers
+#include "spectral_kernel.h"
+#include "HAL/hal.h"
+
+/*
+* @brief Begin function
+*
+* @param[in] exponent   The curve exponent
+*
+* @details This function precomputes the exponent and mantissa tables.
+*/
+void GainCurve::begin(float exponent)
+{
+    curveExponent = exponent;
+
+    exponentTable[0] = 0.0f; // Zero and denormals
+    for (int e = 1; e < 256; e++)
+    {
+        exponentTable[e] = (float)pow(2.0, exponent * (e - 127));
+    }
+
+    for (int i = 0; i <= (1 << MANTISSA_BITS); i++)
+    {
+        mantissaTable[i] = (float)pow(1.0 + (double)i / (1 << MANTISSA_BITS), exponent);
+    }
+}
+
+/*
+* @brief Compute magnitude function
+*
+* @param[in] spectrum   The packed spectrum of fftSize floats
+* @param[out] magnitude The magnitude of the fftSize / 2 + 1 bins
+* @param[in] fftSize    The FFT size
+*/
+void computeMagnitude(float *spectrum, float *magnitude, int fftSize)
+{
+    const int nyquist = fftSize / 2;
+
+    arm_cmplx_mag_f32(spectrum + 2, magnitude + 1, nyquist - 1);
+    magnitude[0] = fabsf(spectrum[0]);
+    magnitude[nyquist] = fabsf(spectrum[1]);
+}
+
+/*
+* @brief Compute curve gain function
+*
+* @param[in] modulatorMagnitude The modulator magnitude per bin
+* @param[out] gain              The gain per bin
+* @param[in] bins               Number of bins (fftSize / 2 + 1)
+* @param[in] curve              The gain curve applied to the modulator magnitude
+* @param[in] scale              Output scale of the curve
+*
+* @details gain = scale * curve(modulator), the modulator term of the vocoding gain.
+* Together with addCarrierOffset() the carrier bin becomes |carrier| * scale * curve(modulator) + carrierOffset
+* with the carrier phase, which is the magnitude formula of the polar implementation.
+*/
+void computeCurveGain(const float *modulatorMagnitude, float *gain, int bins, const GainCurve &curve, float scale)
+{
+    for (int i = 0; i < bins; i++)
+    {
+        gain[i] = scale * curve(modulatorMagnitude[i]);
+    }
+}
+
+/*
+* @brief Add carrier offset function
+*
+* @param[in] carrierMagnitude   The carrier magnitude per bin
+* @param[in,out] gain           The gain per bin, the offset is added in place
+* @param[in] bins               Number of bins (fftSize / 2 + 1)
+* @param[in] carrierOffset      Constant magnitude added to the carrier along its own phase
+*
+* @details The carrier term of the vocoding gain, added to a modulator gain that has already been computed.
+*/
+void addCarrierOffset(const float *carrierMagnitude, float *gain, int bins, float carrierOffset)
+{
+    for (int i = 0; i < bins; i++)
+    {
+        gain[i] += (carrierMagnitude[i] > 0.0f) ? carrierOffset / carrierMagnitude[i] : 0.0f;
+    }
+}
+
+/*
+* @brief Apply spectral gain function
+*
+* @param[in,out] spectrum   The packed spectrum of fftSize floats, scaled in place
+* @param[in] gain           The gain per bin (fftSize / 2 + 1 bins)
+* @param[in] fftSize        The FFT size
+*/
+void applySpectralGain(float *spectrum, float *gain, int fftSize)
+{
+    const int nyquist = fftSize / 2;
+
+    spectrum[0] *= gain[0];
+    spectrum[1] *= gain[nyquist];
+    arm_cmplx_mult_real_f32(spectrum + 2, gain + 1, spectrum + 2, nyquist - 1);
+}
+
+/*
+* @brief Apply noise excitation function
+*
+* @param[out] spectrum      The packed spectrum of fftSize floats, replaced by noise
+* @param[in] amplitude      The rms magnitude per bin (fftSize / 2 + 1 bins)
+* @param[in] fftSize        The FFT size
+* @param[in,out] noise      The generator, a new value per component
+*
+* @details Every bin gets independent uniform real and imaginary parts, so the result is noise with the given
+* spectral shape and a new random phase in every frame. DC and Nyquist are real.
+*/
+void applyNoiseExcitation(float *spectrum, const float *amplitude, int fftSize, NoiseGenerator &noise)
+{
+    const int nyquist = fftSize / 2;
+
+    spectrum[0] = amplitude[0] * noise.uniform();
+    spectrum[1] = amplitude[nyquist] * noise.uniform();
+    for (int i = 1; i < nyquist; i++)
+    {
+        spectrum[2 * i] = amplitude[i] * noise.uniform();
+        spectrum[2 * i + 1] = amplitude[i] * noise.uniform();
+    }
+}
+
+/*
+* @brief Warp spectrum function
+*
+* @param[in,out] values The value per bin, warped in place
+* @param[in] bins       Number of bins (fftSize / 2 + 1)
+* @param[in] ratio      The frequency ratio, above 1 moves the values up
+*
+* @details values[k] becomes values[k / ratio], linearly interpolated, beyond the last bin the last value is kept.
+* Moving up reads only bins below the one written, so it runs from the top down, moving down runs from the bottom up.
+* Applied to the modulator gain this shifts the formants without changing the carrier pitch.
+*/
+void warpSpectrum(float *values, int bins, float ratio)
+{
+    const float step = 1.0f / ratio;
+    const int last = bins - 1;
+
+    if (ratio > 1.0f)
+    {
+        for (int k = last; k > 0; k--)
+        {
+            const float position = k * step;
+            const int index = (int)position;
+            const float fraction = position - index;
+            values[k] = values[index] + fraction * (values[index + 1] - values[index]);
+        }
+    }
+    else if (ratio < 1.0f)
+    {
+        for (int k = 0; k <= last; k++)
+        {
+            const float position = k * step;
+            const int index = (int)position;
+            if (index >= last)
+            {
+                values[k] = values[last];
+                continue;
+            }
+            const float fraction = position - index;
+            values[k] = values[index] + fraction * (values[index + 1] - values[index]);
+        }
+    }
+}
+
+/*
+* @brief Gain fractional bits function
+*
+* @param[in] peakGain   The largest gain of the block
+* @return Number of fractional bits, 0 to 30
+*
+* @details Block floating point for the gains of the fixed-point engine: all gains of a frame share one
+* scale, chosen so the largest gain is below 2^30 with that many fractional bits.
+*/
+int gainFractionalBits(float peakGain)
+{
+    int exponent = 0;
+    frexpf(peakGain, &exponent); // peakGain < 2^exponent
+    const int bits = 30 - exponent;
+    return (bits < 0) ? 0 : (bits > 30) ? 30 : bits;
+}
@@ -0,0 +1,121 @@
+/**
+ * @file spectral_kernel.h
+ * @brief Header file for the complex-domain vocoding kernel
+ *
+ * @details This file contains the declarations of the vocoding kernel that scales the carrier's
+ * complex bins directly by a gain computed from the modulator magnitude.
+ * There is no phase extraction and no trigonometry, the gain curve is a precomputed lookup table.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+#ifndef SPECTRAL_KERNEL_H
+#define SPECTRAL_KERNEL_H
+
+// Headers
+#include <cstdint>
+#include <cstring>
+
+/*
+* @class GainCurve
+* @brief Lookup table approximation of powf(x, exponent) for x >= 0
+*
+* @details The float is split into exponent and mantissa, x^p = 2^(p*e) * m^p.
+* Both factors come from small tables (256 + 129 entries), the mantissa table is linearly interpolated.
+* The relative error is below 1e-4 for exponents between 0 and 1.
+*/
+class GainCurve
+{
+    public:
+        void begin(float exponent);
+        float exponent() const { return curveExponent; }
+
+        /*
+        * @brief Lookup function
+        *
+        * @param[in] x  The input value, must be >= 0
+        * @return Approximation of powf(x, exponent), 0 for zero and denormal input
+        */
+        inline float operator()(float x) const
+        {
+            uint32_t bits;
+            memcpy(&bits, &x, sizeof(bits));
+
+            const uint32_t index = (bits >> (23 - MANTISSA_BITS)) & ((1 << MANTISSA_BITS) - 1);
+            const float fraction = (bits & ((1 << (23 - MANTISSA_BITS)) - 1)) * (1.0f / (1 << (23 - MANTISSA_BITS)));
+            const float mantissa = mantissaTable[index] + fraction * (mantissaTable[index + 1] - mantissaTable[index]);
+
+            return exponentTable[(bits >> 23) & 0xFF] * mantissa;
+        }
+
+    private:
+        static const int MANTISSA_BITS = 7;
+
+        float curveExponent = 1.0f;
+        float exponentTable[256];
+        float mantissaTable[(1 << MANTISSA_BITS) + 1];
+};
+
+/*
+* @class NoiseGenerator
+* @brief xorshift32 pseudo random generator for the noise excitation
+*
+* @details Three shifts and three XORs per value, no multiplication and no table, so a value per bin costs
+* less than the bin itself. The sequence repeats after 2^32 - 1 values and is the same on every run.
+*/
+class NoiseGenerator
+{
+    public:
+        /*
+        * @brief Next function
+        *
+        * @return The next value, uniform over all 32-bit values except 0
+        */
+        inline uint32_t next()
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state;
+        }
+
+        /*
+        * @brief Uniform function
+        *
+        * @return A value uniform from -1 to 1
+        */
+        inline float uniform()
+        {
+            return (int32_t)next() * (1.0f / 2147483648.0f);
+        }
+
+        /*
+        * @brief Seed function
+        *
+        * @param[in] value  The new state, any value except 0
+        *
+        * @details Restarts the sequence, so a render from a reset vocoder always gets the same noise.
+        */
+        void seed(uint32_t value = DEFAULT_SEED) { state = value; }
+
+    private:
+        static const uint32_t DEFAULT_SEED = 0x2545F491;
+
+        uint32_t state = DEFAULT_SEED;
+};
+
+// Two uniform components times this have a mean power of 1: 2 * (1 / 3) * 1.5
+static const float NOISE_RMS_SCALE = 1.2247449f;
+
+// Function prototypes
+void computeMagnitude(float *spectrum, float *magnitude, int fftSize);
+void computeCurveGain(const float *modulatorMagnitude, float *gain, int bins, const GainCurve &curve, float scale);
+void addCarrierOffset(const float *carrierMagnitude, float *gain, int bins, float carrierOffset);
+void applySpectralGain(float *spectrum, float *gain, int fftSize);
+void applyNoiseExcitation(float *spectrum, const float *amplitude, int fftSize, NoiseGenerator &noise);
+void warpSpectrum(float *values, int bins, float ratio);
+int gainFractionalBits(float peakGain);
+
+#endif // SPECTRAL_KERNEL_H
@@ -0,0 +1,160 @@
+/**
+ * @file spectrum_snapshot.cpp
+ * @brief Spectrum snapshot of the visualizer
+ *
+ * @details This file contains the implementation of the band reduction and the request/ready handshake.
+ * The band edges are spaced logarithmically from `SPECTRUM_LOW_FREQ` to the Nyquist frequency,
+ * every band holds at least one bin, so at small FFT sizes the lowest bands are single bins.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+// Headers
+#include "spectrum_snapshot.h"
+#include <cmath>
+
+/*
+* @brief Set frame size function
+*
+* @param[in] fftSize    The FFT size
+* @param[in] sampleRate The sample rate in Hz
+*
+* @details Called by the DSP when the FFT size changes, between two frames.
+*/
+void SpectrumSnapshot::setFrameSize(int fftSize, float sampleRate)
+{
+    const int bins = fftSize / 2 + 1;
+    const float binWidth = sampleRate / fftSize;
+    const float ratio = (sampleRate / 2.0f) / SPECTRUM_LOW_FREQ;
+
+    this->fftSize = fftSize;
+    bandStart[0] = (int)(SPECTRUM_LOW_FREQ / binWidth + 0.5f);
+    for (int band = 1; band <= SPECTRUM_BANDS; band++)
+    {
+        int bin = (int)(SPECTRUM_LOW_FREQ * powf(ratio, (float)band / SPECTRUM_BANDS) / binWidth + 0.5f);
+        bin = (bin <= bandStart[band - 1]) ? bandStart[band - 1] + 1 : bin;
+        bandStart[band] = (bin > bins) ? bins : bin;
+    }
+
+    // Not enough bins above the first band edge: move the edges down, one bin per band
+    for (int band = SPECTRUM_BANDS - 1; band >= 0; band--)
+    {
+        if (bandStart[band] >= bandStart[band + 1])
+            bandStart[band] = bandStart[band + 1] - 1;
+    }
+}
+
+/*
+* @brief Begin capture function
+*
+* @return True when the display requested a snapshot of this frame
+*
+* @details Writer side, call at the start of every frame.
+*/
+bool SpectrumSnapshot::beginCapture()
+{
+    // A request can arrive just before the previous snapshot is set ready, it waits until that one is read
+    capturing = requested.load(std::memory_order_acquire) && !ready.load(std::memory_order_acquire);
+    return capturing;
+}
+
+/*
+* @brief Capture modulator function
+*
+* @param[in] magnitude  The modulator magnitude per bin
+*/
+void SpectrumSnapshot::captureModulator(const float *magnitude)
+{
+    if (capturing)
+        reducePeak(magnitude, snapshot.modulator, bandStart);
+}
+
+/*
+* @brief Capture carrier function
+*
+* @param[in] magnitude  The carrier magnitude per bin
+* @param[in] gain       The applied gain per bin, not used for unvoiced frames
+* @param[in] unvoiced   The voicing decision of the frame
+*/
+void SpectrumSnapshot::captureCarrier(const float *magnitude, const float *gain, bool unvoiced)
+{
+    if (!capturing)
+        return;
+
+    reducePeak(magnitude, snapshot.carrier, bandStart);
+    for (int band = 0; band < SPECTRUM_BANDS; band++)
+    {
+        float sum = 0.0f;
+        for (int bin = bandStart[band]; bin < bandStart[band + 1] && !unvoiced; bin++)
+        {
+            sum += fabsf(gain[bin]); // The voiced noise term can make the gain negative
+        }
+        snapshot.gain[band] = unvoiced ? 0.0f : sum / (bandStart[band + 1] - bandStart[band]);
+    }
+    snapshot.unvoiced = unvoiced;
+}
+
+/*
+* @brief Publish function
+*
+* @details Writer side, call at the end of the frame. Hands the snapshot to the reader when one was captured.
+*/
+void SpectrumSnapshot::publish()
+{
+    if (!capturing)
+        return;
+
+    snapshot.fftSize = fftSize;
+    capturing = false;
+    requested.store(false, std::memory_order_relaxed);
+    ready.store(true, std::memory_order_release);
+}
+
+/*
+* @brief Request function
+*
+* @details Reader side. Asks the DSP for a snapshot of its next frame, ignored while the last one is not read yet.
+*/
+void SpectrumSnapshot::request()
+{
+    if (!ready.load(std::memory_order_acquire))
+        requested.store(true, std::memory_order_release);
+}
+
+/*
+* @brief Read function
+*
+* @param[out] frame The snapshot
+* @return False when no new snapshot is ready
+*/
+bool SpectrumSnapshot::read(SpectrumFrame &frame)
+{
+    if (!ready.load(std::memory_order_acquire))
+        return false;
+
+    frame = snapshot;
+    ready.store(false, std::memory_order_release);
+    return true;
+}
+
+/*
+* @brief Reduce peak function
+*
+* @param[in] values     The values per bin
+* @param[out] bands     The largest value per band
+* @param[in] bandStart  The band edges
+*/
+void SpectrumSnapshot::reducePeak(const float *values, float *bands, const int *bandStart)
+{
+    for (int band = 0; band < SPECTRUM_BANDS; band++)
+    {
+        float peak = 0.0f;
+        for (int bin = bandStart[band]; bin < bandStart[band + 1]; bin++)
+        {
+            peak = (values[bin] > peak) ? values[bin] : peak;
+        }
+        bands[band] = peak;
+    }
+}
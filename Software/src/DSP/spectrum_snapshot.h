@@ -0,0 +1,75 @@
+/**
+ * @file spectrum_snapshot.h
+ * @brief Header file for the spectrum snapshot of the visualizer
+ *
+ * @details This file contains the declaration of the hand-over of spectra from the DSP to the display.
+ * The DSP reduces the carrier and modulator magnitudes and the applied gain of one frame to
+ * `SPECTRUM_BANDS` logarithmically spaced bands, only when the display asked for a new snapshot.
+ * So the snapshot is decimated to the refresh rate of the display and costs nothing while no screen shows it.
+ *
+ * The hand-over is a lock-free handshake between one writer (the DSP) and one reader (the display):
+ * the reader calls request() after it has copied the last snapshot, the writer fills the snapshot during the next
+ * frame and sets it ready. The writer only touches the snapshot between the request and ready, and the reader
+ * only in between ready and its next request, so neither side ever waits or sees a half written snapshot.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+#ifndef SPECTRUM_SNAPSHOT_H
+#define SPECTRUM_SNAPSHOT_H
+
+// Headers
+#include <atomic>
+#include <cstdint>
+
+// Defines
+static const int SPECTRUM_BANDS = 48;
+static const float SPECTRUM_LOW_FREQ = 50.0f; // Lower edge of the first band
+
+/*
+* @struct SpectrumFrame
+* @brief The band values of one frame
+*/
+struct SpectrumFrame
+{
+    float carrier[SPECTRUM_BANDS];      // Peak magnitude per band, carrier voice 0
+    float modulator[SPECTRUM_BANDS];    // Peak magnitude per band
+    float gain[SPECTRUM_BANDS];         // Mean absolute applied gain per band, zero for unvoiced frames
+    int fftSize;
+    bool unvoiced;
+};
+
+/*
+* @class SpectrumSnapshot
+* @brief Decimated, lock-free spectrum hand-over from the DSP to the display
+*
+* @details Writer side, once per frame: beginCapture(), and when it returns true captureModulator(),
+* captureCarrier() and publish(). Reader side: request() and later read().
+*/
+class SpectrumSnapshot
+{
+    public:
+        void setFrameSize(int fftSize, float sampleRate);
+
+        bool beginCapture();
+        void captureModulator(const float *magnitude);
+        void captureCarrier(const float *magnitude, const float *gain, bool unvoiced);
+        void publish();
+
+        void request();
+        bool read(SpectrumFrame &frame);
+
+    private:
+        static void reducePeak(const float *values, float *bands, const int *bandStart);
+
+        int bandStart[SPECTRUM_BANDS + 1] = {};    // First bin per band, the last entry is the end
+        int fftSize = 0;
+        bool capturing = false;
+        SpectrumFrame snapshot = {};
+        std::atomic<bool> requested{false};
+        std::atomic<bool> ready{false};
+};
+
+#endif // SPECTRUM_SNAPSHOT_H
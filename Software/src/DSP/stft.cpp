@@ -0,0 +1,208 @@
+/**
+ * @file stft.cpp
+ * @brief Streaming STFT engine
+ *
+ * @details This file contains the implementation of the streaming short-time Fourier transform engine.
+ * The analysis side slides a window over the input by `hopSize` samples per frame,
+ * the synthesis side overlap-adds the processed frames into a continuous output stream.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.02
+ */
+
+// Headers
+#include "stft.h"
+#include <cmath>
+#include <cstring>
+
+/*
+* @brief Fill window function
+*
+* @param[out] window    The window coefficients
+* @param[in] size       The window length
+* @param[in] type       The window shape
+*
+* @details This function computes a periodic window, which is what makes Hann (and the product of
+* two sqrt-Hann windows) sum to a constant at 50% and 75% overlap.
+* A periodic window of length N equals the length M window sampled every M / N coefficients.
+*/
+void fillWindow(float *window, int size, WindowType type)
+{
+    for (int i = 0; i < size; i++)
+    {
+        float hann = 0.5f - 0.5f * cosf(2.0f * (float)M_PI * i / size);
+
+        switch (type)
+        {
+            case WindowType::Rectangular: window[i] = 1.0f; break;
+            case WindowType::Hann:        window[i] = hann; break;
+            case WindowType::SqrtHann:    window[i] = sqrtf(hann); break;
+        }
+    }
+}
+
+/*
+* @brief Begin function
+*
+* @param[in] maxFrameSize       The largest analysis frame length (FFT size)
+* @param[in] type               The analysis window shape
+* @param[in] historyBuffer      Buffer of 2 * `maxFrameSize` samples for the sliding window
+* @param[in] masterWindowBuffer Buffer of `maxFrameSize` floats for the master window
+* @param[in] windowBuffer       Buffer of `maxFrameSize` floats for the active window
+*
+* @details Call setFrameSize() before the first pushHop().
+*/
+void StftAnalyzer::begin(int maxFrameSize, WindowType type, int16_t *historyBuffer, float *masterWindowBuffer, float *windowBuffer)
+{
+    this->maxFrameSize = maxFrameSize;
+    this->historyBuffer = historyBuffer;
+    this->masterWindowBuffer = masterWindowBuffer;
+    this->windowBuffer = windowBuffer;
+    this->writeIndex = 0;
+
+    memset(historyBuffer, 0, 2 * maxFrameSize * sizeof(int16_t));
+    fillWindow(masterWindowBuffer, maxFrameSize, type);
+}
+
+/*
+* @brief Set frame size function
+*
+* @param[in] frameSize  The analysis frame length, a power of two up to `maxFrameSize`
+* @param[in] hopSize    Number of new samples per frame
+*
+* @details The history is kept, so the next frame already holds valid input.
+*/
+void StftAnalyzer::setFrameSize(int frameSize, int hopSize)
+{
+    this->frameSize = frameSize;
+    this->hopSize = hopSize;
+
+    const int stride = maxFrameSize / frameSize;
+    for (int i = 0; i < frameSize; i++)
+    {
+        windowBuffer[i] = masterWindowBuffer[i * stride];
+    }
+}
+
+/*
+* @brief Reset function
+*
+* @details This function clears the history, the next frames fade in from silence.
+*/
+void StftAnalyzer::reset()
+{
+    memset(historyBuffer, 0, 2 * maxFrameSize * sizeof(int16_t));
+    writeIndex = 0;
+}
+
+/*
+* @brief Push hop function
+*
+* @param[in] hop    The `hopSize` newest input samples
+*
+* @details Each sample is written to both halves of the mirrored history.
+*/
+void StftAnalyzer::pushHop(const int16_t *hop)
+{
+    for (int i = 0; i < hopSize; i++)
+    {
+        historyBuffer[writeIndex] = hop[i];
+        historyBuffer[writeIndex + maxFrameSize] = hop[i];
+        if (++writeIndex >= maxFrameSize)
+            writeIndex = 0;
+    }
+}
+
+/*
+* @brief Begin function
+*
+* @param[in] maxFrameSize       The largest synthesis frame length (FFT size)
+* @param[in] analysis           The analysis window shape, needed for the gain normalization
+* @param[in] synthesis          The synthesis window shape
+* @param[in] accumulatorBuffer  Buffer of `maxFrameSize` floats for the overlap-add accumulator
+* @param[in] masterWindowBuffer Buffer of 2 * `maxFrameSize` floats for the analysis and synthesis master windows
+* @param[in] windowBuffer       Buffer of `maxFrameSize` floats for the active synthesis window
+*
+* @details Call setFrameSize() before the first addFrame().
+*/
+void OverlapAddSynthesizer::begin(int maxFrameSize, WindowType analysis, WindowType synthesis, float *accumulatorBuffer, float *masterWindowBuffer, float *windowBuffer)
+{
+    this->maxFrameSize = maxFrameSize;
+    this->accumulatorBuffer = accumulatorBuffer;
+    this->masterWindowBuffer = masterWindowBuffer;
+    this->windowBuffer = windowBuffer;
+
+    fillWindow(masterWindowBuffer, maxFrameSize, analysis);
+    fillWindow(masterWindowBuffer + maxFrameSize, maxFrameSize, synthesis);
+}
+
+/*
+* @brief Set frame size function
+*
+* @param[in] frameSize  The synthesis frame length, a power of two up to `maxFrameSize`
+* @param[in] hopSize    Number of output samples per frame
+*
+* @details The synthesis window is pre-scaled so that the sum of the analysis and synthesis window
+* products over all overlapping frames is one. The accumulator is cleared.
+*/
+void OverlapAddSynthesizer::setFrameSize(int frameSize, int hopSize)
+{
+    this->frameSize = frameSize;
+    this->hopSize = hopSize;
+
+    const int stride = maxFrameSize / frameSize;
+    const float *analysis = masterWindowBuffer;
+    const float *synthesis = masterWindowBuffer + maxFrameSize;
+
+    float overlapGain = 0.0f;
+    for (int i = 0; i < frameSize; i++)
+    {
+        overlapGain += analysis[i * stride] * synthesis[i * stride];
+    }
+    overlapGain /= hopSize; // Average sum of window products at one output sample
+
+    for (int i = 0; i < frameSize; i++)
+    {
+        windowBuffer[i] = synthesis[i * stride] / overlapGain;
+    }
+
+    memset(accumulatorBuffer, 0, maxFrameSize * sizeof(float));
+}
+
+/*
+* @brief Reset function
+*
+* @details This function clears the accumulator, the output then fades in.
+*/
+void OverlapAddSynthesizer::reset()
+{
+    memset(accumulatorBuffer, 0, maxFrameSize * sizeof(float));
+}
+
+/*
+* @brief Add frame function
+*
+* @param[in] frame  The processed time domain frame (output of the inverse FFT)
+*/
+void OverlapAddSynthesizer::addFrame(const float *frame)
+{
+    for (int i = 0; i < frameSize; i++)
+    {
+        accumulatorBuffer[i] += frame[i] * windowBuffer[i];
+    }
+}
+
+/*
+* @brief Read hop function
+*
+* @param[out] hop   The `hopSize` finished output samples
+*
+* @details This function copies the finished samples out and shifts the accumulator by `hopSize`.
+*/
+void OverlapAddSynthesizer::readHop(float *hop)
+{
+    memcpy(hop, accumulatorBuffer, hopSize * sizeof(float));
+    memmove(accumulatorBuffer, accumulatorBuffer + hopSize, (frameSize - hopSize) * sizeof(float));
+    memset(accumulatorBuffer + frameSize - hopSize, 0, hopSize * sizeof(float));
+}
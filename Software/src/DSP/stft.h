@@ -0,0 +1,95 @@
+/**
+ * @file stft.h
+ * @brief Header file for the streaming STFT engine
+ *
+ * @details This file contains the declarations of the streaming short-time Fourier transform engine.
+ * The StftAnalyzer keeps a sliding window over the input and produces a windowed frame every hop,
+ * the OverlapAddSynthesizer windows the processed frames and overlap-adds them into a continuous output.
+ * Together they give glitch-free audio at a fixed latency of one frame plus one hop.
+ *
+ * The frame size can be changed between frames with setFrameSize(). The buffers are sized for the
+ * largest frame, and the windows for smaller frames are subsampled from one master window,
+ * so a change needs no allocation and no trigonometry.
+ *
+ * @note The classes do not allocate memory, all buffers are provided by the caller in begin().
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.02
+ */
+
+#ifndef STFT_H
+#define STFT_H
+
+// Headers
+#include <cstdint>
+
+enum class WindowType
+{
+    Rectangular,
+    Hann,
+    SqrtHann
+};
+
+// Function prototypes
+void fillWindow(float *window, int size, WindowType type);
+
+/*
+* @class StftAnalyzer
+* @brief Sliding analysis window over a stream of samples
+*
+* @details The history is a mirrored ring buffer of `maxFrameSize` samples: every sample is stored twice,
+* `maxFrameSize` apart, so the most recent `frameSize` samples are always contiguous in memory.
+* Because the history always covers the largest frame, a frame size change is valid immediately.
+*/
+class StftAnalyzer
+{
+    public:
+        void begin(int maxFrameSize, WindowType type, int16_t *historyBuffer, float *masterWindowBuffer, float *windowBuffer);
+        void setFrameSize(int frameSize, int hopSize);
+        void reset();
+        void pushHop(const int16_t *hop);
+
+        const int16_t* history() const { return historyBuffer + writeIndex + maxFrameSize - frameSize; }
+        const float* window() const { return windowBuffer; }
+
+    private:
+        int maxFrameSize = 0;
+        int frameSize = 0;
+        int hopSize = 0;
+        int writeIndex = 0;
+        int16_t *historyBuffer = nullptr;   // 2 * maxFrameSize samples
+        float *masterWindowBuffer = nullptr; // maxFrameSize coefficients
+        float *windowBuffer = nullptr;       // frameSize coefficients
+};
+
+/*
+* @class OverlapAddSynthesizer
+* @brief Overlap-add output accumulator
+*
+* @details Every call to addFrame() applies the synthesis window and adds the frame to the accumulator,
+* readHop() then returns the `hopSize` samples that no later frame contributes to.
+* The accumulator is normalized so that the analysis and synthesis windows together sum to unity gain.
+* After a frame size change the accumulator starts empty, the overlap-add then fades the output in.
+*/
+class OverlapAddSynthesizer
+{
+    public:
+        void begin(int maxFrameSize, WindowType analysis, WindowType synthesis, float *accumulatorBuffer, float *masterWindowBuffer, float *windowBuffer);
+        void setFrameSize(int frameSize, int hopSize);
+        void reset();
+        void addFrame(const float *frame);
+        void readHop(float *hop);
+
+        int latency() const { return frameSize + hopSize; }
+
+    private:
+        int maxFrameSize = 0;
+        int frameSize = 0;
+        int hopSize = 0;
+        float *accumulatorBuffer = nullptr;  // maxFrameSize samples
+        float *masterWindowBuffer = nullptr; // 2 * maxFrameSize coefficients: analysis and synthesis
+        float *windowBuffer = nullptr;       // frameSize coefficients
+};
+
+#endif // STFT_H
@@ -11,6 +11,7 @@
 
  // Headers
 #include "utils.h"
+#include <cmath>
 #include <random>
 
 /*
@@ -18,16 +19,17 @@
 *
 * @param[in] inputBuffer    The input audio data buffer in int16_t format
 * @param[out] outputBuffer  The output audio data buffer in float format
+* @param[in] window         The analysis window, or nullptr for a rectangular window
 *
-* @details This function converts the audio data from int16_t to float.
-* The real part is the audio data and the imaginary part is set to 0.
+* @details This function converts the audio data from int16_t to float and applies the analysis window.
+* The output is a real frame of fftSize floats for the real FFT.
 */
-void convertInt16ToFloat(int16_t *inputBuffer, float *outputBuffer)
+void convertInt16ToFloat(const int16_t *inputBuffer, float *outputBuffer, const float *window)
 {
-    for (int i = 0; i < FFT_SIZE; i++)
+    for (int i = 0; i < fftSize; i++)
     {
-        outputBuffer[2 * i] = (float)inputBuffer[i]; // Real part
-        outputBuffer[2 * i + 1] = 0.0f; // Imaginary part
+        float gain = window ? window[i] : 1.0f;
+        outputBuffer[i] = (float)inputBuffer[i] * gain;
     }
 }
 
@@ -36,14 +38,54 @@ void convertInt16ToFloat(int16_t *inputBuffer, float *outputBuffer)
 *
 * @param[in] inputBuffer    The input audio data buffer in float format
 * @param[out] outputBuffer  The output audio data buffer in int16_t format
+* @param[in] size           The number of samples to convert
 *
 * @details This function converts the audio data from float to int16_t.
-* The audio data is scaled down by dividing by the FFT size.
+* The audio data is scaled down by a factor 4 to leave headroom for the vocoded signal, rounded toward zero and
+* saturated to the int16_t range, so a hot voice clips instead of wrapping.
 */
-void convertFloatToInt16(float *inputBuffer, int16_t *outputBuffer)
+void convertFloatToInt16(const float *inputBuffer, int16_t *outputBuffer, int size)
 {
-    for (int i = 0; i < FFT_SIZE; i++)
+    for (int i = 0; i < size; i++)
     {
-        outputBuffer[i] = (int16_t)(inputBuffer[2 * i] / 4);
+        float sample = inputBuffer[i] / 4;
+        sample = (sample > 32767.0f) ? 32767.0f : (sample < -32768.0f) ? -32768.0f : sample;
+        outputBuffer[i] = (int16_t)sample;
+    }
+}
+
+/*
+* @brief Convert hop to float function
+*
+* @param[in] inputBuffer    The input samples in int16_t format
+* @param[out] outputBuffer  The output samples in float format
+* @param[in] size           The number of samples to convert
+*
+* @details This function converts samples without scaling or windowing, for block filters.
+*/
+void convertHopToFloat(const int16_t *inputBuffer, float *outputBuffer, int size)
+{
+    for (int i = 0; i < size; i++)
+    {
+        outputBuffer[i] = (float)inputBuffer[i];
+    }
+}
+
+/*
+* @brief Convert hop to int16_t function
+*
+* @param[in] inputBuffer    The input samples in float format
+* @param[out] outputBuffer  The output samples in int16_t format
+* @param[in] size           The number of samples to convert
+*
+* @details This function rounds to the nearest integer and saturates to the int16_t range, without scaling.
+*/
+void convertHopToInt16(const float *inputBuffer, int16_t *outputBuffer, int size)
+{
+    for (int i = 0; i < size; i++)
+    {
+        float sample = inputBuffer[i];
+        sample = (sample > 32767.0f) ? 32767.0f : (sample < -32768.0f) ? -32768.0f : sample;
+        outputBuffer[i] = (int16_t)lrintf(sample);
     }
 }
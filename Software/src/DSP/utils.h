@@ -9,12 +9,19 @@
  * @version 0.01
  */
 
+#ifndef UTILS_H
+#define UTILS_H
+
 // Headers
 #include <cstdint>
 
 // Function prototypes
-void convertInt16ToFloat(int16_t *inputBuffer, float *outputBuffer);
-void convertFloatToInt16(float *inputBuffer, int16_t *outputBuffer);
+void convertInt16ToFloat(const int16_t *inputBuffer, float *outputBuffer, const float *window);
+void convertFloatToInt16(const float *inputBuffer, int16_t *outputBuffer, int size);
+void convertHopToFloat(const int16_t *inputBuffer, float *outputBuffer, int size);
+void convertHopToInt16(const float *inputBuffer, int16_t *outputBuffer, int size);
 
 // External variables
-extern const int FFT_SIZE;
\ No newline at end of file
+extern int fftSize;
+
+#endif // UTILS_H
@@ -0,0 +1,636 @@
+/**
+ * @file vocoder.cpp
+ * @brief Vocoder processing chain
+ *
+ * @details This file contains the vocoder buffers and the processing chain that turns
+ * one hop of carrier and modulator samples into one hop of stereo output samples.
+ * The FFT runs on overlapping frames of `fftSize` samples (see stft.h), so the output
+ * is continuous with a fixed latency of one frame plus one hop.
+ * It is called from the frame interrupt on the Teensy and from the native render tool on a PC,
+ * so both run the exact same code.
+ *
+ * The filter-bank engine (see filterbank_vocoder.h) is the low-latency alternative and the fixed-point engine
+ * (see fixed_point_vocoder.h) runs the same FFT chain in Q15/Q31, the active engine can be switched at runtime
+ * with setVocoderEngine(). Both FFT engines share the STFT history and the modulator high-pass.
+ *
+ * The FFT engines vocode up to `MAX_CARRIER_VOICES` carrier voices (see voice_pool.h) against one modulator:
+ * the modulator FFT, voicing decision and envelope are computed once per frame and reused by every voice,
+ * only the carrier FFT, the gain and the inverse FFT run per voice. The voices are panned into the stereo output.
+ *
+ * @note The FFT size can be changed at runtime with frameSizeManager.requestSize(), the startup
+ * size is `DEFAULT_FFT_SIZE` (see frame_size_manager.h). Supported sizes include 128, 256, 512, 1024, 2048, and 4096.
+ * All buffers are sized for `MAX_FFT_SIZE`. The overlap is set by `OVERLAP_FACTOR`.
+ *
+ * The frame buffers are assigned from two static arenas (see dsp_arena.h). The fast arena in DTCM holds the
+ * per-frame working set, which does not grow with the number of voices: the active windows, the modulator
+ * history and the FFT scratch buffers. The scratch buffers of the two FFT engines overlap, and within an engine
+ * the modulator analysis buffers overlap the carrier buffers, because the modulator is analyzed before the voices.
+ * The slow arena in OCRAM holds the per-voice state and the master windows that are only read on a size change.
+ *
+ * The tunable parameters (see parameters.h) are taken over at the start of every frame. The gain curve and the
+ * high-pass are only redesigned while their smoothed value moves.
+ *
+ * The float engine can shift the pitch of every carrier voice (see phase_vocoder.h) and the formants of the modulator
+ * (see warpSpectrum()). Both are bypassed at 0 semitones, the fixed-point engine does not shift.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+// Headers
+#include "vocoder.h"
+#include "utils.h"
+#include "fft_utils.h"
+#include "stft.h"
+#include "profiler.h"
+#include "biquad_filter.h"
+#include "fixed_point_vocoder.h"
+#include "voice_pool.h"
+#include "dsp_arena.h"
+#include "spectrum_snapshot.h"
+#include "parameters.h"
+#include "phase_vocoder.h"
+#include "HAL/cycle_counter.h"
+#include <atomic>
+
+// Variables
+const WindowType ANALYSIS_WINDOW = WindowType::SqrtHann;
+const WindowType SYNTHESIS_WINDOW = WindowType::SqrtHann;
+
+int fftSize;
+int hopSize;
+arm_rfft_fast_instance_f32* fftConfig;
+FrameSizeManager frameSizeManager;
+
+int16_t carrierBuffers[MAX_CARRIER_VOICES][MAX_HOP_SIZE];
+int16_t modulatorBuffer[MAX_HOP_SIZE];
+int16_t outputLeftBuffer[MAX_HOP_SIZE];
+int16_t outputRightBuffer[MAX_HOP_SIZE];
+
+// Memory arenas, sized for the allocations in allocateBuffers(). The memory report shows the required size.
+static const size_t FRAME_BYTES = MAX_FFT_SIZE * sizeof(float);
+static const size_t BIN_BYTES = (MAX_FFT_SIZE / 2 + 1) * sizeof(float) + DSP_ARENA_ALIGNMENT; // Including the alignment padding
+static const size_t FAST_ARENA_SIZE = 13 * FRAME_BYTES / 2 + 7 * BIN_BYTES;
+static const size_t SLOW_ARENA_SIZE = 3 * FRAME_BYTES + MAX_CARRIER_VOICES * (3 * FRAME_BYTES + 2 * BIN_BYTES);
+static uint8_t fastArenaRegion[FAST_ARENA_SIZE] HAL_FAST_MEMORY __attribute__((aligned(DSP_ARENA_ALIGNMENT)));
+static uint8_t slowArenaRegion[SLOW_ARENA_SIZE] HAL_SLOW_MEMORY __attribute__((aligned(DSP_ARENA_ALIGNMENT)));
+DspArena fastArena;
+DspArena slowArena;
+
+// Spectrum visualizer feed, the smoothed frame load and the smoothed ratio of skipped frames
+SpectrumSnapshot spectrumSnapshot;
+static float frameLoad = 0.0f;
+static float skipRatio = 0.0f;
+static const float FRAME_LOAD_SMOOTHING = 0.1f;
+
+// Carrier voices: one STFT history and one overlap-add accumulator per voice
+CarrierVoicePool carrierVoices;
+static std::atomic<int> pendingVoices{0}; // Requested voice count, 0 when nothing is pending
+int16_t *carrierHistories;      // MAX_CARRIER_VOICES * 2 * MAX_FFT_SIZE
+float *outputAccumulators;      // MAX_CARRIER_VOICES * MAX_FFT_SIZE
+int32_t leftMixBuffer[MAX_HOP_SIZE];
+int32_t rightMixBuffer[MAX_HOP_SIZE];
+int16_t voiceOutputBuffer[MAX_HOP_SIZE];
+
+int16_t *modulatorHistory;      // 2 * MAX_FFT_SIZE
+float *analysisMasterWindow;    // MAX_FFT_SIZE
+float *analysisWindow;          // MAX_FFT_SIZE, shared by the carrier and modulator analyzers
+float *synthesisMasterWindows;  // 2 * MAX_FFT_SIZE
+float *synthesisWindow;         // MAX_FFT_SIZE
+float outputHopBuffer[MAX_HOP_SIZE];
+
+const int FILTERBANK_BANDS = 24;
+const int MODULATOR_HIGHPASS_ORDER = 2;
+BiquadFilter modulatorHighpass; // Removes DC and rumble from the modulator, the cutoff is a parameter
+float modulatorHopFloat[MAX_HOP_SIZE];
+
+const EnvelopeMethod ENVELOPE_METHOD = EnvelopeMethod::Cepstral;
+const int ENVELOPE_BANDS = 32;
+const int ENVELOPE_ORDER = 12; // Cepstral coefficients or LPC order
+SpectralEnvelope modulatorEnvelope;
+VoicingDetector voicingDetector;
+NoiseGate noiseGate;
+
+const float FILTERBANK_LOW_FREQ = 100.0f;
+const float FILTERBANK_HIGH_FREQ = 8000.0f;
+const float SAMPLE_RATE = 44100.0f;
+
+ParameterRegistry vocoderParameters;
+
+volatile VocoderEngine activeEngine = VocoderEngine::FFT;
+static std::atomic<bool> pendingReset{false}; // An FFT engine was selected, its state restarts before the next hop
+FilterBankVocoder filterBankVocoder;
+
+StftAnalyzer modulatorAnalyzer;
+
+// Real FFT: MAX_FFT_SIZE floats per frame or packed spectrum, MAX_FFT_SIZE / 2 + 1 unique bins
+float *fftBuffer;
+float *carrierFloatBuffer;
+float *modulatorFloatBuffer;
+float *modulatorFFT;
+float *modulatorMagnitude;
+float *carrierMagnitude;
+float *modulatorGain; // Shared by all carrier voices
+float *spectralGain;
+
+// Pitch shifter: the phases of the previous frame per voice, the phase advance table and the per-frame scratch
+PhaseVocoder carrierShifter;
+float *carrierPhases;           // MAX_CARRIER_VOICES * 2 * (MAX_FFT_SIZE / 2 + 1)
+float *phaseAdvance;
+float *analysisPhase;
+float *synthesisPhase;
+int16_t *spectralPeaks;
+
+// Fixed-point engine: Q31 spectra, accumulator and analysis window, Q15 synthesis window
+FixedPointVocoder fixedPointVocoder;
+q31_t *fixedCarrierSpectrum;
+q31_t *fixedModulatorSpectrum;
+q31_t *fixedCarrierMagnitude;
+q31_t *fixedModulatorMagnitude;
+q31_t *fixedAccumulator;        // MAX_CARRIER_VOICES * MAX_FFT_SIZE
+q31_t *fixedAnalysisWindow;
+q15_t *fixedSynthesisWindow;
+
+/*
+* @brief Allocate buffers function
+*
+* @return True when both arenas are large enough
+*
+* @details This function assigns all frame buffers from the arenas. The overlays follow the order of
+* processVocoderFrame(): only one FFT engine runs per frame, and every buffer of the modulator analysis is dead
+* once the modulator gain has been computed, before the first carrier voice is processed.
+*/
+static bool allocateBuffers()
+{
+    const int bins = MAX_FFT_SIZE / 2 + 1;
+
+    fastArena.begin("fast", fastArenaRegion, sizeof(fastArenaRegion));
+    analysisWindow = fastArena.allocate<float>("analysisWindow", MAX_FFT_SIZE);
+    synthesisWindow = fastArena.allocate<float>("synthesisWindow", MAX_FFT_SIZE);
+    fixedAnalysisWindow = fastArena.allocate<q31_t>("fixedAnalysisWindow", MAX_FFT_SIZE);
+    fixedSynthesisWindow = fastArena.allocate<q15_t>("fixedSynthesisWindow", MAX_FFT_SIZE);
+    modulatorHistory = fastArena.allocate<int16_t>("modulatorHistory", 2 * MAX_FFT_SIZE);
+    phaseAdvance = fastArena.allocate<float>("phaseAdvance", bins);
+
+    fastArena.beginOverlay();
+    fastArena.beginStage("fft");
+    modulatorGain = fastArena.allocate<float>("modulatorGain", bins);
+    fastArena.beginOverlay();
+    fastArena.beginStage("modulator");
+    modulatorFloatBuffer = fastArena.allocate<float>("modulatorFloatBuffer", MAX_FFT_SIZE);
+    modulatorFFT = fastArena.allocate<float>("modulatorFFT", MAX_FFT_SIZE);
+    modulatorMagnitude = fastArena.allocate<float>("modulatorMagnitude", bins);
+    fastArena.beginStage("carrier");
+    carrierFloatBuffer = fastArena.allocate<float>("carrierFloatBuffer", MAX_FFT_SIZE);
+    fftBuffer = fastArena.allocate<float>("fftBuffer", MAX_FFT_SIZE);
+    carrierMagnitude = fastArena.allocate<float>("carrierMagnitude", bins);
+    spectralGain = fastArena.allocate<float>("spectralGain", bins);
+    analysisPhase = fastArena.allocate<float>("analysisPhase", bins);
+    synthesisPhase = fastArena.allocate<float>("synthesisPhase", bins);
+    spectralPeaks = fastArena.allocate<int16_t>("spectralPeaks", MAX_FFT_SIZE / 4 + 1);
+    fastArena.endOverlay();
+
+    fastArena.beginStage("fixed");
+    fixedModulatorMagnitude = fastArena.allocate<q31_t>("fixedModulatorMagnitude", bins); // Then the modulator gain
+    fastArena.beginOverlay();
+    fastArena.beginStage("modulator");
+    fixedModulatorSpectrum = fastArena.allocate<q31_t>("fixedModulatorSpectrum", MAX_FFT_SIZE);
+    fastArena.beginStage("carrier");
+    fixedCarrierSpectrum = fastArena.allocate<q31_t>("fixedCarrierSpectrum", MAX_FFT_SIZE);
+    fixedCarrierMagnitude = fastArena.allocate<q31_t>("fixedCarrierMagnitude", bins);
+    fastArena.endOverlay();
+    fastArena.endOverlay();
+
+    slowArena.begin("slow", slowArenaRegion, sizeof(slowArenaRegion));
+    analysisMasterWindow = slowArena.allocate<float>("analysisMasterWindow", MAX_FFT_SIZE);
+    synthesisMasterWindows = slowArena.allocate<float>("synthesisMasterWindows", 2 * MAX_FFT_SIZE);
+    carrierHistories = slowArena.allocate<int16_t>("carrierHistories", MAX_CARRIER_VOICES * 2 * MAX_FFT_SIZE);
+    outputAccumulators = slowArena.allocate<float>("outputAccumulators", MAX_CARRIER_VOICES * MAX_FFT_SIZE);
+    fixedAccumulator = slowArena.allocate<q31_t>("fixedAccumulator", MAX_CARRIER_VOICES * MAX_FFT_SIZE);
+    carrierPhases = slowArena.allocate<float>("carrierPhases", MAX_CARRIER_VOICES * 2 * bins);
+
+    return fastArena.fits() && slowArena.fits();
+}
+
+/*
+* @brief Configure frame size function
+*
+* @param[in] size   The new FFT size
+*
+* @details This function switches the FFT instance and the STFT windows to a new size.
+* It only uses preplanned tables and preallocated buffers.
+*/
+static void configureFrameSize(int size)
+{
+    fftSize = size;
+    hopSize = size / OVERLAP_FACTOR;
+    fftConfig = getFFTConfig(size);
+
+    carrierVoices.setFrameSize(fftSize, hopSize);
+    modulatorAnalyzer.setFrameSize(fftSize, hopSize);
+    modulatorEnvelope.setFrameSize(fftSize);
+    voicingDetector.setFrameSize(fftSize, hopSize);
+    noiseGate.setFrameSize(fftSize, hopSize);
+    carrierShifter.setFrameSize(fftSize, hopSize);
+    fixedPointVocoder.setFrameSize(fftSize, hopSize, analysisWindow, synthesisWindow);
+    spectrumSnapshot.setFrameSize(fftSize, SAMPLE_RATE);
+}
+
+/*
+* @brief Apply parameters function
+*
+* @param[in] changed    The mask of the parameters that changed, see paramBit()
+*
+* @details This function hands the smoothed parameter values to the processing chain, between two frames.
+*/
+static void applyParameters(uint32_t changed)
+{
+    if (changed & paramBit(ParamId::HighpassCutoff))
+        modulatorHighpass.setCutoff(vocoderParameters.value(ParamId::HighpassCutoff), SAMPLE_RATE);
+    if (changed & paramBit(ParamId::GainExponent))
+        setGainExponent(vocoderParameters.value(ParamId::GainExponent));
+
+    unvoicedNoiseStrength = vocoderParameters.value(ParamId::UnvoicedNoise);
+    voicedNoiseStrength = vocoderParameters.value(ParamId::VoicedNoise);
+    voicingDetector.setRatioThreshold(vocoderParameters.value(ParamId::UnvoicedRatio));
+    noiseGate.setThreshold(vocoderParameters.value(ParamId::GateThreshold));
+
+    if (changed & paramBit(ParamId::PitchShift))
+        carrierShifter.setPitchRatio(exp2f(vocoderParameters.value(ParamId::PitchShift) / 12.0f));
+    if (changed & paramBit(ParamId::FormantShift))
+        formantShiftRatio = exp2f(vocoderParameters.value(ParamId::FormantShift) / 12.0f);
+}
+
+/*
+* @brief Reset frame state function
+*
+* @details Restarts both FFT engines from silence: the voice and modulator histories, the accumulators, the high-pass,
+* the voicing detector, the noise gate, the pitch shifter and the excitation noise, so the engine continues like
+* after initVocoder(). The capture stops while the filter bank is selected, so without this the first frames after
+* a switch would replay the audio from before it.
+*/
+static void resetFrameState()
+{
+    carrierVoices.reset();
+    modulatorAnalyzer.reset();
+    modulatorHighpass.reset();
+    voicingDetector.reset();
+    noiseGate.reset();
+    carrierShifter.reset();
+    fixedPointVocoder.reset();
+    resetExcitationNoise();
+}
+
+/*
+* @brief Initialize vocoder function
+*
+* @param[in] initialFftSize  The FFT size to start with, `DEFAULT_FFT_SIZE` by default
+* @return True when the FFT configurations are available, the size is supported and the buffers fit in the arenas
+*
+* @details This function assigns the buffers, plans the FFT configurations for every supported size,
+* sets up the streaming analysis and synthesis windows for the initial size and designs the filter bank.
+* One centered carrier voice is active, the parameters start at their targets, the defaults unless they were set before.
+* Calling it again restarts the chain from silence and the same noise sequence, so a render is repeatable.
+*/
+bool initVocoder(int initialFftSize)
+{
+    if (!allocateBuffers() || !frameSizeManager.begin(initialFftSize))
+        return false;
+
+    vocoderParameters.settle();
+    if (!modulatorHighpass.begin(FilterType::Highpass, MODULATOR_HIGHPASS_ORDER,
+                                 vocoderParameters.value(ParamId::HighpassCutoff), SAMPLE_RATE))
+        return false;
+    voicingDetector.begin(SAMPLE_RATE);
+    noiseGate.begin(SAMPLE_RATE);
+    resetExcitationNoise();
+    carrierShifter.begin(MAX_FFT_SIZE, carrierPhases, phaseAdvance, analysisPhase, synthesisPhase, spectralPeaks);
+    applyParameters(~0u);
+    if (!modulatorEnvelope.begin(ENVELOPE_BANDS, ENVELOPE_METHOD, ENVELOPE_ORDER, SAMPLE_RATE))
+        return false;
+
+    carrierVoices.begin(MAX_FFT_SIZE, MAX_HOP_SIZE, ANALYSIS_WINDOW, SYNTHESIS_WINDOW, &carrierBuffers[0][0], carrierHistories,
+                        outputAccumulators, analysisMasterWindow, analysisWindow, synthesisMasterWindows, synthesisWindow,
+                        leftMixBuffer, rightMixBuffer);
+    modulatorAnalyzer.begin(MAX_FFT_SIZE, ANALYSIS_WINDOW, modulatorHistory, analysisMasterWindow, analysisWindow);
+    fixedPointVocoder.begin(MAX_FFT_SIZE, MAX_CARRIER_VOICES, fixedCarrierSpectrum, fixedModulatorSpectrum, fixedCarrierMagnitude,
+                            fixedModulatorMagnitude, fixedAccumulator, fixedAnalysisWindow, fixedSynthesisWindow);
+    configureFrameSize(frameSizeManager.size());
+
+    return filterBankVocoder.begin(FILTERBANK_BANDS, FILTERBANK_LOW_FREQ, FILTERBANK_HIGH_FREQ, SAMPLE_RATE);
+}
+
+/*
+* @brief Process vocoder frame function
+*
+* @details This function runs one hop through the processing chain.
+* The new samples are read from `carrierBuffers` (one row per active voice) and `modulatorBuffer`, `hopSize` samples each,
+* they are shifted into the analysis windows and the full `fftSize` frames are vocoded.
+* The modulator is analyzed once, then every voice is vocoded, overlap-added and mixed into the stereo output.
+* The finished `hopSize` output samples are written to `outputLeftBuffer` and `outputRightBuffer`.
+*
+* The parameters written since the last frame are taken over first.
+*
+* When the display requested a spectrum snapshot, the float engine captures the modulator and carrier voice 0.
+*
+* When a new FFT size has been requested, this hop is faded out and the new size is applied afterwards,
+* so the caller must read `hopSize` before calling this function. The overlap-add of the new size starts
+* from an empty accumulator, which fades the output back in without a click.
+*
+* While the noise gate is closed and its fade-out is done, the engine is skipped: the analysis windows are updated
+* and the output is silent. When the gate opens the voices restart from an empty accumulator and fade in.
+*/
+void processVocoderFrame()
+{
+    const uint32_t frameStart = halCycleCount();
+    PROFILE_BEGIN(frameTimer);
+    PROFILE_BEGIN(stageTimer);
+
+    applyParameters(vocoderParameters.update(hopSize / SAMPLE_RATE));
+    convertHopToFloat(modulatorBuffer, modulatorHopFloat, hopSize);
+    modulatorHighpass.process(modulatorHopFloat, hopSize);
+    voicingDetector.analyzeHop(modulatorHopFloat);
+    noiseGate.update(modulatorHopFloat);
+    convertHopToInt16(modulatorHopFloat, modulatorBuffer, hopSize);
+    PROFILE_LAP(stageTimer, ProfileStage::Highpass);
+
+    const int voices = carrierVoices.voiceCount();
+    for (int v = 0; v < voices; v++)
+    {
+        CarrierVoice &voice = carrierVoices.voice(v);
+        voice.analyzer.pushHop(voice.input);
+    }
+    modulatorAnalyzer.pushHop(modulatorBuffer);
+    const bool resize = frameSizeManager.hasPendingChange();
+    const int hop = hopSize; // For the load, a resize changes hopSize at the end of the frame
+    carrierVoices.clearMix();
+
+    const bool skip = noiseGate.skip();
+    if (noiseGate.resuming())
+    {
+        for (int v = 0; v < voices; v++)
+        {
+            carrierVoices.voice(v).synthesizer.reset();
+            fixedPointVocoder.resetVoice(v);
+            carrierShifter.resetVoice(v);
+        }
+    }
+
+    if (skip)
+    {
+        // The gate is closed, the output is silent anyway
+    }
+    else if (activeEngine == VocoderEngine::FixedPoint)
+    {
+        // The analysis window is applied by the fixed-point analysis
+        fixedPointVocoder.analyzeModulator(modulatorAnalyzer.history());
+        PROFILE_LAP(stageTimer, ProfileStage::ModulatorFFT);
+
+        for (int v = 0; v < voices; v++)
+        {
+            fixedPointVocoder.analyzeCarrier(carrierVoices.voice(v).analyzer.history());
+            PROFILE_LAP(stageTimer, ProfileStage::CarrierFFT);
+            fixedPointVocoder.synthesize();
+            PROFILE_LAP(stageTimer, ProfileStage::InverseFFT);
+            fixedPointVocoder.readHop(voiceOutputBuffer, resize, v);
+            carrierVoices.mixVoice(v, voiceOutputBuffer);
+            PROFILE_LAP(stageTimer, ProfileStage::OverlapAdd);
+        }
+    }
+    else
+    {
+        // The modulator gain is computed once and shared by all voices
+        spectrumSnapshot.beginCapture();
+        convertInt16ToFloat(modulatorAnalyzer.history(), modulatorFloatBuffer, modulatorAnalyzer.window());
+        PROFILE_LAP(stageTimer, ProfileStage::Window);
+        processFFT(modulatorFloatBuffer, modulatorFFT, modulatorMagnitude);
+        spectrumSnapshot.captureModulator(modulatorMagnitude); // Before the carrier buffers overwrite it
+        const bool unvoiced = computeModulatorGain(modulatorMagnitude, modulatorGain);
+        PROFILE_LAP(stageTimer, ProfileStage::ModulatorFFT);
+
+        for (int v = 0; v < voices; v++)
+        {
+            CarrierVoice &voice = carrierVoices.voice(v);
+
+            // Convert int16_t to float and apply the analysis window
+            convertInt16ToFloat(voice.analyzer.history(), carrierFloatBuffer, voice.analyzer.window());
+            PROFILE_LAP(stageTimer, ProfileStage::Window);
+            processFFT(carrierFloatBuffer, fftBuffer, carrierMagnitude);
+            PROFILE_LAP(stageTimer, ProfileStage::CarrierFFT);
+
+            // The carrier frame is no longer needed, it receives the shifted spectrum or the output frame
+            float *spectrum = fftBuffer;
+            float *frame = carrierFloatBuffer;
+            if (carrierShifter.active())
+            {
+                carrierShifter.shift(v, fftBuffer, carrierMagnitude, carrierFloatBuffer);
+                computeMagnitude(carrierFloatBuffer, carrierMagnitude, fftSize);
+                spectrum = carrierFloatBuffer;
+                frame = fftBuffer;
+                PROFILE_LAP(stageTimer, ProfileStage::PitchShift);
+            }
+
+            // The carrier spectrum is vocoded in place
+            vocodeCarrier(spectrum, frame, carrierMagnitude, modulatorGain, unvoiced, spectralGain);
+            if (v == 0)
+                spectrumSnapshot.captureCarrier(carrierMagnitude, spectralGain, unvoiced);
+            PROFILE_LAP(stageTimer, ProfileStage::InverseFFT);
+
+            voice.synthesizer.addFrame(frame);
+            voice.synthesizer.readHop(outputHopBuffer);
+            PROFILE_LAP(stageTimer, ProfileStage::OverlapAdd);
+
+            if (resize)
+            {
+                for (int i = 0; i < hopSize; i++)
+                {
+                    outputHopBuffer[i] *= 1.0f - (float)(i + 1) / hopSize;
+                }
+            }
+
+            convertFloatToInt16(outputHopBuffer, voiceOutputBuffer, hopSize);
+            carrierVoices.mixVoice(v, voiceOutputBuffer);
+            PROFILE_LAP(stageTimer, ProfileStage::Output);
+        }
+    }
+
+    carrierVoices.readMix(outputLeftBuffer, outputRightBuffer);
+    noiseGate.apply(outputLeftBuffer, outputRightBuffer);
+    spectrumSnapshot.publish();
+
+    if (resize)
+        configureFrameSize(frameSizeManager.applyPendingChange());
+
+    PROFILE_LAP(frameTimer, ProfileStage::Frame);
+
+    const float load = (float)(halCycleCount() - frameStart) * SAMPLE_RATE / ((float)halCyclesPerSecond() * hop);
+    frameLoad += FRAME_LOAD_SMOOTHING * (load - frameLoad);
+    skipRatio += FRAME_LOAD_SMOOTHING * ((skip ? 1.0f : 0.0f) - skipRatio);
+}
+
+/*
+* @brief Vocoder latency function
+*
+* @return The input to output latency in samples
+*
+* @details One frame for the analysis window plus one hop for the output buffering.
+*/
+int vocoderLatency()
+{
+    return carrierVoices.voice(0).synthesizer.latency();
+}
+
+/*
+* @brief Vocoder load function
+*
+* @return The smoothed fraction of the hop period spent in processVocoderFrame(), 1 is the real-time limit
+*
+* @details Unlike the profiler this is always measured, the display uses it to limit its own refresh rate.
+*/
+float vocoderLoad()
+{
+    return frameLoad;
+}
+
+/*
+* @brief Vocoder skip ratio function
+*
+* @return The smoothed fraction of the frames skipped by the noise gate, 0 to 1
+*/
+float vocoderSkipRatio()
+{
+    return skipRatio;
+}
+
+/*
+* @brief Set carrier voices function
+*
+* @param[in] count  Number of carrier voices, 1 to `MAX_CARRIER_VOICES`
+* @return False when the count is out of range
+*
+* @details Voices that become active start from silence in both FFT engines and are spread evenly
+* from left to right. Call between two frames from the DSP context, other contexts use requestCarrierVoices().
+* The capture must deliver a hop for every active voice.
+*/
+bool setCarrierVoices(int count)
+{
+    const int previous = carrierVoices.voiceCount();
+    if (!carrierVoices.setVoiceCount(count))
+        return false;
+
+    for (int v = previous; v < count; v++)
+    {
+        fixedPointVocoder.resetVoice(v);
+        carrierShifter.resetVoice(v);
+    }
+    return true;
+}
+
+/*
+* @brief Request carrier voices function
+*
+* @param[in] count  Number of carrier voices, 1 to `MAX_CARRIER_VOICES`
+* @return False when the count is out of range
+*
+* @details Safe to call from any context, like FrameSizeManager::requestSize(). The DSP applies the request
+* between two frames with applyCarrierVoices().
+*/
+bool requestCarrierVoices(int count)
+{
+    if (count < 1 || count > MAX_CARRIER_VOICES)
+        return false;
+
+    pendingVoices.store(count);
+    return true;
+}
+
+/*
+* @brief Requested carrier voices function
+*
+* @return The pending voice count, or the active one when nothing is pending
+*/
+int requestedCarrierVoices()
+{
+    const int count = pendingVoices.load();
+    return (count != 0) ? count : carrierVoices.voiceCount();
+}
+
+/*
+* @brief Apply carrier voices function
+*
+* @return True when the number of voices changed
+*
+* @details Called by the DSP context between two frames.
+*/
+bool applyCarrierVoices()
+{
+    const int count = pendingVoices.exchange(0);
+    if (count == 0 || count == carrierVoices.voiceCount())
+        return false;
+    return setCarrierVoices(count);
+}
+
+/*
+* @brief Apply engine reset function
+*
+* @return True when an FFT engine was selected and its state restarted
+*
+* @details Called by the DSP context before it reads the next hop, so the first hop after a switch goes into
+* empty histories, see resetFrameState(). The caller discards what is left of the capture from before the switch.
+*/
+bool applyEngineReset()
+{
+    if (!pendingReset.exchange(false))
+        return false;
+    resetFrameState();
+    return true;
+}
+
+/*
+* @brief Set vocoder engine function
+*
+* @param[in] engine The engine to use
+*
+* @details The audio stream classes check the active engine on every block, so the switch
+* takes effect at the next block. Every engine starts from a clean state: the filter bank at once,
+* the FFT engines before their next hop in the DSP context, see applyEngineReset().
+*/
+void setVocoderEngine(VocoderEngine engine)
+{
+    if (engine == activeEngine)
+        return;
+
+    if (engine == VocoderEngine::FilterBank)
+        filterBankVocoder.reset();
+    else
+        pendingReset.store(true);
+    activeEngine = engine;
+}
+
+/*
+* @brief Get vocoder engine function
+*
+* @return The active engine
+*/
+VocoderEngine getVocoderEngine()
+{
+    return activeEngine;
+}
+
+/*
+* @brief Vocoder engine name function
+*
+* @param[in] engine The engine
+* @return A short name for the display and the tools
+*/
+const char* vocoderEngineName(VocoderEngine engine)
+{
+    switch (engine)
+    {
+        case VocoderEngine::FFT:        return "FFT";
+        case VocoderEngine::FixedPoint: return "FFT Q31";
+        case VocoderEngine::FilterBank: return "Filter bank";
+        default:                        return "?";
+    }
+}
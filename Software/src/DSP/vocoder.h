@@ -0,0 +1,75 @@
+/**
+ * @file vocoder.h
+ * @brief Header file for the vocoder processing chain
+ *
+ * @details This file contains the declarations of the vocoder hop buffers and the
+ * function that runs one hop through the complete streaming processing chain.
+ * There is one carrier hop buffer per carrier voice and a stereo output.
+ * The processing chain is shared between the Teensy firmware and the native tools.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+#ifndef VOCODER_H
+#define VOCODER_H
+
+// Headers
+#include <cstdint>
+#include "HAL/hal.h"
+#include "filterbank_vocoder.h"
+#include "frame_size_manager.h"
+#include "spectral_envelope.h"
+#include "voice_pool.h"
+#include "dsp_arena.h"
+#include "spectrum_snapshot.h"
+#include "parameters.h"
+#include "voicing_detector.h"
+#include "phase_vocoder.h"
+#include "noise_gate.h"
+
+enum class VocoderEngine
+{
+    FFT,        // Spectral vocoder, latency of one frame plus one hop
+    FixedPoint, // Same spectral vocoder in Q15/Q31 arithmetic (see fixed_point_vocoder.h)
+    FilterBank  // Band-pass filter-bank vocoder, latency of one audio block
+};
+
+// External variables
+extern int fftSize;  // Active FFT size, only changes between frames
+extern int hopSize;  // Active hop size, fftSize / OVERLAP_FACTOR
+
+extern int16_t carrierBuffers[MAX_CARRIER_VOICES][MAX_HOP_SIZE];
+extern int16_t modulatorBuffer[];
+extern int16_t outputLeftBuffer[];
+extern int16_t outputRightBuffer[];
+
+extern FilterBankVocoder filterBankVocoder;
+extern FrameSizeManager frameSizeManager;
+extern SpectralEnvelope modulatorEnvelope;
+extern VoicingDetector voicingDetector;
+extern PhaseVocoder carrierShifter;
+extern NoiseGate noiseGate;
+extern CarrierVoicePool carrierVoices;
+extern DspArena fastArena;
+extern DspArena slowArena;
+extern SpectrumSnapshot spectrumSnapshot;
+extern ParameterRegistry vocoderParameters;
+
+// Function prototypes
+bool initVocoder(int initialFftSize = DEFAULT_FFT_SIZE);
+void processVocoderFrame();
+int vocoderLatency();
+float vocoderLoad();
+float vocoderSkipRatio();
+bool setCarrierVoices(int count);
+bool requestCarrierVoices(int count);
+int requestedCarrierVoices();
+bool applyCarrierVoices();
+bool applyEngineReset();
+void setVocoderEngine(VocoderEngine engine);
+VocoderEngine getVocoderEngine();
+const char* vocoderEngineName(VocoderEngine engine);
+
+#endif // VOCODER_H
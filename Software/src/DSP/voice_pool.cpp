@@ -0,0 +1,191 @@
+/**
+ * @file voice_pool.cpp
+ * @brief Carrier voice pool
+ *
+ * @details This file contains the implementation of the carrier voice pool and its stereo mix.
+ * The mix is accumulated in 32-bit integers, every voice is scaled by its pan gains
+ * and the sum is saturated to 16 bits once all voices have been added.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+// Headers
+#include "voice_pool.h"
+#include <cstring>
+
+/*
+* @brief Begin function
+*
+* @param[in] maxFrameSize           The largest frame length (FFT size)
+* @param[in] maxHopSize             The largest hop size
+* @param[in] analysisType           The analysis window shape
+* @param[in] synthesisType          The synthesis window shape
+* @param[in] inputBuffers           Buffer of `MAX_CARRIER_VOICES` * `maxHopSize` samples, the input hop per voice
+* @param[in] historyBuffers         Buffer of `MAX_CARRIER_VOICES` * 2 * `maxFrameSize` samples, the STFT history per voice
+* @param[in] accumulatorBuffers     Buffer of `MAX_CARRIER_VOICES` * `maxFrameSize` floats, the overlap-add accumulator per voice
+* @param[in] analysisMasterWindow   Buffer of `maxFrameSize` floats, shared by all voices
+* @param[in] analysisWindow         Buffer of `maxFrameSize` floats, shared by all voices
+* @param[in] synthesisMasterWindows Buffer of 2 * `maxFrameSize` floats, shared by all voices
+* @param[in] synthesisWindow        Buffer of `maxFrameSize` floats, shared by all voices
+* @param[in] leftMixBuffer          Buffer of `maxHopSize` values for the left channel sum
+* @param[in] rightMixBuffer         Buffer of `maxHopSize` values for the right channel sum
+*
+* @details All voices use the same window shapes, so they share the window buffers. One centered voice is active.
+* Call setFrameSize() before the first frame.
+*/
+void CarrierVoicePool::begin(int maxFrameSize, int maxHopSize, WindowType analysisType, WindowType synthesisType,
+                             int16_t *inputBuffers, int16_t *historyBuffers, float *accumulatorBuffers,
+                             float *analysisMasterWindow, float *analysisWindow, float *synthesisMasterWindows, float *synthesisWindow,
+                             int32_t *leftMixBuffer, int32_t *rightMixBuffer)
+{
+    this->leftMixBuffer = leftMixBuffer;
+    this->rightMixBuffer = rightMixBuffer;
+
+    for (int i = 0; i < MAX_CARRIER_VOICES; i++)
+    {
+        CarrierVoice &voice = voices[i];
+        voice.input = inputBuffers + i * maxHopSize;
+        memset(voice.input, 0, maxHopSize * sizeof(int16_t));
+        voice.analyzer.begin(maxFrameSize, analysisType, historyBuffers + i * 2 * maxFrameSize, analysisMasterWindow, analysisWindow);
+        voice.synthesizer.begin(maxFrameSize, analysisType, synthesisType, accumulatorBuffers + i * maxFrameSize,
+                                synthesisMasterWindows, synthesisWindow);
+    }
+
+    activeVoices = 0;
+    setVoiceCount(1);
+}
+
+/*
+* @brief Set frame size function
+*
+* @param[in] frameSize  The FFT size
+* @param[in] hopSize    Number of samples per hop
+*
+* @details Every voice is switched, also the inactive ones, so they are ready when they are enabled.
+* The histories are kept and the accumulators are cleared, like for a single stream.
+*/
+void CarrierVoicePool::setFrameSize(int frameSize, int hopSize)
+{
+    this->hopSize = hopSize;
+
+    for (CarrierVoice &voice : voices)
+    {
+        voice.analyzer.setFrameSize(frameSize, hopSize);
+        voice.synthesizer.setFrameSize(frameSize, hopSize);
+    }
+}
+
+/*
+* @brief Set voice count function
+*
+* @param[in] count  Number of active voices, 1 to `MAX_CARRIER_VOICES`
+* @return False when the count is out of range
+*
+* @details Voices that become active start from silence. The active voices are spread evenly
+* from left to right, setPan() can move them afterwards.
+*/
+bool CarrierVoicePool::setVoiceCount(int count)
+{
+    if (count < 1 || count > MAX_CARRIER_VOICES)
+        return false;
+
+    for (int i = activeVoices; i < count; i++)
+    {
+        voices[i].analyzer.reset();
+        voices[i].synthesizer.reset();
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        setPan(i, (count == 1) ? 0.0f : -1.0f + 2.0f * i / (count - 1));
+    }
+
+    activeVoices = count;
+    return true;
+}
+
+/*
+* @brief Reset function
+*
+* @details Every voice starts from silence, its history and its accumulator are cleared.
+*/
+void CarrierVoicePool::reset()
+{
+    for (CarrierVoice &voice : voices)
+    {
+        voice.analyzer.reset();
+        voice.synthesizer.reset();
+    }
+}
+
+/*
+* @brief Set pan function
+*
+* @param[in] index  The voice
+* @param[in] pan    The stereo position, -1 is left, 0 is center, +1 is right
+*/
+void CarrierVoicePool::setPan(int index, float pan)
+{
+    if (index < 0 || index >= MAX_CARRIER_VOICES)
+        return;
+
+    pan = (pan < -1.0f) ? -1.0f : (pan > 1.0f) ? 1.0f : pan;
+    CarrierVoice &voice = voices[index];
+    voice.pan = pan;
+    voice.leftGain = (int32_t)(PAN_UNITY_GAIN * ((pan > 0.0f) ? 1.0f - pan : 1.0f) + 0.5f);
+    voice.rightGain = (int32_t)(PAN_UNITY_GAIN * ((pan < 0.0f) ? 1.0f + pan : 1.0f) + 0.5f);
+}
+
+/*
+* @brief Clear mix function
+*
+* @details This function starts a new hop of the stereo mix.
+*/
+void CarrierVoicePool::clearMix()
+{
+    memset(leftMixBuffer, 0, hopSize * sizeof(int32_t));
+    memset(rightMixBuffer, 0, hopSize * sizeof(int32_t));
+}
+
+/*
+* @brief Mix voice function
+*
+* @param[in] index  The voice
+* @param[in] hop    The `hopSize` output samples of the voice
+*
+* @details A 16-bit sample times a unity gain needs 31 bits. The products are shifted down by 2 bits,
+* so the sum of `MAX_CARRIER_VOICES` full-scale voices still fits in 32 bits. The shift drops no information,
+* the gains have 15 fractional bits and a unity gain gives back the exact sample.
+*/
+void CarrierVoicePool::mixVoice(int index, const int16_t *hop)
+{
+    const int32_t left = voices[index].leftGain;
+    const int32_t right = voices[index].rightGain;
+
+    for (int i = 0; i < hopSize; i++)
+    {
+        leftMixBuffer[i] += (hop[i] * left) >> 2;
+        rightMixBuffer[i] += (hop[i] * right) >> 2;
+    }
+}
+
+/*
+* @brief Read mix function
+*
+* @param[out] left  The `hopSize` left output samples
+* @param[out] right The `hopSize` right output samples
+*
+* @details The sum of all voices is saturated to 16 bits.
+*/
+void CarrierVoicePool::readMix(int16_t *left, int16_t *right)
+{
+    for (int i = 0; i < hopSize; i++)
+    {
+        const int32_t l = leftMixBuffer[i] >> 13;
+        const int32_t r = rightMixBuffer[i] >> 13;
+        left[i] = (int16_t)((l > 32767) ? 32767 : (l < -32768) ? -32768 : l);
+        right[i] = (int16_t)((r > 32767) ? 32767 : (r < -32768) ? -32768 : r);
+    }
+}
@@ -0,0 +1,80 @@
+/**
+ * @file voice_pool.h
+ * @brief Header file for the carrier voice pool
+ *
+ * @details This file contains the declaration of the pool of carrier voices. A voice is one carrier stream,
+ * for example one channel of a stereo carrier or one synth voice, with its own STFT history,
+ * overlap-add accumulator and stereo position. Every voice is vocoded against the same modulator analysis,
+ * which is computed once per frame, and the voices are panned into one stereo output.
+ *
+ * The pool holds `MAX_CARRIER_VOICES` voices, their buffers are carved from blocks provided by the caller in begin(),
+ * so changing the number of active voices needs no allocation.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+#ifndef VOICE_POOL_H
+#define VOICE_POOL_H
+
+// Headers
+#include <cstdint>
+#include "stft.h"
+
+// Defines
+static const int MAX_CARRIER_VOICES = 4;
+static const int32_t PAN_UNITY_GAIN = 1 << 15; // Pan gains are fixed-point with 15 fractional bits
+
+/*
+* @struct CarrierVoice
+* @brief One carrier stream of the pool
+*/
+struct CarrierVoice
+{
+    int16_t *input = nullptr;           // `hopSize` new carrier samples, filled before processVocoderFrame()
+    StftAnalyzer analyzer;
+    OverlapAddSynthesizer synthesizer;
+    float pan = 0.0f;                   // -1 is left, 0 is center, +1 is right
+    int32_t leftGain = PAN_UNITY_GAIN;
+    int32_t rightGain = PAN_UNITY_GAIN;
+};
+
+/*
+* @class CarrierVoicePool
+* @brief Preallocated carrier voices and their stereo mix
+*
+* @details The first voiceCount() voices are active. Per hop every active voice delivers one hop of
+* output samples to mixVoice(), readMix() then returns the stereo sum. The pan law keeps a centered voice
+* at unity gain on both channels and turns the opposite channel down towards the sides,
+* so a single centered voice gives exactly the mono output on both channels.
+*/
+class CarrierVoicePool
+{
+    public:
+        void begin(int maxFrameSize, int maxHopSize, WindowType analysisType, WindowType synthesisType,
+                   int16_t *inputBuffers, int16_t *historyBuffers, float *accumulatorBuffers,
+                   float *analysisMasterWindow, float *analysisWindow, float *synthesisMasterWindows, float *synthesisWindow,
+                   int32_t *leftMixBuffer, int32_t *rightMixBuffer);
+        void setFrameSize(int frameSize, int hopSize);
+        bool setVoiceCount(int count);
+        void setPan(int index, float pan);
+        void reset();
+
+        int voiceCount() const { return activeVoices; }
+        CarrierVoice& voice(int index) { return voices[index]; }
+        const CarrierVoice& voice(int index) const { return voices[index]; }
+
+        void clearMix();
+        void mixVoice(int index, const int16_t *hop);
+        void readMix(int16_t *left, int16_t *right);
+
+    private:
+        int hopSize = 0;
+        volatile int activeVoices = 1; // Read by the capture interrupt
+        CarrierVoice voices[MAX_CARRIER_VOICES];
+        int32_t *leftMixBuffer = nullptr;   // maxHopSize samples
+        int32_t *rightMixBuffer = nullptr;  // maxHopSize samples
+};
+
+#endif // VOICE_POOL_H
@@ -0,0 +1,195 @@
+/**
+ * @file voicing_detector.cpp
+ * @brief Voiced/unvoiced detector of the modulator
+ *
+ * @details This file contains the implementation of the feature extraction and the decision.
+ * The flatness needs the logarithm of every bin, a fast log2 from the float exponent and a third order
+ * polynomial of the mantissa is used, its error below 0.002 is far below what the threshold needs.
+ * Both FFT engines use the same code, the fixed-point magnitudes are converted to float per bin.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+// Headers
+#include "voicing_detector.h"
+#include <cmath>
+#include <cstring>
+
+/*
+* @brief Fast log2 function
+*
+* @param[in] x  The value, must be a normal float above 0
+* @return Approximation of log2(x)
+*/
+static inline float fastLog2(float x)
+{
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    const float exponent = (float)((int)((bits >> 23) & 0xFF) - 127);
+
+    bits = (bits & 0x007FFFFF) | 0x3F800000; // Mantissa in [1, 2)
+    float mantissa;
+    memcpy(&mantissa, &bits, sizeof(mantissa));
+    return exponent + ((0.15391477f * mantissa - 1.02950006f) * mantissa + 3.01074372f) * mantissa - 2.13382433f;
+}
+
+/*
+* @brief Begin function
+*
+* @param[in] sampleRate The sample rate in Hz
+*/
+void VoicingDetector::begin(float sampleRate)
+{
+    this->sampleRate = sampleRate;
+    reset();
+}
+
+/*
+* @brief Reset function
+*
+* @details Starts voiced, with no features and no zero crossings of earlier hops.
+*/
+void VoicingDetector::reset()
+{
+    unvoicedState = false;
+    lastNegative = false;
+    current = VoicingFeatures();
+    memset(hopCrossings, 0, sizeof(hopCrossings));
+    hopIndex = 0;
+}
+
+/*
+* @brief Set frame size function
+*
+* @param[in] fftSize    The FFT size
+* @param[in] hopSize    The hop size
+*
+* @details Computes the bins of the bands and restarts the zero-crossing count.
+*/
+void VoicingDetector::setFrameSize(int fftSize, int hopSize)
+{
+    this->fftSize = fftSize;
+    this->hopSize = hopSize;
+
+    const float binWidth = sampleRate / fftSize;
+    lowStart = (int)(VOICING_LOW_BAND[0] / binWidth);
+    lowEnd = (int)(VOICING_LOW_BAND[1] / binWidth);
+    highStart = (int)(VOICING_HIGH_BAND[0] / binWidth);
+    highEnd = (int)(VOICING_HIGH_BAND[1] / binWidth);
+
+    memset(hopCrossings, 0, sizeof(hopCrossings));
+    hopIndex = 0;
+}
+
+/*
+* @brief Analyze hop function
+*
+* @param[in] hop    The `hopSize` new modulator samples, after the high-pass
+*
+* @details Counts the sign changes, including the one from the previous hop to this one.
+*/
+void VoicingDetector::analyzeHop(const float *hop)
+{
+    int crossings = 0;
+    bool negative = lastNegative;
+    for (int i = 0; i < hopSize; i++)
+    {
+        const bool sampleNegative = hop[i] < 0.0f;
+        crossings += (sampleNegative != negative) ? 1 : 0;
+        negative = sampleNegative;
+    }
+    lastNegative = negative;
+
+    hopCrossings[hopIndex] = crossings;
+    hopIndex = (hopIndex + 1) % OVERLAP_FACTOR;
+}
+
+/*
+* @brief Classify function
+*
+* @param[in] magnitude  The modulator magnitude of the frame
+* @return True when the frame is unvoiced
+*/
+bool VoicingDetector::classify(const float *magnitude)
+{
+    return classifyBins(magnitude, 1.0f);
+}
+
+/*
+* @brief Classify function, fixed-point
+*
+* @param[in] magnitude  The modulator magnitude in Q31
+* @param[in] exponent   The block exponent, magnitude * 2^exponent is the magnitude of the float engine
+* @return True when the frame is unvoiced
+*/
+bool VoicingDetector::classify(const q31_t *magnitude, int exponent)
+{
+    return classifyBins(magnitude, ldexpf(1.0f, exponent));
+}
+
+/*
+* @brief Classify bins function
+*
+* @param[in] magnitude  The modulator magnitude
+* @param[in] scale      Factor to the magnitude of the float engine, only the level depends on it
+* @return True when the frame is unvoiced
+*
+* @details One pass over the bins from the start of the low band to the end of the high band:
+* the energy per band, the total energy and the sum of the log magnitudes for the flatness.
+*/
+template <typename T>
+bool VoicingDetector::classifyBins(const T *magnitude, float scale)
+{
+    float lowEnergy = 0.0f;
+    float middleEnergy = 0.0f;
+    float highEnergy = 0.0f;
+    float logSum = 0.0f;
+
+    // The magnitude is at least 1 in the log, far below any audible bin in both engines, so silence has no -inf
+    for (int i = lowStart; i < lowEnd; i++)
+    {
+        const float value = (float)magnitude[i];
+        lowEnergy += value * value;
+        logSum += fastLog2(value + 1.0f);
+    }
+    for (int i = lowEnd; i < highStart; i++)
+    {
+        const float value = (float)magnitude[i];
+        middleEnergy += value * value;
+        logSum += fastLog2(value + 1.0f);
+    }
+    for (int i = highStart; i < highEnd; i++)
+    {
+        const float value = (float)magnitude[i];
+        highEnergy += value * value;
+        logSum += fastLog2(value + 1.0f);
+    }
+
+    const int bins = highEnd - lowStart;
+    const float energy = lowEnergy + middleEnergy + highEnergy;
+    const float meanPower = energy / bins;
+
+    // The half spectrum of a sine of amplitude A holds N^2 A^2 / 8, its mean square is A^2 / 2
+    const float meanSquare = 4.0f * energy * scale * scale / ((float)fftSize * fftSize);
+    current.level = 10.0f * log10f(meanSquare / (32768.0f * 32768.0f) + 1e-12f);
+    current.bandRatio = highEnergy / ((lowEnergy > 0.0f) ? lowEnergy : 1e-12f);
+    current.flatness = (meanPower > 0.0f) ? exp2f(2.0f * logSum / bins) / meanPower : 0.0f;
+    current.flatness = (current.flatness > 1.0f) ? 1.0f : current.flatness;
+
+    int crossings = 0;
+    for (int h = 0; h < OVERLAP_FACTOR; h++)
+    {
+        crossings += hopCrossings[h];
+    }
+    current.zeroCrossingRate = (float)crossings / fftSize;
+
+    const float relax = unvoicedState ? VOICING_HYSTERESIS : 1.0f;
+    const bool silent = current.level < VOICING_SILENCE_LEVEL;
+    const bool highBand = current.bandRatio > ratioThreshold * relax;
+    const bool noisy = current.zeroCrossingRate > VOICING_ZCR_THRESHOLD * relax &&
+                       current.flatness > VOICING_FLATNESS_THRESHOLD * relax;
+    unvoicedState = !silent && (highBand || noisy);
+    return unvoicedState;
+}
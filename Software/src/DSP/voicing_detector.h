@@ -0,0 +1,94 @@
+/**
+ * @file voicing_detector.h
+ * @brief Header file for the voiced/unvoiced detector of the modulator
+ *
+ * @details This file contains the declaration of the detector that decides per frame whether the modulator is
+ * voiced (vowels, the carrier is vocoded) or unvoiced (sibilants and fricatives, the carrier is replaced by noise).
+ * The decision uses four features, all computed from data the chain produces anyway:
+ * - Level: the frame energy in dBFS, silent frames are always voiced so silence does not produce noise bursts.
+ * - Band ratio: the energy from 3 to 8 kHz over the energy from 80 to 500 Hz.
+ * - Flatness: the geometric over the arithmetic mean of the power spectrum, near 0 for harmonics, about 0.56 for noise.
+ * - Zero-crossing rate: sign changes per sample of the high-passed modulator over the frame.
+ *
+ * A frame is unvoiced when the band ratio is above its threshold, or when the zero-crossing rate and the flatness
+ * are both high. While unvoiced all thresholds are lowered by `VOICING_HYSTERESIS`, so a decision near a threshold
+ * does not toggle every frame.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+#ifndef VOICING_DETECTOR_H
+#define VOICING_DETECTOR_H
+
+// Headers
+#include <cstdint>
+#include "HAL/hal.h"
+#include "frame_size_manager.h"
+
+// Defines
+static const float VOICING_LOW_BAND[2] = {80.0f, 500.0f};       // Hz
+static const float VOICING_HIGH_BAND[2] = {3000.0f, 8000.0f};   // Hz
+static const float VOICING_SILENCE_LEVEL = -60.0f;              // dBFS
+static const float VOICING_ZCR_THRESHOLD = 0.3f;                // Crossings per sample
+static const float VOICING_FLATNESS_THRESHOLD = 0.3f;
+static const float VOICING_HYSTERESIS = 0.75f;                  // Factor of the thresholds while unvoiced
+
+/*
+* @struct VoicingFeatures
+* @brief The features of one frame
+*/
+struct VoicingFeatures
+{
+    float level;            // dBFS, for the sqrt-Hann analysis window
+    float bandRatio;        // High band over low band energy
+    float flatness;         // 0 to 1
+    float zeroCrossingRate; // 0 to 1
+};
+
+/*
+* @class VoicingDetector
+* @brief Voiced/unvoiced decision of the modulator with hysteresis
+*
+* @details Per hop: analyzeHop() with the new high-passed samples, then classify() with the magnitude of the frame.
+* The spectral features are computed in one pass over the bins between the low and the high band,
+* the zero-crossing rate is kept per hop and summed over the `OVERLAP_FACTOR` hops of the frame.
+*/
+class VoicingDetector
+{
+    public:
+        void begin(float sampleRate);
+        void setFrameSize(int fftSize, int hopSize);
+        void setRatioThreshold(float ratio) { ratioThreshold = ratio; }
+        void reset();
+
+        void analyzeHop(const float *hop);
+        bool classify(const float *magnitude);
+        bool classify(const q31_t *magnitude, int exponent);
+
+        bool unvoiced() const { return unvoicedState; }
+        const VoicingFeatures& features() const { return current; }
+
+    private:
+        template <typename T>
+        bool classifyBins(const T *magnitude, float scale);
+
+        float sampleRate = 44100.0f;
+        int fftSize = 0;
+        int hopSize = 0;
+        int lowStart = 0;
+        int lowEnd = 0;
+        int highStart = 0;
+        int highEnd = 0;
+        float ratioThreshold = 4.0f;
+
+        int hopCrossings[OVERLAP_FACTOR] = {};  // Per hop of the frame
+        int hopIndex = 0;
+        bool lastNegative = false;              // Sign of the last sample of the previous hop
+
+        bool unvoicedState = false;
+        VoicingFeatures current = {};
+};
+
+#endif // VOICING_DETECTOR_H
@@ -0,0 +1,55 @@
+/**
+ * @file cycle_counter.h
+ * @brief Hardware abstraction of a free running cycle counter
+ *
+ * @details On the Teensy the Cortex-M7 DWT cycle counter is read, it counts CPU cycles and is
+ * enabled by the Teensy startup code. On the native build a nanosecond steady clock is used instead,
+ * so one tick is one nanosecond. Both wrap at 32 bits, differences of two readings are still valid
+ * as long as the measured interval is shorter than the wrap time (7 s at 600 MHz, 4 s on the host).
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+#ifndef CYCLE_COUNTER_H
+#define CYCLE_COUNTER_H
+
+// Headers
+#include <cstdint>
+#include "HAL/hal.h"
+
+#if defined(HAL_TARGET_NATIVE)
+    #include <chrono>
+#endif
+
+/*
+* @brief Cycle count function
+*
+* @return The current tick count
+*/
+static inline uint32_t halCycleCount()
+{
+#if defined(HAL_TARGET_TEENSY)
+    return ARM_DWT_CYCCNT;
+#else
+    return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+/*
+* @brief Cycles per second function
+*
+* @return The tick rate of halCycleCount() in Hz
+*/
+static inline uint32_t halCyclesPerSecond()
+{
+#if defined(HAL_TARGET_TEENSY)
+    return F_CPU_ACTUAL;
+#else
+    return 1000000000u;
+#endif
+}
+
+#endif // CYCLE_COUNTER_H
@@ -0,0 +1,42 @@
+/**
+ * @file hal.h
+ * @brief Hardware abstraction layer for the DSP code
+ *
+ * @details This file selects the platform specific headers that the DSP code depends on.
+ * On the Teensy build the Arduino core and the CMSIS-DSP library are used directly.
+ * On the native (host) build a portable implementation of the used CMSIS-DSP subset is
+ * provided instead, so the exact same processing chain can be compiled and run on a PC.
+ *
+ * The memory placement macros put a variable in fast or slow memory. On the Teensy 4.x fast memory is
+ * the tightly coupled DTCM (RAM1), where variables go by default, and slow memory is the cached OCRAM (RAM2).
+ * The native build has one kind of memory, there the macros are empty.
+ *
+ * @note The DSP files should include this header instead of <arm_math.h> or <Arduino.h>.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+#ifndef HAL_H
+#define HAL_H
+
+#if defined(ARDUINO)
+    #define HAL_TARGET_TEENSY 1
+
+    #include <Arduino.h>
+    #include <arm_math.h>
+    #include "arm_const_structs.h"
+
+    #define HAL_FAST_MEMORY             // DTCM, single cycle access
+    #define HAL_SLOW_MEMORY DMAMEM      // OCRAM, not zeroed at startup
+#else
+    #define HAL_TARGET_NATIVE 1
+
+    #include "HAL/native/arm_math_native.h"
+
+    #define HAL_FAST_MEMORY
+    #define HAL_SLOW_MEMORY
+#endif
+
+#endif // HAL_H
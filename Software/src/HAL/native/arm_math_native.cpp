@@ -0,0 +1,405 @@
+/**
+ * @file arm_math_native.cpp
+ * @brief Portable implementation of the used CMSIS-DSP subset for the native build
+ *
+ * @details This file implements the complex and real FFT with the same behaviour as CMSIS-DSP:
+ * interleaved real/imaginary data, no scaling on the forward transform
+ * and 1/N scaling on the inverse transform. The Q31 complex FFT scales both directions by 1/N.
+ * The real FFT uses the CMSIS packed format: [X(0), X(N/2), Re X(1), Im X(1), ...].
+ * The vector functions are plain loops that the compiler auto-vectorizes (SSE/NEON) at -O3.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+// Headers
+#include "arm_math_native.h"
+#include <cstring>
+#include <algorithm>
+
+// Variables
+static const int MAX_CFFT_LENGTH = 4096;
+
+const arm_cfft_instance_f32 arm_cfft_sR_f32_len16   = {16,   nullptr, nullptr, 0};
+const arm_cfft_instance_f32 arm_cfft_sR_f32_len32   = {32,   nullptr, nullptr, 0};
+const arm_cfft_instance_f32 arm_cfft_sR_f32_len64   = {64,   nullptr, nullptr, 0};
+const arm_cfft_instance_f32 arm_cfft_sR_f32_len128  = {128,  nullptr, nullptr, 0};
+const arm_cfft_instance_f32 arm_cfft_sR_f32_len256  = {256,  nullptr, nullptr, 0};
+const arm_cfft_instance_f32 arm_cfft_sR_f32_len512  = {512,  nullptr, nullptr, 0};
+const arm_cfft_instance_f32 arm_cfft_sR_f32_len1024 = {1024, nullptr, nullptr, 0};
+const arm_cfft_instance_f32 arm_cfft_sR_f32_len2048 = {2048, nullptr, nullptr, 0};
+const arm_cfft_instance_f32 arm_cfft_sR_f32_len4096 = {4096, nullptr, nullptr, 0};
+
+const arm_cfft_instance_q31 arm_cfft_sR_q31_len16   = {16,   nullptr, nullptr, 0};
+const arm_cfft_instance_q31 arm_cfft_sR_q31_len32   = {32,   nullptr, nullptr, 0};
+const arm_cfft_instance_q31 arm_cfft_sR_q31_len64   = {64,   nullptr, nullptr, 0};
+const arm_cfft_instance_q31 arm_cfft_sR_q31_len128  = {128,  nullptr, nullptr, 0};
+const arm_cfft_instance_q31 arm_cfft_sR_q31_len256  = {256,  nullptr, nullptr, 0};
+const arm_cfft_instance_q31 arm_cfft_sR_q31_len512  = {512,  nullptr, nullptr, 0};
+const arm_cfft_instance_q31 arm_cfft_sR_q31_len1024 = {1024, nullptr, nullptr, 0};
+const arm_cfft_instance_q31 arm_cfft_sR_q31_len2048 = {2048, nullptr, nullptr, 0};
+const arm_cfft_instance_q31 arm_cfft_sR_q31_len4096 = {4096, nullptr, nullptr, 0};
+
+/*
+* @brief Get twiddle table function
+*
+* @return Interleaved cos/sin table for the largest supported length
+*
+* @details The table holds exp(-j*2*pi*k/4096) for k < 2048, smaller lengths use it with a stride.
+* It is computed in double precision on first use.
+*/
+static const float32_t* getTwiddleTable()
+{
+    static float32_t table[MAX_CFFT_LENGTH];
+    static bool initialized = false;
+
+    if (!initialized)
+    {
+        for (int k = 0; k < MAX_CFFT_LENGTH / 2; k++)
+        {
+            double angle = 2.0 * M_PI * k / MAX_CFFT_LENGTH;
+            table[2 * k] = (float32_t)cos(angle);
+            table[2 * k + 1] = (float32_t)-sin(angle);
+        }
+        initialized = true;
+    }
+    return table;
+}
+
+/*
+* @brief Get Q31 twiddle table function
+*
+* @return Interleaved cos/sin table for the largest supported length in Q31
+*
+* @details Same angles as getTwiddleTable(), rounded to Q31 and saturated at +1.
+*/
+static const q31_t* getTwiddleTableQ31()
+{
+    static q31_t table[MAX_CFFT_LENGTH];
+    static bool initialized = false;
+
+    if (!initialized)
+    {
+        for (int k = 0; k < MAX_CFFT_LENGTH / 2; k++)
+        {
+            double angle = 2.0 * M_PI * k / MAX_CFFT_LENGTH;
+            table[2 * k] = (q31_t)std::min(llround(cos(angle) * 2147483648.0), 2147483647LL);
+            table[2 * k + 1] = (q31_t)std::min(llround(-sin(angle) * 2147483648.0), 2147483647LL);
+        }
+        initialized = true;
+    }
+    return table;
+}
+
+/*
+* @brief Bit reversal function
+*
+* @param[in,out] data   Interleaved complex data
+* @param[in] length     Number of complex samples
+*/
+template <typename T>
+static void bitReverse(T *data, int length)
+{
+    int j = 0;
+    for (int i = 0; i < length - 1; i++)
+    {
+        if (i < j)
+        {
+            T re = data[2 * i];
+            T im = data[2 * i + 1];
+            data[2 * i] = data[2 * j];
+            data[2 * i + 1] = data[2 * j + 1];
+            data[2 * j] = re;
+            data[2 * j + 1] = im;
+        }
+        int bit = length >> 1;
+        while (j & bit)
+        {
+            j ^= bit;
+            bit >>= 1;
+        }
+        j |= bit;
+    }
+}
+
+/*
+* @brief Complex FFT function
+*
+* @param[in] S              The FFT instance
+* @param[in,out] p1         Interleaved complex data, processed in place
+* @param[in] ifftFlag       0 for the forward transform, 1 for the inverse transform
+* @param[in] bitReverseFlag 1 to output in natural order, 0 to leave the output bit reversed
+*
+* @details Decimation-in-frequency radix-2 transform. The butterflies take natural order input
+* and produce bit reversed output, which matches the CMSIS bitReverseFlag semantics.
+*/
+void arm_cfft_f32(const arm_cfft_instance_f32 *S, float32_t *p1, uint8_t ifftFlag, uint8_t bitReverseFlag)
+{
+    const int length = S->fftLen;
+    const float32_t *twiddle = getTwiddleTable();
+    const float32_t sign = ifftFlag ? -1.0f : 1.0f;
+
+    for (int span = length / 2, stride = MAX_CFFT_LENGTH / length; span >= 1; span >>= 1, stride <<= 1)
+    {
+        for (int start = 0; start < length; start += 2 * span)
+        {
+            for (int k = 0; k < span; k++)
+            {
+                float32_t *a = &p1[2 * (start + k)];
+                float32_t *b = &p1[2 * (start + k + span)];
+                float32_t wr = twiddle[2 * k * stride];
+                float32_t wi = sign * twiddle[2 * k * stride + 1];
+
+                float32_t dr = a[0] - b[0];
+                float32_t di = a[1] - b[1];
+                a[0] += b[0];
+                a[1] += b[1];
+                b[0] = dr * wr - di * wi;
+                b[1] = dr * wi + di * wr;
+            }
+        }
+    }
+
+    if (bitReverseFlag)
+    {
+        bitReverse(p1, length);
+    }
+
+    if (ifftFlag)
+    {
+        const float32_t scale = 1.0f / length;
+        for (int i = 0; i < 2 * length; i++)
+        {
+            p1[i] *= scale;
+        }
+    }
+}
+
+/*
+* @brief Q31 complex FFT function
+*
+* @param[in] S              The FFT instance
+* @param[in,out] p1         Interleaved complex data in Q31, processed in place
+* @param[in] ifftFlag       0 for the forward transform, 1 for the inverse transform
+* @param[in] bitReverseFlag 1 to output in natural order, 0 to leave the output bit reversed
+*
+* @details Same butterflies as arm_cfft_f32(), but every stage halves its output to avoid overflow,
+* like CMSIS. Both directions are therefore scaled down by fftLen, the inverse transform has no extra 1 / fftLen.
+*/
+void arm_cfft_q31(const arm_cfft_instance_q31 *S, q31_t *p1, uint8_t ifftFlag, uint8_t bitReverseFlag)
+{
+    const int length = S->fftLen;
+    const q31_t *twiddle = getTwiddleTableQ31();
+
+    for (int span = length / 2, stride = MAX_CFFT_LENGTH / length; span >= 1; span >>= 1, stride <<= 1)
+    {
+        for (int start = 0; start < length; start += 2 * span)
+        {
+            for (int k = 0; k < span; k++)
+            {
+                q31_t *a = &p1[2 * (start + k)];
+                q31_t *b = &p1[2 * (start + k + span)];
+                q63_t wr = twiddle[2 * k * stride];
+                q63_t wi = ifftFlag ? -(q63_t)twiddle[2 * k * stride + 1] : twiddle[2 * k * stride + 1];
+
+                q63_t dr = ((q63_t)a[0] - b[0]) >> 1;
+                q63_t di = ((q63_t)a[1] - b[1]) >> 1;
+                a[0] = (q31_t)(((q63_t)a[0] + b[0]) >> 1);
+                a[1] = (q31_t)(((q63_t)a[1] + b[1]) >> 1);
+                b[0] = (q31_t)((dr * wr - di * wi) >> 31);
+                b[1] = (q31_t)((dr * wi + di * wr) >> 31);
+            }
+        }
+    }
+
+    if (bitReverseFlag)
+    {
+        bitReverse(p1, length);
+    }
+}
+
+/*
+* @brief Real FFT init function
+*
+* @param[out] S     The real FFT instance
+* @param[in] fftLen The real FFT length, 32 to 4096
+* @return ARM_MATH_SUCCESS, or ARM_MATH_ARGUMENT_ERROR for an unsupported length
+*/
+arm_status arm_rfft_fast_init_f32(arm_rfft_fast_instance_f32 *S, uint16_t fftLen)
+{
+    if (fftLen < 32 || fftLen > MAX_CFFT_LENGTH || (fftLen & (fftLen - 1)) != 0)
+        return ARM_MATH_ARGUMENT_ERROR;
+
+    S->Sint = {(uint16_t)(fftLen / 2), nullptr, nullptr, 0};
+    S->fftLenRFFT = fftLen;
+    S->pTwiddleRFFT = getTwiddleTable();
+    return ARM_MATH_SUCCESS;
+}
+
+/*
+* @brief Real FFT function
+*
+* @param[in] S          The real FFT instance
+* @param[in] p          Input buffer of fftLen floats, used as scratch and overwritten
+* @param[out] pOut      Output buffer of fftLen floats
+* @param[in] ifftFlag   0 for the forward transform, 1 for the inverse transform
+*
+* @details The forward transform packs the even and odd samples into one half-length complex FFT
+* and splits the result with X(k) = E(k) + W^k O(k). The inverse transform does the same steps in reverse.
+*/
+void arm_rfft_fast_f32(arm_rfft_fast_instance_f32 *S, float32_t *p, float32_t *pOut, uint8_t ifftFlag)
+{
+    const int half = S->fftLenRFFT / 2;
+    const int stride = MAX_CFFT_LENGTH / S->fftLenRFFT;
+    const float32_t *twiddle = S->pTwiddleRFFT;
+
+    if (!ifftFlag)
+    {
+        arm_cfft_f32(&S->Sint, p, 0, 1);
+
+        pOut[0] = p[0] + p[1]; // DC
+        pOut[1] = p[0] - p[1]; // Nyquist
+
+        for (int k = 1; k < half; k++)
+        {
+            float32_t ar = p[2 * k],          ai = p[2 * k + 1];          // Z(k)
+            float32_t br = p[2 * (half - k)], bi = -p[2 * (half - k) + 1]; // conj(Z(N/2 - k))
+            float32_t wr = twiddle[2 * k * stride], wi = twiddle[2 * k * stride + 1];
+
+            float32_t er = 0.5f * (ar + br), ei = 0.5f * (ai + bi); // E(k)
+            float32_t or_ = 0.5f * (ai - bi), oi = -0.5f * (ar - br); // O(k)
+
+            pOut[2 * k] = er + wr * or_ - wi * oi;
+            pOut[2 * k + 1] = ei + wr * oi + wi * or_;
+        }
+    }
+    else
+    {
+        pOut[0] = 0.5f * (p[0] + p[1]);
+        pOut[1] = 0.5f * (p[0] - p[1]);
+
+        for (int k = 1; k < half; k++)
+        {
+            float32_t ar = p[2 * k],          ai = p[2 * k + 1];          // X(k)
+            float32_t br = p[2 * (half - k)], bi = -p[2 * (half - k) + 1]; // conj(X(N/2 - k))
+            float32_t wr = twiddle[2 * k * stride], wi = -twiddle[2 * k * stride + 1]; // W^-k
+
+            float32_t er = 0.5f * (ar + br), ei = 0.5f * (ai + bi);
+            float32_t dr = 0.5f * (ar - br), di = 0.5f * (ai - bi);
+            float32_t or_ = dr * wr - di * wi, oi = dr * wi + di * wr;
+
+            pOut[2 * k] = er - oi;      // E(k) + j O(k)
+            pOut[2 * k + 1] = ei + or_;
+        }
+
+        arm_cfft_f32(&S->Sint, pOut, 1, 1);
+    }
+}
+
+/*
+* @brief Complex magnitude function
+*
+* @param[in] pSrc       Interleaved complex input
+* @param[out] pDst      Magnitude output
+* @param[in] numSamples Number of complex samples
+*/
+void arm_cmplx_mag_f32(const float32_t *pSrc, float32_t *pDst, uint32_t numSamples)
+{
+    for (uint32_t i = 0; i < numSamples; i++)
+    {
+        float32_t real = pSrc[2 * i];
+        float32_t imag = pSrc[2 * i + 1];
+        pDst[i] = sqrtf(real * real + imag * imag);
+    }
+}
+
+/*
+* @brief Q31 complex magnitude function
+*
+* @param[in] pSrc       Interleaved complex input in 1.31 format
+* @param[out] pDst      Magnitude output in 2.30 format, so half the Q31 magnitude
+* @param[in] numSamples Number of complex samples
+*/
+void arm_cmplx_mag_q31(const q31_t *pSrc, q31_t *pDst, uint32_t numSamples)
+{
+    for (uint32_t i = 0; i < numSamples; i++)
+    {
+        q63_t real = pSrc[2 * i];
+        q63_t imag = pSrc[2 * i + 1];
+        pDst[i] = (q31_t)(sqrt((double)((uint64_t)(real * real) + (uint64_t)(imag * imag))) * 0.5);
+    }
+}
+
+/*
+* @brief Complex by real multiplication function
+*
+* @param[in] pSrcCmplx  Interleaved complex input
+* @param[in] pSrcReal   Real input
+* @param[out] pCmplxDst Interleaved complex output
+* @param[in] numSamples Number of samples
+*/
+void arm_cmplx_mult_real_f32(const float32_t *pSrcCmplx, const float32_t *pSrcReal, float32_t *pCmplxDst, uint32_t numSamples)
+{
+    for (uint32_t i = 0; i < numSamples; i++)
+    {
+        pCmplxDst[2 * i] = pSrcCmplx[2 * i] * pSrcReal[i];
+        pCmplxDst[2 * i + 1] = pSrcCmplx[2 * i + 1] * pSrcReal[i];
+    }
+}
+
+/*
+* @brief Biquad cascade init function
+*
+* @param[out] S         The instance
+* @param[in] numStages  Number of second order stages
+* @param[in] pCoeffs    The coefficients, 5 per stage
+* @param[in] pState     The state, 2 per stage, cleared here
+*/
+void arm_biquad_cascade_df2T_init_f32(arm_biquad_cascade_df2T_instance_f32 *S, uint8_t numStages, const float32_t *pCoeffs, float32_t *pState)
+{
+    S->numStages = numStages;
+    S->pCoeffs = pCoeffs;
+    S->pState = pState;
+    memset(pState, 0, sizeof(float32_t) * 2 * numStages);
+}
+
+/*
+* @brief Biquad cascade function
+*
+* @param[in] S          The instance
+* @param[in] pSrc       The input block
+* @param[out] pDst      The output block, may be the same as pSrc
+* @param[in] blockSize  Number of samples
+*
+* @details Like CMSIS the whole block runs through one stage before the next, so the coefficients and
+* the state of a stage stay in registers. The recursion itself cannot be vectorized across samples.
+*/
+void arm_biquad_cascade_df2T_f32(const arm_biquad_cascade_df2T_instance_f32 *S, const float32_t *pSrc, float32_t *pDst, uint32_t blockSize)
+{
+    const float32_t *coeffs = S->pCoeffs;
+    float32_t *state = S->pState;
+    const float32_t *input = pSrc;
+
+    for (uint8_t stage = 0; stage < S->numStages; stage++)
+    {
+        const float32_t b0 = coeffs[0], b1 = coeffs[1], b2 = coeffs[2], a1 = coeffs[3], a2 = coeffs[4];
+        float32_t d1 = state[0];
+        float32_t d2 = state[1];
+
+        for (uint32_t i = 0; i < blockSize; i++)
+        {
+            const float32_t x = input[i];
+            const float32_t y = b0 * x + d1;
+            d1 = b1 * x + a1 * y + d2;
+            d2 = b2 * x + a2 * y;
+            pDst[i] = y;
+        }
+
+        state[0] = d1;
+        state[1] = d2;
+        coeffs += 5;
+        state += 2;
+        input = pDst;
+    }
+}
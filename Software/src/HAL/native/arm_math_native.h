@@ -0,0 +1,129 @@
+/**
+ * @file arm_math_native.h
+ * @brief Portable implementation of the used CMSIS-DSP subset for the native build
+ *
+ * @details This file declares the CMSIS-DSP types, constants and functions that the DSP code uses,
+ * with the same names and calling conventions as <arm_math.h>.
+ * The implementation is plain C++ so the vocoder can be built and profiled on a PC.
+ * Results match the Teensy build up to floating point rounding. The Q31 functions use the same
+ * fixed-point scaling as CMSIS, so the fixed-point engine has the same headroom and precision on the PC.
+ *
+ * @note Only compiled for the native environment, see platformio.ini.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+#ifndef ARM_MATH_NATIVE_H
+#define ARM_MATH_NATIVE_H
+
+// Headers
+#include <cstdint>
+#include <cmath>
+
+#ifndef PI
+#define PI 3.14159265358979f
+#endif
+
+typedef float float32_t;
+typedef int16_t q15_t;
+typedef int32_t q31_t;
+typedef int64_t q63_t;
+
+typedef enum
+{
+    ARM_MATH_SUCCESS        =  0,
+    ARM_MATH_ARGUMENT_ERROR = -1,
+    ARM_MATH_LENGTH_ERROR   = -2
+} arm_status;
+
+/*
+* @struct arm_cfft_instance_f32
+* @brief Instance structure for the floating-point complex FFT
+*
+* @details Same layout as CMSIS-DSP. The native implementation only uses fftLen,
+* the twiddle factors are shared between all lengths (see arm_math_native.cpp).
+*/
+typedef struct
+{
+    uint16_t fftLen;
+    const float32_t *pTwiddle;
+    const uint16_t *pBitRevTable;
+    uint16_t bitRevLength;
+} arm_cfft_instance_f32;
+
+/*
+* @struct arm_cfft_instance_q31
+* @brief Instance structure for the Q31 complex FFT
+*
+* @details Same layout as CMSIS-DSP. The native implementation only uses fftLen.
+*/
+typedef struct
+{
+    uint16_t fftLen;
+    const q31_t *pTwiddle;
+    const uint16_t *pBitRevTable;
+    uint16_t bitRevLength;
+} arm_cfft_instance_q31;
+
+/*
+* @struct arm_rfft_fast_instance_f32
+* @brief Instance structure for the floating-point real FFT
+*
+* @details Same layout as CMSIS-DSP. The real FFT of length fftLenRFFT is computed with
+* a complex FFT of half the length (Sint) followed by a split step.
+*/
+typedef struct
+{
+    arm_cfft_instance_f32 Sint;
+    uint16_t fftLenRFFT;
+    const float32_t *pTwiddleRFFT;
+} arm_rfft_fast_instance_f32;
+
+/*
+* @struct arm_biquad_cascade_df2T_instance_f32
+* @brief Instance structure for the floating-point transposed direct form II biquad cascade
+*
+* @details Same layout as CMSIS-DSP. Per stage the coefficients are {b0, b1, b2, a1, a2}, with a1 and a2
+* negated compared to the usual notation, and the state holds 2 floats.
+*/
+typedef struct
+{
+    uint8_t numStages;
+    float32_t *pState;
+    const float32_t *pCoeffs;
+} arm_biquad_cascade_df2T_instance_f32;
+
+// Preconfigured instances (CMSIS arm_const_structs.h)
+extern const arm_cfft_instance_f32 arm_cfft_sR_f32_len16;
+extern const arm_cfft_instance_f32 arm_cfft_sR_f32_len32;
+extern const arm_cfft_instance_f32 arm_cfft_sR_f32_len64;
+extern const arm_cfft_instance_f32 arm_cfft_sR_f32_len128;
+extern const arm_cfft_instance_f32 arm_cfft_sR_f32_len256;
+extern const arm_cfft_instance_f32 arm_cfft_sR_f32_len512;
+extern const arm_cfft_instance_f32 arm_cfft_sR_f32_len1024;
+extern const arm_cfft_instance_f32 arm_cfft_sR_f32_len2048;
+extern const arm_cfft_instance_f32 arm_cfft_sR_f32_len4096;
+extern const arm_cfft_instance_q31 arm_cfft_sR_q31_len16;
+extern const arm_cfft_instance_q31 arm_cfft_sR_q31_len32;
+extern const arm_cfft_instance_q31 arm_cfft_sR_q31_len64;
+extern const arm_cfft_instance_q31 arm_cfft_sR_q31_len128;
+extern const arm_cfft_instance_q31 arm_cfft_sR_q31_len256;
+extern const arm_cfft_instance_q31 arm_cfft_sR_q31_len512;
+extern const arm_cfft_instance_q31 arm_cfft_sR_q31_len1024;
+extern const arm_cfft_instance_q31 arm_cfft_sR_q31_len2048;
+extern const arm_cfft_instance_q31 arm_cfft_sR_q31_len4096;
+
+// Function prototypes
+void arm_cfft_f32(const arm_cfft_instance_f32 *S, float32_t *p1, uint8_t ifftFlag, uint8_t bitReverseFlag);
+void arm_cfft_q31(const arm_cfft_instance_q31 *S, q31_t *p1, uint8_t ifftFlag, uint8_t bitReverseFlag);
+arm_status arm_rfft_fast_init_f32(arm_rfft_fast_instance_f32 *S, uint16_t fftLen);
+void arm_rfft_fast_f32(arm_rfft_fast_instance_f32 *S, float32_t *p, float32_t *pOut, uint8_t ifftFlag);
+void arm_cmplx_mag_f32(const float32_t *pSrc, float32_t *pDst, uint32_t numSamples);
+void arm_cmplx_mag_q31(const q31_t *pSrc, q31_t *pDst, uint32_t numSamples);
+void arm_cmplx_mult_real_f32(const float32_t *pSrcCmplx, const float32_t *pSrcReal, float32_t *pCmplxDst, uint32_t numSamples);
+void arm_biquad_cascade_df2T_init_f32(arm_biquad_cascade_df2T_instance_f32 *S, uint8_t numStages, const float32_t *pCoeffs, float32_t *pState);
+void arm_biquad_cascade_df2T_f32(const arm_biquad_cascade_df2T_instance_f32 *S, const float32_t *pSrc, float32_t *pDst, uint32_t blockSize);
+
+#endif // ARM_MATH_NATIVE_H
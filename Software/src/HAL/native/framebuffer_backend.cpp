@@ -0,0 +1,113 @@
+/**
+ * @file framebuffer_backend.cpp
+ * @brief Host display backend that renders into an image in memory
+ *
+ * @details This file contains the implementation of the framebuffer backend. The modelled transfer time
+ * is the number of bits divided by the SPI clock, the commands of a window are not counted.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+// Headers
+#include "framebuffer_backend.h"
+#include <cstdio>
+#include "HAL/cycle_counter.h"
+
+/*
+* @brief Constructor
+*
+* @param[in] clock  Modelled SPI clock in Hz, 0 makes every transfer finish immediately
+*/
+FramebufferBackend::FramebufferBackend(uint32_t clock)
+    : clock(clock), pixels(DISPLAY_WIDTH * DISPLAY_HEIGHT * 3, 0)
+{
+}
+
+/*
+* @brief Begin window function
+*
+* @param[in] rect   The window, the following pixels fill it row by row
+*/
+void FramebufferBackend::beginWindow(const DisplayRect &rect)
+{
+    window = rect;
+    position = 0;
+}
+
+/*
+* @brief Write pixels function
+*
+* @param[in] data   Pixels in the 18-bit transfer format
+* @param[in] bytes  Number of bytes
+*
+* @details Pixels beyond the end of the window wrap to its start, like on the controller.
+*/
+void FramebufferBackend::writePixels(const uint8_t *data, int bytes)
+{
+    const int count = bytes / DISPLAY_BYTES_PER_PIXEL;
+    const int windowPixels = window.width * window.height;
+
+    for (int i = 0; i < count; i++)
+    {
+        const int x = window.x + position % window.width;
+        const int y = window.y + position / window.width;
+        uint8_t *pixel = &pixels[(y * DISPLAY_WIDTH + x) * 3];
+        pixel[0] = data[0];
+        pixel[1] = data[1];
+        pixel[2] = data[2];
+        data += DISPLAY_BYTES_PER_PIXEL;
+        position = (position + 1) % windowPixels;
+    }
+
+    if (clock > 0)
+    {
+        busyStart = halCycleCount();
+        busyLength = (uint32_t)((uint64_t)bytes * 8 * halCyclesPerSecond() / clock);
+        busyTicks += busyLength;
+    }
+}
+
+/*
+* @brief Busy function
+*
+* @return True while the modelled transfer of the last chunk has not finished
+*/
+bool FramebufferBackend::busy() const
+{
+    return busyLength > 0 && halCycleCount() - busyStart < busyLength;
+}
+
+/*
+* @brief End window function
+*/
+void FramebufferBackend::endWindow()
+{
+    position = 0;
+}
+
+/*
+* @brief Write PPM function
+*
+* @param[in] path       The output file
+* @param[out] error     The reason when writing failed
+* @return True on success
+*/
+bool FramebufferBackend::writePpm(const char *path, std::string &error) const
+{
+    FILE *file = fopen(path, "wb");
+    if (!file)
+    {
+        error = std::string("cannot create ") + path;
+        return false;
+    }
+
+    fprintf(file, "P6\n%d %d\n255\n", DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    const bool written = fwrite(pixels.data(), 1, pixels.size(), file) == pixels.size();
+    fclose(file);
+
+    if (!written)
+        error = std::string("cannot write ") + path;
+    return written;
+}
@@ -0,0 +1,54 @@
+/**
+ * @file framebuffer_backend.h
+ * @brief Host display backend that renders into an image in memory
+ *
+ * @details This file contains the declaration of the display backend for the native build. It decodes the
+ * windows and pixel chunks exactly like the panel would into an RGB image, which can be saved as a PPM file.
+ * To measure the renderer like on the hardware, the backend can model the SPI bus: after a chunk it reports busy
+ * for the time the transfer would take at the configured clock.
+ *
+ * @note Only compiled for the native environments, see platformio.ini.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+#ifndef FRAMEBUFFER_BACKEND_H
+#define FRAMEBUFFER_BACKEND_H
+
+// Headers
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "UI/display_backend.h"
+
+/*
+* @class FramebufferBackend
+* @brief Display backend that writes into an RGB image
+*/
+class FramebufferBackend : public DisplayBackend
+{
+    public:
+        FramebufferBackend(uint32_t clock = 0);
+
+        void beginWindow(const DisplayRect &rect) override;
+        void writePixels(const uint8_t *data, int bytes) override;
+        bool busy() const override;
+        void endWindow() override;
+
+        bool writePpm(const char *path, std::string &error) const;
+        const std::vector<uint8_t>& image() const { return pixels; }
+        uint64_t transferTicks() const { return busyTicks; }
+
+    private:
+        uint32_t clock;                 // Modelled SPI clock in Hz, 0 for an infinitely fast bus
+        std::vector<uint8_t> pixels;    // DISPLAY_WIDTH * DISPLAY_HEIGHT RGB pixels
+        DisplayRect window = {};
+        int position = 0;               // Next pixel of the window
+        uint32_t busyStart = 0;
+        uint32_t busyLength = 0;        // halCycleCount() ticks
+        uint64_t busyTicks = 0;         // Total modelled transfer time
+};
+
+#endif // FRAMEBUFFER_BACKEND_H
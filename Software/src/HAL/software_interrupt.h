@@ -0,0 +1,66 @@
+/**
+ * @file software_interrupt.h
+ * @brief Hardware abstraction of the software interrupt that runs the DSP frames
+ *
+ * @details On the Teensy an interrupt vector of a peripheral that this project does not use is taken over and only
+ * ever triggered from software, like the Audio Library does with IRQ_SOFTWARE for its update chain. Its priority is
+ * below the audio interrupts and above thread level: the audio updates preempt a frame, a frame preempts loop().
+ * On the native build there are no interrupts, a trigger calls the handler directly.
+ *
+ * @note The vector can be changed with the build flag `-DHAL_FRAME_IRQ=...` if the camera interface is ever used.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+#ifndef SOFTWARE_INTERRUPT_H
+#define SOFTWARE_INTERRUPT_H
+
+// Headers
+#include <cstdint>
+#include "HAL/hal.h"
+
+// Defines
+#if defined(HAL_TARGET_TEENSY)
+    #ifndef HAL_FRAME_IRQ
+        #define HAL_FRAME_IRQ IRQ_CSI   // Camera sensor interface, not used by the vocoder
+    #endif
+    static const uint8_t HAL_FRAME_IRQ_PRIORITY = 240; // The audio update chain runs at 208, 255 is the lowest
+#else
+    inline void (*halFrameHandler)() = nullptr;
+#endif
+
+/*
+* @brief Attach frame interrupt function
+*
+* @param[in] handler    The interrupt handler
+*/
+static inline void halAttachFrameInterrupt(void (*handler)())
+{
+#if defined(HAL_TARGET_TEENSY)
+    attachInterruptVector((IRQ_NUMBER_t)HAL_FRAME_IRQ, handler);
+    NVIC_SET_PRIORITY(HAL_FRAME_IRQ, HAL_FRAME_IRQ_PRIORITY);
+    NVIC_ENABLE_IRQ(HAL_FRAME_IRQ);
+#else
+    halFrameHandler = handler;
+#endif
+}
+
+/*
+* @brief Trigger frame interrupt function
+*
+* @details Safe to call from any interrupt, the handler runs after all higher priority interrupts returned.
+* A trigger while the interrupt is already pending is merged with it.
+*/
+static inline void halTriggerFrameInterrupt()
+{
+#if defined(HAL_TARGET_TEENSY)
+    NVIC_SET_PENDING(HAL_FRAME_IRQ);
+#else
+    if (halFrameHandler)
+        halFrameHandler();
+#endif
+}
+
+#endif // SOFTWARE_INTERRUPT_H
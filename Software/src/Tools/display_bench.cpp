@@ -0,0 +1,226 @@
+/**
+ * @file display_bench.cpp
+ * @brief Display renderer benchmark for the native build
+ *
+ * @details This tool runs the display canvas and renderer against the framebuffer backend, so the cost
+ * of a screen update can be measured without a panel. Every scenario draws into the canvas like a screen would
+ * and then calls DisplayRenderer::service() until the panel is up to date, like loop() does.
+ *
+ * Per scenario the dirty rectangles, chunks and bytes sent are printed, together with the 99th percentile and the
+ * longest service() call (the time loop() is held up by the display) and the modelled SPI transfer time.
+ * On a desktop the longest call also includes the occasional preemption by the operating system.
+ * At the end the image of the backend is compared with the canvas.
+ *
+ * Usage: display_bench [--clock HZ] [--ppm FILE]
+ *
+ * With --clock the modelled SPI clock is set (default 24 MHz, 0 for an infinitely fast bus).
+ * With --ppm the final image is written as a PPM file.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+// Headers
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "UI/display_canvas.h"
+#include "UI/display_renderer.h"
+#include "HAL/native/framebuffer_backend.h"
+#include "HAL/cycle_counter.h"
+
+// Variables
+static const uint32_t DEFAULT_SPI_CLOCK = 24000000;
+static const uint16_t BLACK = 0x0000;
+static const uint16_t WHITE = 0xFFFF;
+static const uint16_t GREEN = 0x07E0;
+static const uint16_t BLUE = 0x001F;
+static const int ROW_HEIGHT = 10; // Text rows of the menu
+static const int ITEM_WIDTH = 160;
+
+static uint8_t canvasPixels[DISPLAY_WIDTH * DISPLAY_HEIGHT / 2];
+
+/*
+* @brief Draw text row function
+*
+* @param[in] canvas     The canvas
+* @param[in] row        The menu row
+* @param[in] length     Number of characters
+* @param[in] foreground The text color
+* @param[in] background The background color
+*
+* @details Stands in for a row of size 1 text: 6 x 8 pixel cells with a fixed glyph pattern, every pixel
+* is written once like Adafruit_GFX does for text with a background color. The rest of the row is cleared.
+*/
+static void drawTextRow(DisplayCanvas &canvas, int row, int length, uint16_t foreground, uint16_t background)
+{
+    const int top = row * ROW_HEIGHT + ROW_HEIGHT;
+    for (int y = 0; y < 8; y++)
+    {
+        for (int x = 0; x < length * 6; x++)
+        {
+            const bool glyph = (x % 6) >= 1 && (x % 6) <= 3 && y >= 1 && y <= 6;
+            canvas.setPixel(x, top + y, glyph ? foreground : background);
+        }
+    }
+    canvas.fill(length * 6, top, ITEM_WIDTH - length * 6, ROW_HEIGHT, BLACK);
+}
+
+/*
+* @brief Draw menu function
+*
+* @param[in] canvas     The canvas
+* @param[in] selected   The highlighted row
+* @param[in] clear      Clear the screen first, like ScreenMainMenu does after a full redraw request
+*
+* @details Redraws every item of the menu.
+*/
+static void drawMenu(DisplayCanvas &canvas, int selected, bool clear)
+{
+    static const int lengths[] = {8, 11, 14, 17, 16, 14};
+
+    if (clear)
+        canvas.fill(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT, BLACK);
+    for (int i = 0; i < 6; i++)
+    {
+        drawTextRow(canvas, i, lengths[i], (i == selected) ? BLACK : WHITE, (i == selected) ? WHITE : BLACK);
+    }
+}
+
+/*
+* @brief Run scenario function
+*
+* @param[in] name       The scenario name
+* @param[in] renderer   The renderer
+* @param[in] backend    The backend
+* @param[in] draw       Draws the scenario into the canvas
+*/
+static void runScenario(const char *name, DisplayRenderer &renderer, FramebufferBackend &backend, const std::function<void()> &draw)
+{
+    const double ticksPerMicrosecond = halCyclesPerSecond() / 1e6;
+
+    const uint32_t drawStart = halCycleCount();
+    draw();
+    const uint32_t drawTicks = halCycleCount() - drawStart;
+
+    renderer.resetStats();
+    const uint64_t transferStart = backend.transferTicks();
+    const uint32_t start = halCycleCount();
+    std::vector<uint32_t> calls;
+    bool working = true;
+
+    while (working)
+    {
+        const uint32_t callStart = halCycleCount();
+        working = renderer.service();
+        calls.push_back(halCycleCount() - callStart);
+    }
+
+    const uint32_t total = halCycleCount() - start;
+    std::sort(calls.begin(), calls.end());
+    const uint32_t p99 = calls[calls.size() * 99 / 100];
+    const DisplayStats &stats = renderer.stats();
+    printf("%-20s %6u %7u %9.1f %8.1f %9zu %8.1f %8.1f %8.2f %9.2f\n", name, (unsigned)stats.rects, (unsigned)stats.chunks,
+           stats.bytes / 1024.0, drawTicks / ticksPerMicrosecond, calls.size(), p99 / ticksPerMicrosecond,
+           calls.back() / ticksPerMicrosecond, (backend.transferTicks() - transferStart) / ticksPerMicrosecond / 1000.0,
+           total / ticksPerMicrosecond / 1000.0);
+}
+
+/*
+* @brief Image matches canvas function
+*
+* @param[in] canvas     The canvas
+* @param[in] backend    The backend
+* @return True when every pixel of the backend image has the canvas color
+*/
+static bool imageMatchesCanvas(const DisplayCanvas &canvas, const FramebufferBackend &backend)
+{
+    const std::vector<uint8_t> &image = backend.image();
+
+    for (int y = 0; y < DISPLAY_HEIGHT; y++)
+    {
+        for (int x = 0; x < DISPLAY_WIDTH; x++)
+        {
+            const uint16_t color = DisplayCanvas::paletteColor(canvas.pixelIndex(x, y));
+            const uint8_t *pixel = &image[(y * DISPLAY_WIDTH + x) * 3];
+            if (pixel[0] != (uint8_t)((color >> 11) << 3) || pixel[1] != (uint8_t)(((color >> 5) & 0x3F) << 2) ||
+                pixel[2] != (uint8_t)((color & 0x1F) << 3))
+                return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t clock = DEFAULT_SPI_CLOCK;
+    const char *ppmPath = nullptr;
+    int arg = 1;
+    for (; arg < argc; arg++)
+    {
+        if (strcmp(argv[arg], "--clock") == 0 && arg + 1 < argc)
+        {
+            clock = (uint32_t)strtoul(argv[++arg], nullptr, 10);
+        }
+        else if (strcmp(argv[arg], "--ppm") == 0 && arg + 1 < argc)
+        {
+            ppmPath = argv[++arg];
+        }
+        else
+        {
+            fprintf(stderr, "Usage: %s [--clock HZ] [--ppm FILE]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    DisplayCanvas canvas;
+    FramebufferBackend backend(clock);
+    DisplayRenderer renderer;
+    canvas.begin(canvasPixels);
+    renderer.begin(canvas, backend);
+
+    printf("SPI clock %.1f MHz, chunk %d pixels, tile %d pixels\n", clock / 1e6, DISPLAY_CHUNK_PIXELS, DISPLAY_TILE_SIZE);
+    printf("%-20s %6s %7s %9s %8s %9s %8s %8s %8s %9s\n", "scenario", "rects", "chunks", "kB", "draw us",
+           "calls", "p99 us", "max us", "spi ms", "total ms");
+
+    runScenario("boot", renderer, backend, [&]() { drawMenu(canvas, 0, true); });
+    runScenario("menu redraw", renderer, backend, [&]() { drawMenu(canvas, 0, false); });
+    runScenario("menu selection", renderer, backend, [&]()
+    {
+        drawTextRow(canvas, 0, 8, WHITE, BLACK);
+        drawTextRow(canvas, 1, 11, BLACK, WHITE);
+    });
+    runScenario("diagnostics values", renderer, backend, [&]()
+    {
+        for (int row = 1; row <= 3; row++)
+        {
+            canvas.fill(54, row * ROW_HEIGHT, 30, 8, BLACK);
+            canvas.fill(55 + row * 6, row * ROW_HEIGHT + 1, 3, 6, GREEN);
+        }
+    });
+    runScenario("full screen", renderer, backend, [&]() { canvas.fill(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT, BLUE); });
+
+    if (!imageMatchesCanvas(canvas, backend))
+    {
+        fprintf(stderr, "Error: the backend image differs from the canvas\n");
+        return 1;
+    }
+    printf("Backend image matches the canvas\n");
+
+    if (ppmPath)
+    {
+        std::string error;
+        if (!backend.writePpm(ppmPath, error))
+        {
+            fprintf(stderr, "Error: %s\n", error.c_str());
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,304 @@
+/**
+ * @file scheduler_sim.cpp
+ * @brief Deterministic simulation of the loop() scheduling policies for the native build
+ *
+ * @details This tool runs the TaskScheduler against a simulated clock: every task advances the clock by its modelled
+ * cost instead of doing work, and hops of audio arrive exactly every period. So a run is fully deterministic
+ * and independent of the speed of the host.
+ *
+ * The tasks model loop() of the vocoder: the DSP frame, the input manager with encoder bursts, the screen update
+ * and draw with regular refreshes and occasional full redraws, the display renderer and the telemetry report.
+ * Every scenario is run with three policies: the fixed order of the original loop() (input, update, draw, frame,
+ * display), the cooperative scheduler with the frame as deadline task, and the frame in an interrupt. In the last
+ * one a frame preempts the task that is running when its hop arrives, like the frame interrupt on the Teensy.
+ * The deadline misses and the response time (hop arrival to the end of the frame) are measured by the simulation
+ * itself from the true arrival times, the misses are also reported as seen by the scheduler.
+ *
+ * Usage: scheduler_sim [--seconds S]
+ *
+ * The tool fails when one of the scheduled policies misses a deadline, the modelled costs never exceed the task
+ * budgets, or when a frame interrupt does not respond within one frame time.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+// Headers
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "Core/task_scheduler.h"
+
+// Variables
+static const uint32_t PERIOD = 5805;            // us, a hop of 256 samples at 44.1 kHz
+static const uint32_t PASS_COST = 2;            // us, one pass of loop() without work
+static const uint32_t INPUT_COST = 5;
+static const uint32_t INPUT_EVENT_COST = 40;    // An encoder step moves the selection
+static const uint32_t UPDATE_COST = 10;
+static const uint32_t DRAW_COST = 800;          // Redraw of the changed values
+static const uint32_t FULL_DRAW_COST = 2500;    // Every tenth redraw clears the screen
+static const uint32_t CHUNK_COST = 25;          // One display chunk
+static const uint32_t TELEMETRY_COST = 400;
+static const uint32_t REFRESH_INTERVAL = 33000; // Screen refresh
+static const uint32_t BURST_INTERVAL = 250000;  // An encoder burst of `BURST_EVENTS` steps
+static const int BURST_EVENTS = 12;
+
+static uint32_t simTime = 0;
+static uint32_t frameCost = 0;
+static uint32_t framesDone = 0;
+static uint32_t misses = 0;
+static uint32_t maxLateness = 0;
+static uint32_t maxResponse = 0;
+static bool interruptMode = false;     // Frames preempt the tasks
+static bool inInterrupt = false;
+static TaskScheduler *activeScheduler = nullptr;
+static uint32_t lastRefresh = 0;
+static uint32_t lastBurst = 0;
+static int burstLeft = 0;
+static bool redrawPending = false;
+static uint32_t redraws = 0;
+static uint32_t chunksPending = 0;
+static uint32_t lastTelemetry = 0;
+
+/*
+* @brief Simulated clock function
+*
+* @return The simulated time in us
+*/
+static uint32_t simClock()
+{
+    return simTime;
+}
+
+/*
+* @brief Advance function
+*
+* @param[in] cost   The time the running code takes in us
+*
+* @details In interrupt mode every hop that arrives within `cost` is processed at its arrival,
+* the running code continues afterwards.
+*/
+static void advance(uint32_t cost)
+{
+    while (interruptMode && !inInterrupt)
+    {
+        const uint32_t arrival = (framesDone + 1) * PERIOD;
+        if (arrival > simTime + cost)
+            break;
+
+        const uint32_t before = (arrival > simTime) ? arrival - simTime : 0;
+        simTime += before;
+        cost -= before;
+        inInterrupt = true;
+        while (activeScheduler->runDeadlineTask())
+        {
+        }
+        inInterrupt = false;
+    }
+    simTime += cost;
+}
+
+static bool frameReady()
+{
+    return simTime >= (framesDone + 1) * PERIOD; // Frame n arrives at (n + 1) * PERIOD
+}
+
+static void runFrame()
+{
+    const uint32_t release = (framesDone + 1) * PERIOD;
+    advance(frameCost);
+    framesDone++;
+    maxResponse = (simTime - release > maxResponse) ? simTime - release : maxResponse;
+    if (simTime > release + PERIOD)
+    {
+        misses++;
+        maxLateness = (simTime - release - PERIOD > maxLateness) ? simTime - release - PERIOD : maxLateness;
+    }
+}
+
+static void runInput()
+{
+    advance(INPUT_COST);
+    if (burstLeft == 0 && simTime - lastBurst >= BURST_INTERVAL)
+    {
+        lastBurst = simTime;
+        burstLeft = BURST_EVENTS;
+    }
+    if (burstLeft > 0)
+    {
+        burstLeft--;
+        advance(INPUT_EVENT_COST);
+        redrawPending = true;
+    }
+}
+
+static void runUpdate()
+{
+    advance(UPDATE_COST);
+    if (simTime - lastRefresh >= REFRESH_INTERVAL)
+    {
+        lastRefresh = simTime;
+        redrawPending = true;
+    }
+}
+
+static void runDraw()
+{
+    if (!redrawPending)
+    {
+        advance(1);
+        return;
+    }
+    const uint32_t cost = (redraws % 10 == 0) ? FULL_DRAW_COST : DRAW_COST;
+    advance(cost);
+    chunksPending += cost / 10;
+    redrawPending = false;
+    redraws++;
+}
+
+static void runDisplay()
+{
+    advance((chunksPending > 0) ? CHUNK_COST : 1);
+    chunksPending -= (chunksPending > 0) ? 1 : 0;
+}
+
+static void runTelemetry()
+{
+    advance(TELEMETRY_COST);
+}
+
+/*
+* @brief Reset simulation function
+*
+* @param[in] load   The DSP load, frame cost over period
+*/
+static void resetSimulation(float load)
+{
+    simTime = 0;
+    frameCost = (uint32_t)(load * PERIOD);
+    framesDone = 0;
+    misses = 0;
+    maxLateness = 0;
+    maxResponse = 0;
+    interruptMode = false;
+    lastRefresh = 0;
+    lastBurst = 0;
+    burstLeft = 0;
+    redrawPending = true;
+    redraws = 0;
+    chunksPending = 0;
+    lastTelemetry = 0;
+}
+
+/*
+* @brief Run fixed order function
+*
+* @param[in] duration   Simulated time in us
+*
+* @details The loop() before the scheduler: everything once per pass, the frame after the screens.
+*/
+static void runFixedOrder(uint32_t duration)
+{
+    while (simTime < duration)
+    {
+        runInput();
+        runUpdate();
+        runDraw();
+        if (frameReady())
+            runFrame();
+        runDisplay();
+        if (simTime - lastTelemetry >= 1000000)
+        {
+            lastTelemetry = simTime;
+            runTelemetry();
+        }
+        advance(PASS_COST);
+    }
+}
+
+/*
+* @brief Run scheduled function
+*
+* @param[in] duration   Simulated time in us
+* @param[in] preemptive Run the frames as interrupt instead of from service()
+* @param[out] scheduler The scheduler, for its statistics
+*
+* @details The tasks with the priorities and budgets of main.cpp.
+*/
+static void runScheduled(uint32_t duration, bool preemptive, TaskScheduler &scheduler)
+{
+    interruptMode = preemptive;
+    activeScheduler = &scheduler;
+    scheduler.setDeadlineTask("dsp", frameReady, runFrame, preemptive);
+    scheduler.setPeriod(PERIOD);
+    scheduler.addTask("input", runInput, 0, INPUT_COST + INPUT_EVENT_COST);
+    scheduler.addTask("update", runUpdate, 1, UPDATE_COST);
+    scheduler.addTask("draw", runDraw, 2, FULL_DRAW_COST);
+    scheduler.addTask("display", runDisplay, 3, CHUNK_COST);
+    scheduler.addTask("telemetry", runTelemetry, 4, TELEMETRY_COST, 1000000);
+
+    while (simTime < duration)
+    {
+        scheduler.service();
+        advance(PASS_COST);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    float seconds = 10.0f;
+    for (int arg = 1; arg < argc; arg++)
+    {
+        if (strcmp(argv[arg], "--seconds") == 0 && arg + 1 < argc)
+        {
+            seconds = (float)atof(argv[++arg]);
+        }
+        else
+        {
+            fprintf(stderr, "Usage: %s [--seconds S]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    const uint32_t duration = (uint32_t)(seconds * 1e6f);
+    const float loads[] = {0.5f, 0.65f, 0.75f, 0.9f};
+    bool failed = false;
+
+    printf("period %u us, %.1f s simulated\n", (unsigned)PERIOD, seconds);
+    printf("%-6s %-10s %7s %7s %9s %9s %8s %8s %9s\n", "load", "policy", "frames", "misses", "late us", "resp us",
+           "redraws", "sched", "deferred");
+
+    for (float load : loads)
+    {
+        resetSimulation(load);
+        runFixedOrder(duration);
+        printf("%-6.2f %-10s %7u %7u %9u %9u %8u %8s %9s\n", load, "fixed", (unsigned)framesDone, (unsigned)misses,
+               (unsigned)maxLateness, (unsigned)maxResponse, (unsigned)redraws, "-", "-");
+
+        for (int preemptive = 0; preemptive < 2; preemptive++)
+        {
+            resetSimulation(load);
+            TaskScheduler scheduler(simClock);
+            runScheduled(duration, preemptive != 0, scheduler);
+            uint32_t deferred = 0;
+            for (int i = 0; i < scheduler.taskCount(); i++)
+            {
+                deferred += scheduler.taskStats(i).deferred;
+            }
+            printf("%-6.2f %-10s %7u %7u %9u %9u %8u %8u %9u\n", load, preemptive ? "interrupt" : "scheduler",
+                   (unsigned)framesDone, (unsigned)misses, (unsigned)maxLateness, (unsigned)maxResponse, (unsigned)redraws,
+                   (unsigned)scheduler.deadlineStats().misses, (unsigned)deferred);
+
+            failed = failed || misses > 0 || scheduler.deadlineStats().misses != misses;
+            failed = failed || (preemptive && maxResponse > frameCost);
+        }
+    }
+
+    if (failed)
+    {
+        fprintf(stderr, "Error: a scheduled policy missed a deadline or responded late\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,400 @@
+/**
+ * @file vocoder_bench.cpp
+ * @brief DSP microbenchmarks for the native build
+ *
+ * @details This tool times the hot DSP kernels and the complete vocoder frame for every FFT size
+ * that getFFTConfig() supports. Like Google Benchmark, every benchmark is run with a growing number
+ * of iterations until it takes at least the minimum time, this is repeated and the median is reported.
+ *
+ * Every kernel runs once (or twice, for carrier and modulator) per hop, so the real-time factor is the
+ * hop period divided by the time per call. Samples per second counts the hop samples.
+ *
+ * Usage: vocoder_bench [--filter TEXT] [--min-time SECONDS] [--json FILE] [--baseline FILE] [--threshold PERCENT]
+ *
+ * With --json the results are written as JSON. With --baseline the results are compared with an earlier
+ * JSON file and the tool exits with code 1 when a benchmark is more than --threshold percent (default 10) slower.
+ * The comparison uses the fastest repetition, interference from other processes only ever adds time.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+// Headers
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "DSP/vocoder.h"
+#include "DSP/fft_utils.h"
+#include "DSP/utils.h"
+#include "DSP/biquad_filter.h"
+#include "DSP/spectral_kernel.h"
+#include "DSP/phase_vocoder.h"
+
+// Variables
+static const float SAMPLE_RATE = 44100.0f;
+static const int REPETITIONS = 5;
+
+struct BenchmarkResult
+{
+    std::string name;
+    int fftSize;
+    long iterations;
+    double nsPerFrame;
+    double nsPerFrameMin;
+    double samplesPerSecond;
+    double realTimeFactor;
+};
+
+// Inputs, filled once per FFT size
+static int16_t carrierSamples[MAX_FFT_SIZE];
+static int16_t modulatorSamples[MAX_FFT_SIZE];
+static int16_t roomSamples[MAX_FFT_SIZE];
+static float window[MAX_FFT_SIZE];
+static float carrierFrame[MAX_FFT_SIZE];
+static float carrierSpectrum[MAX_FFT_SIZE];
+static float carrierMag[MAX_FFT_SIZE / 2 + 1];
+static float modulatorMag[MAX_FFT_SIZE / 2 + 1];
+
+// Scratch buffers
+static float scratch[MAX_FFT_SIZE];
+static float scratchSpectrum[MAX_FFT_SIZE];
+static float scratchMagnitude[MAX_FFT_SIZE / 2 + 1];
+static float scratchPhase[MAX_FFT_SIZE / 2 + 1];
+static float scratchGain[MAX_FFT_SIZE / 2 + 1];
+static int16_t scratchSamples[MAX_FFT_SIZE];
+static BiquadFilter benchHighpass;
+static PhaseVocoder benchShifter;
+static float shifterPhases[MAX_CARRIER_VOICES * 2 * (MAX_FFT_SIZE / 2 + 1)];
+static float shifterAdvance[MAX_FFT_SIZE / 2 + 1];
+static float shifterAnalysisPhase[MAX_FFT_SIZE / 2 + 1];
+static float shifterSynthesisPhase[MAX_FFT_SIZE / 2 + 1];
+static int16_t shifterPeaks[MAX_FFT_SIZE / 4 + 1];
+
+/*
+* @brief Clobber memory function
+*
+* @details Keeps the compiler from optimizing away results that are only written to memory.
+*/
+static inline void clobberMemory()
+{
+    asm volatile("" ::: "memory");
+}
+
+/*
+* @brief Fill inputs function
+*
+* @details This function fills the inputs for the active FFT size with a sawtooth carrier and a
+* voiced (harmonic) modulator, so inverseFFT() takes the same path as for speech.
+* The room noise of a few LSB is a pause of the speaker, it is below the threshold of the noise gate.
+*/
+static void fillInputs()
+{
+    NoiseGenerator noise;
+    for (int i = 0; i < fftSize; i++)
+    {
+        float phase = fmodf(i * 110.0f / SAMPLE_RATE, 1.0f);
+        carrierSamples[i] = (int16_t)(12000.0f * (2.0f * phase - 1.0f));
+
+        float voice = 0.0f;
+        for (int k = 1; k <= 12; k++)
+        {
+            voice += sinf(2.0f * PI * 150.0f * k * i / SAMPLE_RATE) / k;
+        }
+        modulatorSamples[i] = (int16_t)(6000.0f * voice);
+        roomSamples[i] = (int16_t)lrintf(4.0f * noise.uniform());
+        window[i] = 0.5f - 0.5f * cosf(2.0f * PI * i / fftSize);
+    }
+
+    convertInt16ToFloat(carrierSamples, carrierFrame, window);
+    memcpy(scratch, carrierFrame, sizeof(float) * fftSize);
+    processFFT(scratch, carrierSpectrum, carrierMag);
+
+    convertInt16ToFloat(modulatorSamples, scratch, window);
+    processFFT(scratch, scratchSpectrum, modulatorMag);
+}
+
+/*
+* @brief Run benchmark function
+*
+* @param[in] name       The benchmark name
+* @param[in] minTime    Minimum time per repetition in seconds
+* @param[in] body       One frame of work
+* @return The median result of the repetitions, and the fastest repetition
+*/
+static BenchmarkResult runBenchmark(const std::string &name, double minTime, const std::function<void()> &body)
+{
+    using Clock = std::chrono::steady_clock;
+    std::vector<double> nsPerFrame;
+    long iterations = 1;
+
+    for (int i = 0; i < 3; i++) // Warm up caches and branch predictors
+        body();
+
+    for (int repetition = 0; repetition < REPETITIONS; repetition++)
+    {
+        while (true)
+        {
+            auto start = Clock::now();
+            for (long i = 0; i < iterations; i++)
+            {
+                body();
+                clobberMemory();
+            }
+            double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+            if (seconds >= minTime)
+            {
+                nsPerFrame.push_back(seconds * 1e9 / iterations);
+                break;
+            }
+            // Aim for 1.4x the minimum time on the next try, like Google Benchmark
+            double scale = (seconds > minTime / 100.0) ? 1.4 * minTime / seconds : 10.0;
+            iterations = std::max(iterations + 1, (long)(iterations * std::min(scale, 10.0)));
+        }
+    }
+
+    std::sort(nsPerFrame.begin(), nsPerFrame.end());
+    BenchmarkResult result;
+    result.name = name + "/" + std::to_string(fftSize);
+    result.fftSize = fftSize;
+    result.iterations = iterations;
+    result.nsPerFrame = nsPerFrame[REPETITIONS / 2];
+    result.nsPerFrameMin = nsPerFrame[0];
+    result.samplesPerSecond = hopSize * 1e9 / result.nsPerFrame;
+    result.realTimeFactor = result.samplesPerSecond / SAMPLE_RATE;
+    return result;
+}
+
+/*
+* @brief Write JSON function
+*
+* @param[in] path       The output file
+* @param[in] results    The benchmark results
+* @param[in] minTime    Minimum time per repetition in seconds
+* @return False when the file could not be written
+*/
+static bool writeJson(const char *path, const std::vector<BenchmarkResult> &results, double minTime)
+{
+    FILE *file = fopen(path, "w");
+    if (!file)
+        return false;
+
+    char date[32];
+    time_t now = time(nullptr);
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+
+    fprintf(file, "{\n  \"context\": {\n");
+    fprintf(file, "    \"date\": \"%s\",\n    \"sample_rate\": %.0f,\n", date, SAMPLE_RATE);
+    fprintf(file, "    \"repetitions\": %d,\n    \"min_time\": %.3f\n  },\n", REPETITIONS, minTime);
+    fprintf(file, "  \"benchmarks\": [\n");
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const BenchmarkResult &r = results[i];
+        fprintf(file, "    {\"name\": \"%s\", \"fft_size\": %d, \"iterations\": %ld, \"ns_per_frame\": %.1f, \"ns_per_frame_min\": %.1f, "
+                      "\"samples_per_second\": %.0f, \"real_time_factor\": %.2f}%s\n",
+                r.name.c_str(), r.fftSize, r.iterations, r.nsPerFrame, r.nsPerFrameMin, r.samplesPerSecond, r.realTimeFactor,
+                (i + 1 < results.size()) ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+    return fclose(file) == 0;
+}
+
+/*
+* @brief Read baseline function
+*
+* @param[in] path       A JSON file written by writeJson()
+* @param[out] names     The benchmark names
+* @param[out] times     The fastest ns per frame of each benchmark
+* @return False when the file could not be read
+*
+* @details Only the format written by this tool is supported, every benchmark is on its own line.
+*/
+static bool readBaseline(const char *path, std::vector<std::string> &names, std::vector<double> &times)
+{
+    FILE *file = fopen(path, "r");
+    if (!file)
+        return false;
+
+    char line[512];
+    while (fgets(line, sizeof(line), file))
+    {
+        const char *name = strstr(line, "\"name\": \"");
+        const char *time = strstr(line, "\"ns_per_frame_min\": ");
+        if (!name || !time)
+            continue;
+
+        name += strlen("\"name\": \"");
+        const char *end = strchr(name, '"');
+        if (!end)
+            continue;
+
+        names.push_back(std::string(name, end));
+        times.push_back(atof(time + strlen("\"ns_per_frame_min\": ")));
+    }
+    fclose(file);
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    const char *filter = nullptr;
+    const char *jsonPath = nullptr;
+    const char *baselinePath = nullptr;
+    double minTime = 0.1;
+    double threshold = 10.0;
+
+    for (int arg = 1; arg < argc; arg++)
+    {
+        bool hasValue = arg + 1 < argc;
+        if (strcmp(argv[arg], "--filter") == 0 && hasValue)
+            filter = argv[++arg];
+        else if (strcmp(argv[arg], "--min-time") == 0 && hasValue)
+            minTime = atof(argv[++arg]);
+        else if (strcmp(argv[arg], "--json") == 0 && hasValue)
+            jsonPath = argv[++arg];
+        else if (strcmp(argv[arg], "--baseline") == 0 && hasValue)
+            baselinePath = argv[++arg];
+        else if (strcmp(argv[arg], "--threshold") == 0 && hasValue)
+            threshold = atof(argv[++arg]);
+        else
+        {
+            fprintf(stderr, "Usage: %s [--filter TEXT] [--min-time SECONDS] [--json FILE] [--baseline FILE] [--threshold PERCENT]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    benchShifter.begin(MAX_FFT_SIZE, shifterPhases, shifterAdvance, shifterAnalysisPhase, shifterSynthesisPhase, shifterPeaks);
+
+    std::vector<BenchmarkResult> results;
+    printf("%-32s %12s %14s %10s\n", "benchmark", "ns/frame", "samples/s", "x realtime");
+
+    for (int size = MIN_FFT_SIZE; size <= MAX_FFT_SIZE; size *= 2)
+    {
+        if (!initVocoder(size))
+        {
+            fprintf(stderr, "Error: invalid vocoder configuration (FFT size %d)\n", size);
+            return 1;
+        }
+        fillInputs();
+        benchHighpass.begin(FilterType::Highpass, 2, 100.0f, SAMPLE_RATE);
+        benchShifter.setFrameSize(fftSize, hopSize);
+        benchShifter.setPitchRatio(1.4983071f);
+
+        std::vector<std::pair<std::string, std::function<void()>>> benchmarks =
+        {
+            {"modulatorHighpass", []() {
+                convertHopToFloat(modulatorSamples, scratch, hopSize);
+                benchHighpass.process(scratch, hopSize);
+                convertHopToInt16(scratch, scratchSamples, hopSize);
+            }},
+            {"convertInt16ToFloat", []() {
+                convertInt16ToFloat(carrierSamples, scratch, window);
+            }},
+            {"processFFT", []() { // Includes restoring the frame, the FFT overwrites its input
+                memcpy(scratch, carrierFrame, sizeof(float) * fftSize);
+                processFFT(scratch, scratchSpectrum, scratchMagnitude);
+            }},
+            {"getMagnitudeAndPhase", []() {
+                getMagnitudeAndPhase(carrierSpectrum, scratchMagnitude, scratchPhase);
+            }},
+            {"classifyVoicing", []() {
+                scratchGain[0] = voicingDetector.classify(modulatorMag);
+            }},
+            {"pitchShift", []() { // A fifth up, including the magnitude of the shifted spectrum
+                benchShifter.shift(0, carrierSpectrum, carrierMag, scratchSpectrum);
+                computeMagnitude(scratchSpectrum, scratchMagnitude, fftSize);
+            }},
+            {"inverseFFT", []() { // Includes restoring the spectrum, it is vocoded in place
+                memcpy(scratchSpectrum, carrierSpectrum, sizeof(float) * fftSize);
+                inverseFFT(scratchSpectrum, scratch, carrierMag, modulatorMag, scratchGain);
+            }},
+            {"convertFloatToInt16", []() {
+                convertFloatToInt16(carrierFrame, scratchSamples, hopSize);
+            }},
+            {"processVocoderFrame", []() {
+                setVocoderEngine(VocoderEngine::FFT);
+                setCarrierVoices(1);
+                memcpy(carrierBuffers[0], carrierSamples, sizeof(int16_t) * hopSize);
+                memcpy(modulatorBuffer, modulatorSamples, sizeof(int16_t) * hopSize);
+                processVocoderFrame();
+            }},
+            {"processVocoderFrameStereo", []() { // Two carrier voices, the modulator is analyzed once
+                setVocoderEngine(VocoderEngine::FFT);
+                setCarrierVoices(2);
+                memcpy(carrierBuffers[0], carrierSamples, sizeof(int16_t) * hopSize);
+                memcpy(carrierBuffers[1], carrierSamples, sizeof(int16_t) * hopSize);
+                memcpy(modulatorBuffer, modulatorSamples, sizeof(int16_t) * hopSize);
+                processVocoderFrame();
+            }},
+            {"processVocoderFrameGated", []() { // Room noise only, the closed noise gate skips the frame
+                setVocoderEngine(VocoderEngine::FFT);
+                setCarrierVoices(1);
+                memcpy(carrierBuffers[0], carrierSamples, sizeof(int16_t) * hopSize);
+                memcpy(modulatorBuffer, roomSamples, sizeof(int16_t) * hopSize);
+                processVocoderFrame();
+            }},
+            {"processVocoderFrameQ31", []() { // setVocoderEngine() returns early once the engine is active
+                setVocoderEngine(VocoderEngine::FixedPoint);
+                setCarrierVoices(1);
+                memcpy(carrierBuffers[0], carrierSamples, sizeof(int16_t) * hopSize);
+                memcpy(modulatorBuffer, modulatorSamples, sizeof(int16_t) * hopSize);
+                processVocoderFrame();
+            }},
+        };
+
+        for (auto &benchmark : benchmarks)
+        {
+            if (filter && (benchmark.first + "/" + std::to_string(size)).find(filter) == std::string::npos)
+                continue;
+
+            BenchmarkResult result = runBenchmark(benchmark.first, minTime, benchmark.second);
+            printf("%-32s %12.1f %14.0f %10.1f\n", result.name.c_str(), result.nsPerFrame, result.samplesPerSecond, result.realTimeFactor);
+            results.push_back(result);
+        }
+    }
+
+    if (jsonPath && !writeJson(jsonPath, results, minTime))
+    {
+        fprintf(stderr, "Error: could not write %s\n", jsonPath);
+        return 1;
+    }
+
+    if (!baselinePath)
+        return 0;
+
+    std::vector<std::string> names;
+    std::vector<double> times;
+    if (!readBaseline(baselinePath, names, times))
+    {
+        fprintf(stderr, "Error: could not read %s\n", baselinePath);
+        return 1;
+    }
+
+    int regressions = 0;
+    for (const BenchmarkResult &result : results)
+    {
+        auto match = std::find(names.begin(), names.end(), result.name);
+        if (match == names.end())
+            continue;
+
+        double baseline = times[match - names.begin()];
+        double change = 100.0 * (result.nsPerFrameMin - baseline) / baseline;
+        if (change > threshold)
+        {
+            printf("REGRESSION %-32s %10.1f -> %10.1f ns/frame (+%.1f%%)\n", result.name.c_str(), baseline, result.nsPerFrameMin, change);
+            regressions++;
+        }
+    }
+
+    printf("%d of %zu benchmarks regressed by more than %.1f%%\n", regressions, results.size(), threshold);
+    return regressions ? 1 : 0;
+}
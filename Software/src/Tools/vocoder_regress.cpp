@@ -0,0 +1,708 @@
+/**
+ * @file vocoder_regress.cpp
+ * @brief Golden-output regression harness for the native build
+ *
+ * @details This tool renders a fixed corpus of carrier/modulator pairs through every engine and FFT size and
+ * compares the output with golden outputs stored as WAV files. The corpus is generated in code, deterministically:
+ * a logarithmic sine sweep, white noise, an impulse train and synthetic speech (vowels from a glottal pulse train
+ * through formant resonators, fricatives from filtered noise and pauses). Every case starts from initVocoder(),
+ * so a case renders the same with or without the others.
+ *
+ * Per case the tool prints the SNR against the golden output, the log-spectral distance (the rms difference of the
+ * short-time spectra in dB, averaged over the frames that are not silent) and the largest sample error.
+ * A case passes when all three are within the tolerance of its engine, or with --exact when the output is
+ * bit-identical. A faster kernel can then be accepted when it only changes the output within the tolerance.
+ *
+ * The FFT engines also render a sustained quiet modulator, a 200 Hz tone at `GATE_CHECK_LEVEL` under a sawtooth carrier.
+ * However steady, it is signal and not room noise: the noise gate may not skip a single frame of it and the output
+ * may not fall silent. And they switch to the filter bank and back: after the switch the output must be bit-identical
+ * to a fresh render, nothing from before the switch may be heard. These checks need no golden output, they run with --golden.
+ *
+ * Usage: vocoder_regress (--update DIR | --golden DIR) [--filter TEXT] [--exact] [--snr DB] [--lsd DB] [--max-error N]
+ *
+ * With --update the golden outputs are (re)written to DIR, run it once on the reference version.
+ * With --golden the outputs are compared with the ones in DIR, the tool exits with code 1 when a case fails.
+ * With --filter only the cases whose name contains TEXT are run, for example "q31" or "speech_fft_1024".
+ * With --snr, --lsd and --max-error the tolerance of all engines is overridden.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+// Headers
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+
+#include "DSP/vocoder.h"
+#include "DSP/fft_utils.h"
+#include "DSP/spectral_kernel.h"
+#include "Tools/wav_io.h"
+
+// Variables
+static const float SAMPLE_RATE = 44100.0f;
+static const int BLOCK_SIZE = 128;                  // AUDIO_BLOCK_SAMPLES, for the filter bank
+static const int CORPUS_LENGTH = 44100;             // One second per signal
+static const int DISTANCE_FRAME = 1024;             // Frame of the log-spectral distance, half overlapping
+static const double DISTANCE_RANGE = 1e-6;          // Bins more than 60 dB below the frame peak are clamped
+static const double DISTANCE_FLOOR = 3200.0;        // And bins within 20 dB of the 16-bit rounding noise, 1/12 * sum(w^2)
+static const double SILENCE_LEVEL = 1e-7 * 32768.0 * 32768.0; // Frames below -70 dBFS are skipped
+static const int GATE_CHECK_LENGTH = 12 * 44100;    // Samples, the gate adapts over seconds
+static const float GATE_CHECK_LEVEL = -35.0f;       // dBFS RMS of the quiet modulator
+
+/*
+* @struct Tolerance
+* @brief The largest accepted difference with the golden output
+*/
+struct Tolerance
+{
+    double minSnr;              // dB
+    double maxDistance;         // Log-spectral distance in dB
+    int maxError;               // Samples
+};
+
+/*
+* @struct EngineCase
+* @brief An engine with its tolerance, the FFT engines run at every supported size
+*/
+struct EngineCase
+{
+    const char *name;
+    VocoderEngine engine;
+    Tolerance tolerance;
+};
+
+/*
+* @struct SignalPair
+* @brief A carrier and a modulator signal of the corpus
+*/
+struct SignalPair
+{
+    const char *name;
+    const std::vector<int16_t> *carrier;
+    const std::vector<int16_t> *modulator;
+};
+
+/*
+* @struct Comparison
+* @brief The differences of an output with its golden output
+*/
+struct Comparison
+{
+    double snr;
+    double distance;
+    int maxError;
+};
+
+// The float engine is the reference for the others, the fixed-point engine has its own rounding
+static const EngineCase ENGINES[] =
+{
+    {"fft",         VocoderEngine::FFT,         {50.0, 0.5, 128}},
+    {"q31",         VocoderEngine::FixedPoint,  {45.0, 1.0, 256}},
+    {"filterbank",  VocoderEngine::FilterBank,  {45.0, 0.5, 16}},   // Quiet output, one step is already -50 dB
+};
+
+// Corpus, generated once
+static std::vector<int16_t> sweepSignal;
+static std::vector<int16_t> noiseSignal;
+static std::vector<int16_t> impulseSignal;
+static std::vector<int16_t> speechSignal;
+static std::vector<int16_t> sawtoothSignal;
+static std::vector<int16_t> quietSignal;
+
+/*
+* @brief To int16 function
+*
+* @param[in] value  The sample, full scale is 1
+* @return The saturated 16-bit sample
+*/
+static int16_t toInt16(float value)
+{
+    const float scaled = roundf(value * 32767.0f);
+    return (int16_t)((scaled > 32767.0f) ? 32767.0f : (scaled < -32768.0f) ? -32768.0f : scaled);
+}
+
+/*
+* @brief Generate sweep function
+*
+* @param[out] signal    A logarithmic sine sweep from 50 Hz to 16 kHz at half scale
+*/
+static void generateSweep(std::vector<int16_t> &signal)
+{
+    const double startHz = 50.0;
+    const double rate = log(16000.0 / startHz) / CORPUS_LENGTH; // Per sample
+    signal.resize(CORPUS_LENGTH);
+    for (int i = 0; i < CORPUS_LENGTH; i++)
+    {
+        const double phase = 2.0 * M_PI * startHz / SAMPLE_RATE * (exp(rate * i) - 1.0) / rate;
+        signal[i] = toInt16(0.5f * (float)sin(phase));
+    }
+}
+
+/*
+* @brief Generate noise function
+*
+* @param[out] signal    Uniform white noise at 0.3 of full scale
+*/
+static void generateNoise(std::vector<int16_t> &signal)
+{
+    NoiseGenerator noise;
+    noise.seed(0x1234567);
+    signal.resize(CORPUS_LENGTH);
+    for (int i = 0; i < CORPUS_LENGTH; i++)
+    {
+        signal[i] = toInt16(0.3f * noise.uniform());
+    }
+}
+
+/*
+* @brief Generate impulses function
+*
+* @param[out] signal    An impulse train at 110 Hz, one sample per period
+*/
+static void generateImpulses(std::vector<int16_t> &signal)
+{
+    const int period = (int)(SAMPLE_RATE / 110.0f);
+    signal.assign(CORPUS_LENGTH, 0);
+    for (int i = 0; i < CORPUS_LENGTH; i += period)
+    {
+        signal[i] = 26000;
+    }
+}
+
+/*
+* @brief Generate gate check function
+*
+* @param[out] carrier   A 110 Hz sawtooth at half scale, `GATE_CHECK_LENGTH` samples
+* @param[out] modulator A 200 Hz sine at `GATE_CHECK_LEVEL`, `GATE_CHECK_LENGTH` samples
+*/
+static void generateGateCheck(std::vector<int16_t> &carrier, std::vector<int16_t> &modulator)
+{
+    const float amplitude = sqrtf(2.0f) * powf(10.0f, GATE_CHECK_LEVEL / 20.0f);
+    carrier.resize(GATE_CHECK_LENGTH);
+    modulator.resize(GATE_CHECK_LENGTH);
+    for (int i = 0; i < GATE_CHECK_LENGTH; i++)
+    {
+        carrier[i] = toInt16(0.5f * (2.0f * fmodf(i * 110.0f / SAMPLE_RATE, 1.0f) - 1.0f));
+        modulator[i] = toInt16(amplitude * sinf(2.0f * (float)M_PI * fmodf(i * 200.0f / SAMPLE_RATE, 1.0f)));
+    }
+}
+
+/*
+* @brief Generate speech function
+*
+* @param[out] signal    Synthetic speech: vowels, fricatives and a pause
+*
+* @details Vowels are a glottal pulse train at 120 Hz with a 5 Hz vibrato through three formant resonators,
+* fricatives are noise through the same resonators tuned high. Every segment fades in and out over 10 ms.
+*/
+static void generateSpeech(std::vector<int16_t> &signal)
+{
+    struct Segment
+    {
+        float length;       // s
+        bool voiced;
+        float level;        // 0 is a pause
+        float formants[3];  // Hz
+        float bandwidth;    // Hz
+    };
+    static const Segment SEGMENTS[] =
+    {
+        {0.20f, true,  1.0f,  {730.0f, 1090.0f, 2440.0f}, 90.0f},   // a
+        {0.12f, false, 0.5f,  {4500.0f, 6000.0f, 7500.0f}, 1500.0f}, // s
+        {0.20f, true,  1.0f,  {270.0f, 2290.0f, 3010.0f}, 90.0f},   // i
+        {0.08f, false, 0.0f,  {500.0f, 1500.0f, 2500.0f}, 90.0f},   // pause
+        {0.12f, false, 0.3f,  {1500.0f, 3500.0f, 6000.0f}, 2000.0f}, // f
+        {0.28f, true,  1.0f,  {300.0f, 870.0f, 2240.0f}, 90.0f},    // u
+    };
+
+    NoiseGenerator noise;
+    noise.seed(0x7654321);
+    float state[3][2] = {};
+    float glottalPhase = 0.0f;
+    float peak = 0.0f;
+    std::vector<float> speech(CORPUS_LENGTH, 0.0f);
+
+    int start = 0;
+    for (const Segment &segment : SEGMENTS)
+    {
+        const int length = (int)(segment.length * SAMPLE_RATE);
+        const int fade = (int)(0.01f * SAMPLE_RATE);
+
+        float a1[3], a2[3], gain[3];
+        for (int f = 0; f < 3; f++)
+        {
+            const float radius = expf(-(float)M_PI * segment.bandwidth / SAMPLE_RATE);
+            a1[f] = 2.0f * radius * cosf(2.0f * (float)M_PI * segment.formants[f] / SAMPLE_RATE);
+            a2[f] = -radius * radius;
+            gain[f] = 1.0f - radius;
+        }
+
+        for (int i = 0; i < length && start + i < CORPUS_LENGTH; i++)
+        {
+            const int t = start + i;
+            float excitation;
+            if (segment.voiced)
+            {
+                const float f0 = 120.0f * (1.0f + 0.03f * sinf(2.0f * (float)M_PI * 5.0f * t / SAMPLE_RATE));
+                glottalPhase += f0 / SAMPLE_RATE;
+                excitation = (glottalPhase >= 1.0f) ? 1.0f : 0.0f;
+                glottalPhase -= (glottalPhase >= 1.0f) ? 1.0f : 0.0f;
+            }
+            else
+            {
+                excitation = 0.05f * noise.uniform();
+            }
+
+            // Three resonators in parallel, a cascade of three narrow ones would need a per-vowel gain
+            float value = 0.0f;
+            for (int f = 0; f < 3; f++)
+            {
+                const float y = gain[f] * excitation + a1[f] * state[f][0] + a2[f] * state[f][1];
+                state[f][1] = state[f][0];
+                state[f][0] = y;
+                value += y;
+            }
+
+            const float envelope = std::min(1.0f, std::min((float)i / fade, (float)(length - i) / fade));
+            speech[t] = segment.level * envelope * value;
+            peak = std::max(peak, fabsf(speech[t]));
+        }
+        start += length;
+    }
+
+    signal.resize(CORPUS_LENGTH);
+    for (int i = 0; i < CORPUS_LENGTH; i++)
+    {
+        signal[i] = toInt16(0.5f * speech[i] / peak);
+    }
+}
+
+/*
+* @brief Copy hop function
+*
+* @param[in] source     The source samples
+* @param[in] offset     Index of the first sample of the hop
+* @param[in] size       Number of samples in the hop
+* @param[out] hop       The hop buffer, zero padded past the end of the source
+*/
+static void copyHop(const std::vector<int16_t> &source, size_t offset, int size, int16_t *hop)
+{
+    for (int i = 0; i < size; i++)
+    {
+        hop[i] = (offset + i < source.size()) ? source[offset + i] : 0;
+    }
+}
+
+/*
+* @brief Render blocks function
+*
+* @param[in] pair       The carrier and the modulator
+* @param[out] output    The mono output
+*
+* @details The filter bank runs in blocks of 128 samples, like in the audio interrupt.
+*/
+static void renderBlocks(const SignalPair &pair, WavData &output)
+{
+    const std::vector<int16_t> &carrier = *pair.carrier;
+    const std::vector<int16_t> &modulator = *pair.modulator;
+    const size_t blocks = (carrier.size() + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    int16_t carrierBlock[BLOCK_SIZE];
+    int16_t modulatorBlock[BLOCK_SIZE];
+
+    output.sampleRate = (uint32_t)SAMPLE_RATE;
+    output.channels = 1;
+    output.samples.resize(blocks * BLOCK_SIZE);
+    for (size_t block = 0; block < blocks; block++)
+    {
+        copyHop(carrier, block * BLOCK_SIZE, BLOCK_SIZE, carrierBlock);
+        copyHop(modulator, block * BLOCK_SIZE, BLOCK_SIZE, modulatorBlock);
+        filterBankVocoder.process(carrierBlock, modulatorBlock, &output.samples[block * BLOCK_SIZE], BLOCK_SIZE);
+    }
+}
+
+/*
+* @brief Render hops function
+*
+* @param[in] pair       The carrier and the modulator
+* @param[out] output    The stereo output
+*
+* @details Like the render tool, the FFT engines run hop by hop past the end of the input until the latency is flushed.
+*/
+static void renderHops(const SignalPair &pair, WavData &output)
+{
+    const std::vector<int16_t> &carrier = *pair.carrier;
+    const std::vector<int16_t> &modulator = *pair.modulator;
+    const size_t hops = (carrier.size() + vocoderLatency() + hopSize - 1) / hopSize;
+
+    output.sampleRate = (uint32_t)SAMPLE_RATE;
+    output.channels = 2;
+    output.samples.resize(2 * hops * hopSize);
+    for (size_t hop = 0; hop < hops; hop++)
+    {
+        copyHop(carrier, hop * hopSize, hopSize, carrierBuffers[0]);
+        copyHop(modulator, hop * hopSize, hopSize, modulatorBuffer);
+        processVocoderFrame();
+
+        int16_t *frame = &output.samples[2 * hop * hopSize];
+        for (int i = 0; i < hopSize; i++)
+        {
+            frame[2 * i] = outputLeftBuffer[i];
+            frame[2 * i + 1] = outputRightBuffer[i];
+        }
+    }
+}
+
+/*
+* @brief Render function
+*
+* @param[in] engine     The engine
+* @param[in] size       The FFT size of the FFT engines
+* @param[in] pair       The carrier and the modulator
+* @param[out] output    The output, stereo for the FFT engines and mono for the filter bank
+* @return False when the vocoder can not be initialized
+*/
+static bool render(const EngineCase &engine, int size, const SignalPair &pair, WavData &output)
+{
+    if (!initVocoder(size))
+        return false;
+    setVocoderEngine(engine.engine);
+    applyEngineReset();
+
+    if (engine.engine == VocoderEngine::FilterBank)
+        renderBlocks(pair, output);
+    else
+        renderHops(pair, output);
+    return true;
+}
+
+/*
+* @brief Render after switch function
+*
+* @param[in] engine     An FFT engine
+* @param[in] size       The FFT size
+* @param[in] pair       The carrier and the modulator
+* @param[out] output    The stereo output after the switch back
+* @return False when the vocoder can not be initialized
+*
+* @details Renders the pair with the engine, then with the filter bank, then switches back like the frame interrupt:
+* the engine is reset before the next hop. The output must be the same as the one of a fresh render().
+*/
+static bool renderAfterSwitch(const EngineCase &engine, int size, const SignalPair &pair, WavData &output)
+{
+    if (!initVocoder(size))
+        return false;
+    setVocoderEngine(engine.engine);
+    applyEngineReset();
+
+    WavData before;
+    renderHops(pair, before);
+    setVocoderEngine(VocoderEngine::FilterBank);
+    renderBlocks(pair, before);
+    setVocoderEngine(engine.engine);
+    applyEngineReset();
+
+    renderHops(pair, output);
+    return true;
+}
+
+/*
+* @brief Frame spectrum function
+*
+* @param[in] samples    The interleaved samples
+* @param[in] channels   Number of channels, the first one is analyzed
+* @param[in] start      The first frame of the analysis window
+* @param[out] power     The power per bin in dB, `DISTANCE_FRAME` / 2 bins
+* @return The mean power of the frame
+*
+* @details Bins far below the peak or close to the rounding noise are clamped, so the distance measures
+* the audible spectrum and not the noise floor of the 16-bit output.
+*/
+static double frameSpectrum(const std::vector<int16_t> &samples, int channels, size_t start, std::vector<double> &power)
+{
+    static float frame[DISTANCE_FRAME];
+    static float spectrum[DISTANCE_FRAME];
+
+    double energy = 0.0;
+    for (int i = 0; i < DISTANCE_FRAME; i++)
+    {
+        const float sample = samples[(start + i) * channels];
+        frame[i] = sample * (0.5f - 0.5f * cosf(2.0f * (float)M_PI * i / DISTANCE_FRAME));
+        energy += (double)sample * sample;
+    }
+    arm_rfft_fast_f32(getFFTConfig(DISTANCE_FRAME), frame, spectrum, 0);
+
+    double peak = 0.0;
+    power.resize(DISTANCE_FRAME / 2);
+    for (int k = 0; k < DISTANCE_FRAME / 2; k++)
+    {
+        const double real = spectrum[2 * k];
+        const double imag = (k == 0) ? 0.0 : spectrum[2 * k + 1];
+        power[k] = real * real + imag * imag;
+        peak = std::max(peak, power[k]);
+    }
+    for (int k = 0; k < DISTANCE_FRAME / 2; k++)
+    {
+        power[k] = 10.0 * log10(std::max(power[k], std::max(peak * DISTANCE_RANGE, DISTANCE_FLOOR)));
+    }
+    return energy / DISTANCE_FRAME;
+}
+
+/*
+* @brief Compare function
+*
+* @param[in] golden     The golden output
+* @param[in] output     The output to check, same layout
+* @return The SNR, the log-spectral distance and the largest sample error
+*/
+static Comparison compare(const WavData &golden, const WavData &output)
+{
+    Comparison result = {INFINITY, 0.0, 0};
+
+    double signal = 0.0;
+    double noise = 0.0;
+    for (size_t i = 0; i < golden.samples.size(); i++)
+    {
+        const int error = abs((int)output.samples[i] - golden.samples[i]);
+        signal += (double)golden.samples[i] * golden.samples[i];
+        noise += (double)error * error;
+        result.maxError = std::max(result.maxError, error);
+    }
+    if (noise > 0.0)
+        result.snr = (signal > 0.0) ? 10.0 * log10(signal / noise) : -INFINITY;
+
+    std::vector<double> goldenPower;
+    std::vector<double> outputPower;
+    double distanceSum = 0.0;
+    int frames = 0;
+    for (size_t start = 0; start + DISTANCE_FRAME <= golden.frames(); start += DISTANCE_FRAME / 2)
+    {
+        if (frameSpectrum(golden.samples, golden.channels, start, goldenPower) < SILENCE_LEVEL)
+            continue;
+        frameSpectrum(output.samples, output.channels, start, outputPower);
+
+        double squares = 0.0;
+        for (size_t k = 0; k < goldenPower.size(); k++)
+        {
+            const double difference = outputPower[k] - goldenPower[k];
+            squares += difference * difference;
+        }
+        distanceSum += sqrt(squares / goldenPower.size());
+        frames++;
+    }
+    result.distance = (frames > 0) ? distanceSum / frames : 0.0;
+    return result;
+}
+
+/*
+* @brief Output level function
+*
+* @param[in] output The stereo output
+* @param[in] start  The first frame
+* @param[in] count  Number of frames
+* @return The mean power of the left channel over the frames
+*/
+static double outputLevel(const WavData &output, size_t start, size_t count)
+{
+    double energy = 0.0;
+    for (size_t i = start; i < start + count && i < output.frames(); i++)
+    {
+        const double sample = output.samples[i * output.channels];
+        energy += sample * sample;
+    }
+    return energy / count;
+}
+
+/*
+* @brief Create directory function
+*
+* @param[in] path   The directory
+* @return False when it does not exist and can not be created
+*/
+static bool createDirectory(const std::string &path)
+{
+    return mkdir(path.c_str(), 0755) == 0 || errno == EEXIST;
+}
+
+int main(int argc, char **argv)
+{
+    const char *updateDirectory = nullptr;
+    const char *goldenDirectory = nullptr;
+    const char *filter = nullptr;
+    bool exact = false;
+    Tolerance limits = {};
+    bool snrSet = false;
+    bool distanceSet = false;
+    bool errorSet = false;
+    bool validArguments = true;
+
+    for (int arg = 1; arg < argc; arg++)
+    {
+        const bool hasValue = arg + 1 < argc;
+        if (strcmp(argv[arg], "--update") == 0 && hasValue)
+            updateDirectory = argv[++arg];
+        else if (strcmp(argv[arg], "--golden") == 0 && hasValue)
+            goldenDirectory = argv[++arg];
+        else if (strcmp(argv[arg], "--filter") == 0 && hasValue)
+            filter = argv[++arg];
+        else if (strcmp(argv[arg], "--exact") == 0)
+            exact = true;
+        else if (strcmp(argv[arg], "--snr") == 0 && hasValue)
+        {
+            limits.minSnr = atof(argv[++arg]);
+            snrSet = true;
+        }
+        else if (strcmp(argv[arg], "--lsd") == 0 && hasValue)
+        {
+            limits.maxDistance = atof(argv[++arg]);
+            distanceSet = true;
+        }
+        else if (strcmp(argv[arg], "--max-error") == 0 && hasValue)
+        {
+            limits.maxError = atoi(argv[++arg]);
+            errorSet = true;
+        }
+        else
+            validArguments = false;
+    }
+
+    if (!validArguments || (updateDirectory == nullptr) == (goldenDirectory == nullptr))
+    {
+        fprintf(stderr, "Usage: %s (--update DIR | --golden DIR) [--filter TEXT] [--exact] [--snr DB] [--lsd DB] [--max-error N]\n", argv[0]);
+        return 2;
+    }
+    if (updateDirectory && !createDirectory(updateDirectory))
+    {
+        fprintf(stderr, "Error: can not create %s\n", updateDirectory);
+        return 2;
+    }
+
+    generateSweep(sweepSignal);
+    generateNoise(noiseSignal);
+    generateImpulses(impulseSignal);
+    generateSpeech(speechSignal);
+    generateGateCheck(sawtoothSignal, quietSignal);
+    const SignalPair GATE_PAIR = {"gate_quiet", &sawtoothSignal, &quietSignal};
+    const SignalPair PAIRS[] =
+    {
+        {"sweep_speech",    &sweepSignal,   &speechSignal},
+        {"impulses_speech", &impulseSignal, &speechSignal},
+        {"noise_speech",    &noiseSignal,   &speechSignal},
+        {"impulses_sweep",  &impulseSignal, &sweepSignal},
+    };
+
+    if (goldenDirectory)
+        printf("%-32s %10s %10s %10s  %s\n", "case", "snr dB", "lsd dB", "max error", "result");
+
+    int cases = 0;
+    int failures = 0;
+    for (const EngineCase &engine : ENGINES)
+    {
+        const bool framed = engine.engine != VocoderEngine::FilterBank;
+        for (int size = framed ? MIN_FFT_SIZE : DEFAULT_FFT_SIZE; size <= (framed ? MAX_FFT_SIZE : DEFAULT_FFT_SIZE); size *= 2)
+        {
+            for (const SignalPair &pair : PAIRS)
+            {
+                std::string name = std::string(pair.name) + "_" + engine.name;
+                if (framed)
+                    name += "_" + std::to_string(size);
+                if (filter && name.find(filter) == std::string::npos)
+                    continue;
+
+                WavData output;
+                if (!render(engine, size, pair, output))
+                {
+                    fprintf(stderr, "Error: invalid vocoder configuration (FFT size %d)\n", size);
+                    return 1;
+                }
+                cases++;
+
+                std::string error;
+                if (updateDirectory)
+                {
+                    if (!writeWav(std::string(updateDirectory) + "/" + name + ".wav", output, error))
+                    {
+                        fprintf(stderr, "Error: %s\n", error.c_str());
+                        return 1;
+                    }
+                    continue;
+                }
+
+                WavData golden;
+                if (!readWav(std::string(goldenDirectory) + "/" + name + ".wav", golden, error))
+                {
+                    printf("%-32s %10s %10s %10s  MISSING\n", name.c_str(), "-", "-", "-");
+                    failures++;
+                    continue;
+                }
+                if (golden.channels != output.channels || golden.samples.size() != output.samples.size())
+                {
+                    printf("%-32s %10s %10s %10s  LENGTH\n", name.c_str(), "-", "-", "-");
+                    failures++;
+                    continue;
+                }
+
+                const Comparison result = compare(golden, output);
+                const double snrLimit = snrSet ? limits.minSnr : engine.tolerance.minSnr;
+                const double distanceLimit = distanceSet ? limits.maxDistance : engine.tolerance.maxDistance;
+                const int errorLimit = errorSet ? limits.maxError : engine.tolerance.maxError;
+                const bool passed = exact ? result.maxError == 0
+                                          : result.snr >= snrLimit && result.distance <= distanceLimit && result.maxError <= errorLimit;
+                failures += passed ? 0 : 1;
+                printf("%-32s %10.1f %10.3f %10d  %s\n", name.c_str(), result.snr, result.distance, result.maxError, passed ? "ok" : "FAIL");
+            }
+
+            const std::string switchName = std::string("switch_") + PAIRS[0].name + "_" + engine.name + "_" + std::to_string(size);
+            if (framed && goldenDirectory && (!filter || switchName.find(filter) != std::string::npos))
+            {
+                WavData fresh;
+                WavData switched;
+                if (!render(engine, size, PAIRS[0], fresh) || !renderAfterSwitch(engine, size, PAIRS[0], switched))
+                {
+                    fprintf(stderr, "Error: invalid vocoder configuration (FFT size %d)\n", size);
+                    return 1;
+                }
+                cases++;
+
+                const Comparison result = compare(fresh, switched);
+                const bool passed = result.maxError == 0;
+                failures += passed ? 0 : 1;
+                printf("%-32s %10.1f %10.3f %10d  %s\n", switchName.c_str(), result.snr, result.distance, result.maxError, passed ? "ok" : "FAIL");
+            }
+
+            const std::string name = std::string(GATE_PAIR.name) + "_" + engine.name + "_" + std::to_string(size);
+            if (!framed || !goldenDirectory || (filter && name.find(filter) == std::string::npos))
+                continue;
+
+            WavData output;
+            if (!render(engine, size, GATE_PAIR, output))
+            {
+                fprintf(stderr, "Error: invalid vocoder configuration (FFT size %d)\n", size);
+                return 1;
+            }
+            cases++;
+
+            // The last second of the input, the gate has had all the time to adapt
+            const double level = outputLevel(output, GATE_CHECK_LENGTH - (size_t)SAMPLE_RATE, (size_t)SAMPLE_RATE);
+            const bool passed = noiseGate.skippedFrames() == 0 && level >= SILENCE_LEVEL;
+            failures += passed ? 0 : 1;
+            printf("%-32s %u of %u frames skipped, output %.1f dBFS  %s\n", name.c_str(), (unsigned)noiseGate.skippedFrames(),
+                   (unsigned)noiseGate.frames(), 10.0 * log10(std::max(level, 1.0) / (32768.0 * 32768.0)), passed ? "ok" : "FAIL");
+        }
+    }
+
+    if (updateDirectory)
+    {
+        printf("Wrote %d golden outputs to %s\n", cases, updateDirectory);
+        return 0;
+    }
+    printf("%d of %d cases failed\n", failures, cases);
+    return (failures > 0) ? 1 : 0;
+}
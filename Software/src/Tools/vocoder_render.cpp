@@ -0,0 +1,465 @@
+/**
+ * @file vocoder_render.cpp
+ * @brief Offline vocoder render tool for the native build
+ *
+ * @details This tool reads a carrier and a modulator WAV file, runs them hop by hop
+ * through the same processing chain that loop() uses on the Teensy, and writes the result
+ * to a stereo output WAV file. It reports the processing speed as a real-time factor.
+ * The output is delayed by the vocoder latency, exactly like on the hardware.
+ * Every channel of the carrier file is a carrier voice (up to `MAX_CARRIER_VOICES`), the modulator uses its first channel.
+ *
+ * Usage: vocoder_render [--filterbank | --fixed] [--fft-size N] [--envelope none|cepstral|lpc] [--pan P,P,...] [--set NAME=VALUE] [--memory] <carrier.wav> <modulator.wav> <output.wav>
+ *
+ * With --filterbank the low-latency filter-bank engine is used instead of the FFT engine,
+ * in blocks of 128 samples like the FilterBankProcessor in the audio update chain.
+ * With --fixed the fixed-point (Q15/Q31) FFT engine is used, the input is also rendered with the float
+ * engine and the SNR of the fixed-point output against the float output is printed.
+ * With --fft-size the FFT engine runs at size N instead of the startup size.
+ * With --envelope the modulator envelope method of the FFT engine is overridden, to compare them.
+ * With --pan the stereo position of the carrier voices is set, -1 is left and +1 is right,
+ * by default the voices are spread evenly from left to right. The filter bank only uses the first carrier channel.
+ * With --set a parameter of the registry (see DSP/parameters.h) is set before the render starts, it can be repeated.
+ * With --memory the memory report of the DSP arenas is printed, the same CSV lines the Teensy prints at boot.
+ * When built with VOCODER_PROFILING the time per stage is printed in microseconds.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+// Headers
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <cmath>
+
+#include "DSP/vocoder.h"
+#include "DSP/profiler.h"
+#include "Tools/wav_io.h"
+
+// Variables
+static const uint32_t SAMPLE_RATE = 44100;
+static const int BLOCK_SIZE = 128; // AUDIO_BLOCK_SAMPLES
+
+/*
+* @brief Copy hop function
+*
+* @param[in] source     The source samples
+* @param[in] offset     Index of the first sample of the hop
+* @param[in] size       Number of samples in the hop
+* @param[out] hop       The hop buffer, zero padded past the end of the source
+*/
+static void copyHop(const std::vector<int16_t> &source, size_t offset, int size, int16_t *hop)
+{
+    for (int i = 0; i < size; i++)
+    {
+        hop[i] = (offset + i < source.size()) ? source[offset + i] : 0;
+    }
+}
+
+/*
+* @brief Print memory report function
+*
+* @details This function prints every buffer of the fast and slow arena and the required and available arena sizes.
+*/
+static void printMemoryReport()
+{
+    char line[96];
+    const DspArena *arenas[] = {&fastArena, &slowArena};
+
+    printf("mem,arena,buffer,offset,bytes,stage\n");
+    for (const DspArena *arena : arenas)
+    {
+        for (int i = 0; i < arena->entryCount(); i++)
+        {
+            arena->formatEntry(i, line, sizeof(line));
+            printf("%s\n", line);
+        }
+        arena->formatSummary(line, sizeof(line));
+        printf("%s\n", line);
+    }
+}
+
+#if VOCODER_PROFILING
+/*
+* @brief Print profile function
+*
+* @details This function prints the profiler statistics of every recorded stage.
+*/
+static void printProfile()
+{
+    const double ticksPerMicrosecond = halCyclesPerSecond() / 1e6;
+
+    printf("%-15s %8s %8s %8s %8s %8s\n", "stage", "count", "min us", "avg us", "max us", "p99 us");
+    for (int i = 0; i < (int)ProfileStage::Count; i++)
+    {
+        ProfileSummary summary;
+        if (!profileSummary((ProfileStage)i, summary))
+            continue;
+        printf("%-15s %8u %8.2f %8.2f %8.2f %8.2f\n", profileStageName((ProfileStage)i), (unsigned)summary.count,
+               summary.minCycles / ticksPerMicrosecond, summary.avgCycles / ticksPerMicrosecond,
+               summary.maxCycles / ticksPerMicrosecond, summary.p99Cycles / ticksPerMicrosecond);
+    }
+    printf("Frame load %.2f %% of the hop period\n", profileFrameLoad(hopSize, SAMPLE_RATE));
+}
+#endif
+
+/*
+* @brief Parse envelope method function
+*
+* @param[in] name       The method name: none, cepstral or lpc
+* @param[out] method    The envelope method
+* @return False for an unknown name
+*/
+static bool parseEnvelopeMethod(const char *name, EnvelopeMethod &method)
+{
+    if (strcmp(name, "none") == 0)
+        method = EnvelopeMethod::None;
+    else if (strcmp(name, "cepstral") == 0)
+        method = EnvelopeMethod::Cepstral;
+    else if (strcmp(name, "lpc") == 0)
+        method = EnvelopeMethod::Lpc;
+    else
+        return false;
+    return true;
+}
+
+/*
+* @brief Parse pan list function
+*
+* @param[in] list   Comma separated pan positions
+* @param[out] pans  The pan position per voice
+* @return False when the list is empty, has too many entries or a value outside -1 to +1
+*/
+static bool parsePanList(const char *list, std::vector<float> &pans)
+{
+    pans.clear();
+    while (*list)
+    {
+        char *end = nullptr;
+        const float pan = strtof(list, &end);
+        if (end == list || pan < -1.0f || pan > 1.0f || pans.size() == (size_t)MAX_CARRIER_VOICES)
+            return false;
+        pans.push_back(pan);
+        list = (*end == ',') ? end + 1 : end;
+        if (*end && *end != ',')
+            return false;
+    }
+    return !pans.empty();
+}
+
+/*
+* @brief Parse parameter function
+*
+* @param[in] assignment NAME=VALUE
+* @return False when the name is unknown or the value is not a number
+*
+* @details The value is clamped to the range of the parameter and applied from the first frame on.
+*/
+static bool parseParameter(const char *assignment)
+{
+    const char *equals = strchr(assignment, '=');
+    if (!equals)
+        return false;
+
+    char name[32];
+    const size_t length = (size_t)(equals - assignment);
+    if (length >= sizeof(name))
+        return false;
+    memcpy(name, assignment, length);
+    name[length] = '\0';
+
+    ParamId id;
+    char *end = nullptr;
+    const float value = strtof(equals + 1, &end);
+    if (!ParameterRegistry::find(name, id) || end == equals + 1 || *end)
+        return false;
+    return vocoderParameters.set(id, value);
+}
+
+/*
+* @brief Render filter bank function
+*
+* @param[in] carrier    The carrier samples
+* @param[in] modulator  The modulator samples
+* @param[out] output    The vocoded samples
+* @return Number of blocks processed
+*/
+static size_t renderFilterBank(const std::vector<int16_t> &carrier, const std::vector<int16_t> &modulator, std::vector<int16_t> &output)
+{
+    const size_t length = std::max(carrier.size(), modulator.size());
+    const size_t blocks = (length + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    int16_t carrierBlock[BLOCK_SIZE];
+    int16_t modulatorBlock[BLOCK_SIZE];
+
+    output.resize(blocks * BLOCK_SIZE);
+    for (size_t block = 0; block < blocks; block++)
+    {
+        for (int i = 0; i < BLOCK_SIZE; i++)
+        {
+            size_t index = block * BLOCK_SIZE + i;
+            carrierBlock[i] = (index < carrier.size()) ? carrier[index] : 0;
+            modulatorBlock[i] = (index < modulator.size()) ? modulator[index] : 0;
+        }
+        filterBankVocoder.process(carrierBlock, modulatorBlock, &output[block * BLOCK_SIZE], BLOCK_SIZE);
+    }
+    return blocks;
+}
+
+/*
+* @brief Render frames function
+*
+* @param[in] carriers   The carrier samples, one vector per active carrier voice
+* @param[in] modulator  The modulator samples
+* @param[out] output    The vocoded stereo samples, interleaved and delayed by the vocoder latency
+* @param[out] unvoiced  Number of frames the voicing detector classified as unvoiced
+* @return Number of hops processed
+*/
+static size_t renderFrames(const std::vector<std::vector<int16_t>> &carriers, const std::vector<int16_t> &modulator, std::vector<int16_t> &output,
+                           size_t &unvoiced)
+{
+    // Run on past the end of the input until the latency has been flushed out
+    const size_t length = std::max(carriers[0].size(), modulator.size()) + vocoderLatency();
+    const size_t hops = (length + hopSize - 1) / hopSize;
+
+    output.resize(2 * hops * hopSize);
+    unvoiced = 0;
+    for (size_t hop = 0; hop < hops; hop++)
+    {
+        for (size_t v = 0; v < carriers.size(); v++)
+        {
+            copyHop(carriers[v], hop * hopSize, hopSize, carrierBuffers[v]);
+        }
+        copyHop(modulator, hop * hopSize, hopSize, modulatorBuffer);
+
+        processVocoderFrame();
+        unvoiced += voicingDetector.unvoiced() ? 1 : 0;
+
+        int16_t *frame = &output[2 * hop * hopSize];
+        for (int i = 0; i < hopSize; i++)
+        {
+            frame[2 * i] = outputLeftBuffer[i];
+            frame[2 * i + 1] = outputRightBuffer[i];
+        }
+    }
+    return hops;
+}
+
+/*
+* @brief Signal to noise ratio function
+*
+* @param[in] reference  The reference samples
+* @param[in] test       The samples to compare, same length
+* @return The SNR in dB, the error is the difference with the reference
+*/
+static double signalToNoise(const std::vector<int16_t> &reference, const std::vector<int16_t> &test)
+{
+    double signal = 0.0;
+    double noise = 0.0;
+    for (size_t i = 0; i < reference.size() && i < test.size(); i++)
+    {
+        const double error = (double)test[i] - reference[i];
+        signal += (double)reference[i] * reference[i];
+        noise += error * error;
+    }
+    return (noise > 0.0) ? 10.0 * log10(signal / noise) : INFINITY;
+}
+
+int main(int argc, char **argv)
+{
+    bool useFilterBank = false;
+    bool useFixedPoint = false;
+    bool showMemory = false;
+    int requestedFftSize = 0;
+    const char *envelopeName = nullptr;
+    std::vector<float> pans;
+    bool validPans = true;
+    bool validParameters = true;
+    int arg = 1;
+    for (; arg < argc && strncmp(argv[arg], "--", 2) == 0; arg++)
+    {
+        if (strcmp(argv[arg], "--filterbank") == 0)
+        {
+            useFilterBank = true;
+        }
+        else if (strcmp(argv[arg], "--fixed") == 0)
+        {
+            useFixedPoint = true;
+        }
+        else if (strcmp(argv[arg], "--memory") == 0)
+        {
+            showMemory = true;
+        }
+        else if (strcmp(argv[arg], "--fft-size") == 0 && arg + 1 < argc)
+        {
+            requestedFftSize = atoi(argv[++arg]);
+        }
+        else if (strcmp(argv[arg], "--envelope") == 0 && arg + 1 < argc)
+        {
+            envelopeName = argv[++arg];
+        }
+        else if (strcmp(argv[arg], "--pan") == 0 && arg + 1 < argc)
+        {
+            validPans = parsePanList(argv[++arg], pans);
+        }
+        else if (strcmp(argv[arg], "--set") == 0 && arg + 1 < argc)
+        {
+            validParameters = validParameters && parseParameter(argv[++arg]);
+        }
+        else
+        {
+            break;
+        }
+    }
+    EnvelopeMethod envelopeMethod = EnvelopeMethod::None;
+    bool validEnvelope = !envelopeName || parseEnvelopeMethod(envelopeName, envelopeMethod);
+    if (argc - arg != 3 || (requestedFftSize && !FrameSizeManager::isSupported(requestedFftSize)) || !validEnvelope || !validPans || !validParameters ||
+        (useFilterBank && useFixedPoint))
+    {
+        fprintf(stderr, "Usage: %s [--filterbank | --fixed] [--fft-size N] [--envelope none|cepstral|lpc] [--pan P,P,...] [--set NAME=VALUE] [--memory] <carrier.wav> <modulator.wav> <output.wav>\n", argv[0]);
+        fprintf(stderr, "N is a power of two from %d to %d, P is a pan position from -1 (left) to +1 (right) per carrier voice\n", MIN_FFT_SIZE, MAX_FFT_SIZE);
+        fprintf(stderr, "NAME is one of:");
+        for (int i = 0; i < (int)ParamId::Count; i++)
+        {
+            fprintf(stderr, " %s", ParameterRegistry::info((ParamId)i).name);
+        }
+        fprintf(stderr, "\n");
+        return 2;
+    }
+    char **files = argv + arg;
+
+    WavData carrier;
+    WavData modulator;
+    std::string error;
+
+    if (!readWav(files[0], carrier, error) || !readWav(files[1], modulator, error))
+    {
+        fprintf(stderr, "Error: %s\n", error.c_str());
+        return 1;
+    }
+    if (carrier.sampleRate != SAMPLE_RATE || modulator.sampleRate != SAMPLE_RATE)
+    {
+        fprintf(stderr, "Warning: the vocoder runs at %u Hz, input is processed without resampling\n", SAMPLE_RATE);
+    }
+
+    // One carrier voice per channel
+    std::vector<std::vector<int16_t>> carriers;
+    for (int channel = 0; channel < carrier.channels && channel < MAX_CARRIER_VOICES; channel++)
+    {
+        carriers.push_back(extractChannel(carrier, channel));
+    }
+    if (carrier.channels > MAX_CARRIER_VOICES)
+    {
+        fprintf(stderr, "Warning: only the first %d carrier channels are used\n", MAX_CARRIER_VOICES);
+    }
+    if (pans.size() > carriers.size())
+    {
+        fprintf(stderr, "Error: %zu pan positions for %zu carrier voices\n", pans.size(), carriers.size());
+        return 2;
+    }
+    const std::vector<int16_t> modulatorSamples = extractChannel(modulator, 0);
+
+    // Every render starts from a freshly initialized vocoder
+    auto initialize = [&]() -> bool
+    {
+        if (!initVocoder(requestedFftSize ? requestedFftSize : DEFAULT_FFT_SIZE))
+            return false;
+        if (envelopeName)
+        {
+            modulatorEnvelope.begin(modulatorEnvelope.bands(), envelopeMethod, modulatorEnvelope.order(), SAMPLE_RATE);
+            modulatorEnvelope.setFrameSize(fftSize);
+        }
+        setCarrierVoices((int)carriers.size());
+        for (size_t v = 0; v < pans.size(); v++)
+        {
+            carrierVoices.setPan((int)v, pans[v]);
+        }
+        return true;
+    };
+
+    const bool initialized = initialize();
+    if (showMemory)
+        printMemoryReport();
+    if (!initialized)
+    {
+        fprintf(stderr, "Error: invalid vocoder configuration\n");
+        return 1;
+    }
+
+    if (useFilterBank)
+    {
+        WavData output;
+        output.sampleRate = SAMPLE_RATE;
+
+        auto start = std::chrono::steady_clock::now();
+        size_t blocks = renderFilterBank(carriers[0], modulatorSamples, output.samples);
+        auto stop = std::chrono::steady_clock::now();
+
+        if (!writeWav(files[2], output, error))
+        {
+            fprintf(stderr, "Error: %s\n", error.c_str());
+            return 1;
+        }
+
+        double seconds = std::chrono::duration<double>(stop - start).count();
+        double audioSeconds = (double)output.samples.size() / SAMPLE_RATE;
+        printf("Rendered %zu blocks of %d samples (%.2f s of audio) in %.3f s, %.1fx real-time\n",
+               blocks, BLOCK_SIZE, audioSeconds, seconds, seconds > 0.0 ? audioSeconds / seconds : 0.0);
+        printf("Filter bank with %d bands, latency %d samples (%.1f ms)\n",
+               filterBankVocoder.bands(), BLOCK_SIZE, 1000.0 * BLOCK_SIZE / SAMPLE_RATE);
+        return 0;
+    }
+
+    WavData reference;
+    size_t unvoiced = 0;
+    if (useFixedPoint)
+    {
+        renderFrames(carriers, modulatorSamples, reference.samples, unvoiced);
+        initialize();
+        setVocoderEngine(VocoderEngine::FixedPoint);
+    }
+#if VOCODER_PROFILING
+    profileReset();
+#endif
+
+    WavData output;
+    output.sampleRate = SAMPLE_RATE;
+    output.channels = 2;
+
+    auto start = std::chrono::steady_clock::now();
+    size_t hops = renderFrames(carriers, modulatorSamples, output.samples, unvoiced);
+    auto stop = std::chrono::steady_clock::now();
+
+    if (!writeWav(files[2], output, error))
+    {
+        fprintf(stderr, "Error: %s\n", error.c_str());
+        return 1;
+    }
+
+    double seconds = std::chrono::duration<double>(stop - start).count();
+    double audioSeconds = (double)output.frames() / SAMPLE_RATE;
+    printf("Rendered %zu hops of %d samples (%.2f s of audio) in %.3f s, %.1fx real-time\n",
+           hops, hopSize, audioSeconds, seconds, seconds > 0.0 ? audioSeconds / seconds : 0.0);
+    printf("%s engine, FFT size %d, latency %d samples (%.1f ms)\n", vocoderEngineName(getVocoderEngine()),
+           fftSize, vocoderLatency(), 1000.0 * vocoderLatency() / SAMPLE_RATE);
+    static const char *envelopeNames[] = {"none", "cepstral", "lpc"};
+    printf("Envelope %s, %d bands, order %d\n",
+           envelopeNames[(int)modulatorEnvelope.method()], modulatorEnvelope.bands(), modulatorEnvelope.order());
+    printf("Unvoiced frames %zu of %zu\n", unvoiced, hops);
+    printf("Frames skipped by the noise gate %lu of %lu, threshold %.1f dBFS\n", (unsigned long)noiseGate.skippedFrames(),
+           (unsigned long)noiseGate.frames(), noiseGate.threshold());
+    printf("%d carrier voice(s), pan", carrierVoices.voiceCount());
+    for (int v = 0; v < carrierVoices.voiceCount(); v++)
+    {
+        printf(" %+.2f", carrierVoices.voice(v).pan);
+    }
+    printf("\n");
+    if (useFixedPoint)
+        printf("SNR against the float engine %.1f dB\n", signalToNoise(reference.samples, output.samples));
+#if VOCODER_PROFILING
+    printProfile();
+#endif
+    return 0;
+}
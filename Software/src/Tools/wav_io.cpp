@@ -0,0 +1,201 @@
+/**
+ * @file wav_io.cpp
+ * @brief WAV file reading and writing
+ *
+ * @details This file contains functions for reading and writing 16-bit PCM WAV files.
+ * Multi-channel files keep all channels interleaved, extractChannel() returns a single channel.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+// Headers
+#include "wav_io.h"
+#include <cstdio>
+#include <cstring>
+
+/*
+* @brief Read little endian value function
+*
+* @param[in] data   Pointer to the first byte
+* @param[in] bytes  Number of bytes (2 or 4)
+* @return The decoded value
+*/
+static uint32_t readLE(const uint8_t *data, int bytes)
+{
+    uint32_t value = 0;
+    for (int i = bytes - 1; i >= 0; i--)
+    {
+        value = (value << 8) | data[i];
+    }
+    return value;
+}
+
+/*
+* @brief Write little endian value function
+*
+* @param[in] file   The output file
+* @param[in] value  The value to write
+* @param[in] bytes  Number of bytes (2 or 4)
+*/
+static void writeLE(FILE *file, uint32_t value, int bytes)
+{
+    for (int i = 0; i < bytes; i++)
+    {
+        fputc((value >> (8 * i)) & 0xFF, file);
+    }
+}
+
+/*
+* @brief Read WAV function
+*
+* @param[in] path   Path of the WAV file
+* @param[out] wav   The decoded audio data
+* @param[out] error Description of the problem when reading fails
+* @return True when the file was read successfully
+*
+* @details This function reads a 16-bit PCM WAV file with any number of channels.
+*/
+bool readWav(const std::string &path, WavData &wav, std::string &error)
+{
+    FILE *file = fopen(path.c_str(), "rb");
+    if (!file)
+    {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    uint8_t header[12];
+    if (fread(header, 1, sizeof(header), file) != sizeof(header) ||
+        memcmp(header, "RIFF", 4) != 0 || memcmp(header + 8, "WAVE", 4) != 0)
+    {
+        error = path + " is not a RIFF/WAVE file";
+        fclose(file);
+        return false;
+    }
+
+    uint16_t channels = 0;
+    uint16_t bitsPerSample = 0;
+    bool formatFound = false;
+    uint8_t chunkHeader[8];
+
+    while (fread(chunkHeader, 1, sizeof(chunkHeader), file) == sizeof(chunkHeader))
+    {
+        uint32_t chunkSize = readLE(chunkHeader + 4, 4);
+
+        if (memcmp(chunkHeader, "fmt ", 4) == 0)
+        {
+            uint8_t format[16];
+            if (chunkSize < sizeof(format) || fread(format, 1, sizeof(format), file) != sizeof(format))
+                break;
+
+            uint16_t audioFormat = readLE(format, 2);
+            channels = readLE(format + 2, 2);
+            wav.sampleRate = readLE(format + 4, 4);
+            bitsPerSample = readLE(format + 14, 2);
+
+            if (audioFormat != 1 || bitsPerSample != 16 || channels == 0)
+            {
+                error = path + " is not 16-bit PCM";
+                fclose(file);
+                return false;
+            }
+            formatFound = true;
+            fseek(file, chunkSize - sizeof(format) + (chunkSize & 1), SEEK_CUR);
+        }
+        else if (memcmp(chunkHeader, "data", 4) == 0 && formatFound)
+        {
+            size_t frames = chunkSize / (2 * channels);
+            std::vector<int16_t> interleaved(frames * channels);
+            size_t read = fread(interleaved.data(), 2 * channels, frames, file);
+
+            wav.channels = channels;
+            wav.samples.resize(read * channels);
+            for (size_t i = 0; i < read * channels; i++)
+            {
+                const uint8_t *bytes = reinterpret_cast<const uint8_t*>(&interleaved[i]);
+                wav.samples[i] = (int16_t)readLE(bytes, 2);
+            }
+            fclose(file);
+            return true;
+        }
+        else
+        {
+            fseek(file, chunkSize + (chunkSize & 1), SEEK_CUR);
+        }
+    }
+
+    error = path + " has no fmt or data chunk";
+    fclose(file);
+    return false;
+}
+
+/*
+* @brief Write WAV function
+*
+* @param[in] path   Path of the WAV file
+* @param[in] wav    The audio data to write
+* @param[out] error Description of the problem when writing fails
+* @return True when the file was written successfully
+*
+* @details This function writes a 16-bit PCM WAV file, the samples are interleaved per frame.
+*/
+bool writeWav(const std::string &path, const WavData &wav, std::string &error)
+{
+    FILE *file = fopen(path.c_str(), "wb");
+    if (!file)
+    {
+        error = "cannot create " + path;
+        return false;
+    }
+
+    const uint32_t dataSize = wav.samples.size() * 2;
+
+    fwrite("RIFF", 1, 4, file);
+    writeLE(file, 36 + dataSize, 4);
+    fwrite("WAVE", 1, 4, file);
+
+    fwrite("fmt ", 1, 4, file);
+    writeLE(file, 16, 4);
+    writeLE(file, 1, 2);                    // PCM
+    writeLE(file, wav.channels, 2);
+    writeLE(file, wav.sampleRate, 4);
+    writeLE(file, wav.sampleRate * 2 * wav.channels, 4);    // Byte rate
+    writeLE(file, 2 * wav.channels, 2);                     // Block align
+    writeLE(file, 16, 2);                   // Bits per sample
+
+    fwrite("data", 1, 4, file);
+    writeLE(file, dataSize, 4);
+    for (int16_t sample : wav.samples)
+    {
+        writeLE(file, (uint16_t)sample, 2);
+    }
+
+    bool ok = (ferror(file) == 0);
+    fclose(file);
+    if (!ok)
+        error = "write error on " + path;
+    return ok;
+}
+
+/*
+* @brief Extract channel function
+*
+* @param[in] wav        The audio data
+* @param[in] channel    The channel, 0 is the first (left) channel
+* @return The samples of that channel, empty when the file has fewer channels
+*/
+std::vector<int16_t> extractChannel(const WavData &wav, int channel)
+{
+    std::vector<int16_t> samples;
+    if (channel < 0 || channel >= wav.channels)
+        return samples;
+
+    samples.resize(wav.frames());
+    for (size_t i = 0; i < samples.size(); i++)
+    {
+        samples[i] = wav.samples[i * wav.channels + channel];
+    }
+    return samples;
+}
@@ -0,0 +1,41 @@
+/**
+ * @file wav_io.h
+ * @brief Header file for WAV file reading and writing
+ *
+ * @details This file contains declarations for reading and writing 16-bit PCM WAV files.
+ * It is used by the native tools to feed audio files through the vocoder.
+ *
+ * @note Only compiled for the native environment, see platformio.ini.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+#ifndef WAV_IO_H
+#define WAV_IO_H
+
+// Headers
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+* @struct WavData
+* @brief 16-bit audio data with its sample rate, multi-channel samples are interleaved
+*/
+struct WavData
+{
+    uint32_t sampleRate = 44100;
+    uint16_t channels = 1;
+    std::vector<int16_t> samples;
+
+    size_t frames() const { return samples.size() / channels; }
+};
+
+// Function prototypes
+bool readWav(const std::string &path, WavData &wav, std::string &error);
+bool writeWav(const std::string &path, const WavData &wav, std::string &error);
+std::vector<int16_t> extractChannel(const WavData &wav, int channel);
+
+#endif // WAV_IO_H
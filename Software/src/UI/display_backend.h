@@ -0,0 +1,45 @@
+/**
+ * @file display_backend.h
+ * @brief Interface of the display transfer backends
+ *
+ * @details This file contains the interface the DisplayRenderer sends its pixels through.
+ * The Teensy uses Ili9488DmaBackend, which sends the pixels over hardware SPI with DMA.
+ * The host display benchmark uses FramebufferBackend (HAL/native), which copies them into an image in memory.
+ *
+ * Pixels are sent in the 18-bit format of the ILI9488 SPI interface: three bytes per pixel, red, green and blue,
+ * with the color in the upper six bits of each byte.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+#ifndef DISPLAY_BACKEND_H
+#define DISPLAY_BACKEND_H
+
+// Headers
+#include <cstdint>
+#include "UI/display_canvas.h"
+
+// Defines
+static const int DISPLAY_BYTES_PER_PIXEL = 3;
+
+/*
+* @class DisplayBackend
+* @brief Sends pixel data to a display window
+*
+* @details A transfer is beginWindow(), one or more writePixels() calls of whole pixels that fill the window
+* row by row, and endWindow(). writePixels() may return before the data is sent, the buffer must then stay unchanged
+* until busy() returns false. beginWindow() and endWindow() are only called when the backend is not busy.
+*/
+class DisplayBackend
+{
+    public:
+        virtual void beginWindow(const DisplayRect &rect) = 0;
+        virtual void writePixels(const uint8_t *data, int bytes) = 0;
+        virtual bool busy() const = 0;
+        virtual void endWindow() = 0;
+        virtual ~DisplayBackend() {}
+};
+
+#endif // DISPLAY_BACKEND_H
@@ -0,0 +1,267 @@
+/**
+ * @file display_canvas.cpp
+ * @brief Display framebuffer with dirty tracking
+ *
+ * @details This file contains the implementation of the palette framebuffer. Every write compares the new
+ * palette index with the stored one and only marks the tile dirty when they differ.
+ * takeDirtyRect() hands out the dirty tiles as rectangles: a run of dirty tiles in one tile row,
+ * extended downwards while the rows below have the same run dirty.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+// Headers
+#include "display_canvas.h"
+#include <cstring>
+
+// Variables
+// The 16 standard colors of the ILI9488 library, in RGB565
+static const uint16_t palette[DISPLAY_PALETTE_SIZE] = {
+    0x0000, // Black
+    0x000F, // Navy
+    0x03E0, // Dark green
+    0x03EF, // Dark cyan
+    0x7800, // Maroon
+    0x780F, // Purple
+    0x7BE0, // Olive
+    0xC618, // Light grey
+    0x7BEF, // Dark grey
+    0x001F, // Blue
+    0x07E0, // Green
+    0x07FF, // Cyan
+    0xF800, // Red
+    0xF81F, // Magenta
+    0xFFE0, // Yellow
+    0xFFFF  // White
+};
+
+/*
+* @brief Begin function
+*
+* @param[in] pixelBuffer    Buffer of `DISPLAY_WIDTH` * `DISPLAY_HEIGHT` / 2 bytes
+*
+* @details The canvas starts black with every tile dirty, the panel content is unknown after its initialization.
+*/
+void DisplayCanvas::begin(uint8_t *pixelBuffer)
+{
+    pixels = pixelBuffer;
+    memset(pixels, 0, DISPLAY_WIDTH * DISPLAY_HEIGHT / 2);
+    lastColor = palette[0];
+    lastIndex = 0;
+    invalidate();
+}
+
+/*
+* @brief Set pixel function
+*
+* @param[in] x      The column
+* @param[in] y      The row
+* @param[in] color  RGB565 color, drawn with the nearest palette color
+*/
+void DisplayCanvas::setPixel(int x, int y, uint16_t color)
+{
+    if (x < 0 || y < 0 || x >= DISPLAY_WIDTH || y >= DISPLAY_HEIGHT)
+        return;
+
+    storeIndex(x, y, colorIndex(color));
+}
+
+/*
+* @brief Fill function
+*
+* @param[in] x      The left column
+* @param[in] y      The top row
+* @param[in] width  Width in pixels
+* @param[in] height Height in pixels
+* @param[in] color  RGB565 color, drawn with the nearest palette color
+*
+* @details The rectangle is clipped to the display.
+*/
+void DisplayCanvas::fill(int x, int y, int width, int height, uint16_t color)
+{
+    const int left = (x < 0) ? 0 : x;
+    const int top = (y < 0) ? 0 : y;
+    const int right = (x + width > DISPLAY_WIDTH) ? DISPLAY_WIDTH : x + width;
+    const int bottom = (y + height > DISPLAY_HEIGHT) ? DISPLAY_HEIGHT : y + height;
+    const uint8_t index = colorIndex(color);
+
+    for (int row = top; row < bottom; row++)
+    {
+        for (int column = left; column < right; column++)
+        {
+            storeIndex(column, row, index);
+        }
+    }
+}
+
+/*
+* @brief Invalidate function
+*
+* @details This function marks every tile dirty, so the whole canvas is sent again.
+*/
+void DisplayCanvas::invalidate()
+{
+    markTiles(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT);
+}
+
+/*
+* @brief Take dirty rectangle function
+*
+* @param[out] rect  The next dirty rectangle, a multiple of the tile size
+* @return False when nothing is dirty
+*
+* @details The tiles of the rectangle are marked clean. A pixel that is drawn again afterwards
+* marks its tile dirty again, so it is sent in a later rectangle.
+*/
+bool DisplayCanvas::takeDirtyRect(DisplayRect &rect)
+{
+    for (int row = 0; row < DISPLAY_TILE_ROWS; row++)
+    {
+        const uint32_t bits = dirtyTiles[row];
+        if (bits == 0)
+            continue;
+
+        const int first = __builtin_ctz(bits);
+        int last = first;
+        while (last + 1 < DISPLAY_TILE_COLUMNS && (bits & (1u << (last + 1))))
+        {
+            last++;
+        }
+        const uint32_t run = ((1u << (last - first + 1)) - 1) << first;
+
+        int lastRow = row;
+        while (lastRow + 1 < DISPLAY_TILE_ROWS && (dirtyTiles[lastRow + 1] & run) == run)
+        {
+            lastRow++;
+        }
+        for (int r = row; r <= lastRow; r++)
+        {
+            dirtyTiles[r] &= ~run;
+        }
+
+        rect.x = first * DISPLAY_TILE_SIZE;
+        rect.y = row * DISPLAY_TILE_SIZE;
+        rect.width = (last - first + 1) * DISPLAY_TILE_SIZE;
+        rect.height = (lastRow - row + 1) * DISPLAY_TILE_SIZE;
+        return true;
+    }
+    return false;
+}
+
+/*
+* @brief Is dirty function
+*
+* @return True when a tile is waiting to be sent
+*/
+bool DisplayCanvas::isDirty() const
+{
+    for (int row = 0; row < DISPLAY_TILE_ROWS; row++)
+    {
+        if (dirtyTiles[row])
+            return true;
+    }
+    return false;
+}
+
+/*
+* @brief Pixel index function
+*
+* @param[in] x  The column
+* @param[in] y  The row
+* @return The palette index of the pixel
+*/
+uint8_t DisplayCanvas::pixelIndex(int x, int y) const
+{
+    const uint8_t pair = pixels[(y * DISPLAY_WIDTH + x) >> 1];
+    return (x & 1) ? (pair >> 4) : (pair & 0x0F);
+}
+
+/*
+* @brief Color index function
+*
+* @param[in] color  RGB565 color
+* @return The index of the nearest palette color
+*
+* @details The distance is the squared RGB difference. The last lookup is cached,
+* text and fills draw many pixels in the same color.
+*/
+uint8_t DisplayCanvas::colorIndex(uint16_t color)
+{
+    if (color == lastColor)
+        return lastIndex;
+
+    const int red = (color >> 11) << 3;
+    const int green = ((color >> 5) & 0x3F) << 2;
+    const int blue = (color & 0x1F) << 3;
+    int bestDistance = 0x7FFFFFFF;
+    uint8_t best = 0;
+
+    for (int i = 0; i < DISPLAY_PALETTE_SIZE; i++)
+    {
+        const int dr = red - ((palette[i] >> 11) << 3);
+        const int dg = green - (((palette[i] >> 5) & 0x3F) << 2);
+        const int db = blue - ((palette[i] & 0x1F) << 3);
+        const int distance = dr * dr + dg * dg + db * db;
+        if (distance < bestDistance)
+        {
+            bestDistance = distance;
+            best = (uint8_t)i;
+        }
+    }
+
+    lastColor = color;
+    lastIndex = best;
+    return best;
+}
+
+/*
+* @brief Palette color function
+*
+* @param[in] index  The palette index
+* @return The RGB565 color
+*/
+uint16_t DisplayCanvas::paletteColor(uint8_t index)
+{
+    return palette[index & 0x0F];
+}
+
+/*
+* @brief Store index function
+*
+* @param[in] x      The column, on the display
+* @param[in] y      The row, on the display
+* @param[in] index  The palette index
+*/
+void DisplayCanvas::storeIndex(int x, int y, uint8_t index)
+{
+    uint8_t &pair = pixels[(y * DISPLAY_WIDTH + x) >> 1];
+    const uint8_t value = (x & 1) ? (uint8_t)((pair & 0x0F) | (index << 4)) : (uint8_t)((pair & 0xF0) | index);
+
+    if (value != pair)
+    {
+        pair = value;
+        dirtyTiles[y / DISPLAY_TILE_SIZE] |= 1u << (x / DISPLAY_TILE_SIZE);
+    }
+}
+
+/*
+* @brief Mark tiles function
+*
+* @param[in] x      The left column
+* @param[in] y      The top row
+* @param[in] width  Width in pixels
+* @param[in] height Height in pixels
+*/
+void DisplayCanvas::markTiles(int x, int y, int width, int height)
+{
+    const int firstColumn = x / DISPLAY_TILE_SIZE;
+    const int lastColumn = (x + width - 1) / DISPLAY_TILE_SIZE;
+    const uint32_t run = ((1u << (lastColumn - firstColumn + 1)) - 1) << firstColumn;
+
+    for (int row = y / DISPLAY_TILE_SIZE; row <= (y + height - 1) / DISPLAY_TILE_SIZE; row++)
+    {
+        dirtyTiles[row] |= run;
+    }
+}
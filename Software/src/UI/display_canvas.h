@@ -0,0 +1,77 @@
+/**
+ * @file display_canvas.h
+ * @brief Header file for the display framebuffer with dirty tracking
+ *
+ * @details This file contains the declaration of the in-memory copy of the display. The screens draw into the canvas
+ * instead of directly to the panel, the DisplayRenderer sends only the changed regions to the panel afterwards.
+ *
+ * Pixels are stored as 4-bit indices into a palette of 16 RGB565 colors, so the 480 x 320 framebuffer takes 75 kB.
+ * A color that is not in the palette is drawn with the nearest palette color. The screen is divided into tiles
+ * of `DISPLAY_TILE_SIZE` pixels, a write only marks a tile dirty when it actually changes a pixel.
+ * Redrawing a whole screen with mostly the same content therefore only sends the few tiles that differ.
+ *
+ * @note The canvas does not depend on the Arduino libraries, so it is also used by the host display benchmark.
+ * GfxCanvas (gfx_canvas.h) puts the Adafruit_GFX drawing and text functions on top of it.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+#ifndef DISPLAY_CANVAS_H
+#define DISPLAY_CANVAS_H
+
+// Headers
+#include <cstdint>
+
+// Defines
+static const int DISPLAY_WIDTH = 480;       // Landscape, the panel is set to rotation 3
+static const int DISPLAY_HEIGHT = 320;
+static const int DISPLAY_TILE_SIZE = 16;
+static const int DISPLAY_TILE_COLUMNS = DISPLAY_WIDTH / DISPLAY_TILE_SIZE;
+static const int DISPLAY_TILE_ROWS = DISPLAY_HEIGHT / DISPLAY_TILE_SIZE;
+static const int DISPLAY_PALETTE_SIZE = 16;
+
+/*
+* @struct DisplayRect
+* @brief A rectangle in display pixels
+*/
+struct DisplayRect
+{
+    int x;
+    int y;
+    int width;
+    int height;
+};
+
+/*
+* @class DisplayCanvas
+* @brief Palette framebuffer that tracks which tiles changed
+*/
+class DisplayCanvas
+{
+    public:
+        void begin(uint8_t *pixelBuffer);
+
+        void setPixel(int x, int y, uint16_t color);
+        void fill(int x, int y, int width, int height, uint16_t color);
+        void invalidate();
+
+        bool takeDirtyRect(DisplayRect &rect);
+        bool isDirty() const;
+
+        uint8_t pixelIndex(int x, int y) const;
+        uint8_t colorIndex(uint16_t color);
+        static uint16_t paletteColor(uint8_t index);
+
+    private:
+        void storeIndex(int x, int y, uint8_t index);
+        void markTiles(int x, int y, int width, int height);
+
+        uint8_t *pixels = nullptr;                      // DISPLAY_WIDTH * DISPLAY_HEIGHT / 2, two pixels per byte
+        uint32_t dirtyTiles[DISPLAY_TILE_ROWS] = {};    // One bit per tile column
+        uint16_t lastColor = 0;                         // Cache of the last colorIndex() lookup
+        uint8_t lastIndex = 0;
+};
+
+#endif // DISPLAY_CANVAS_H
@@ -0,0 +1,137 @@
+/**
+ * @file display_renderer.cpp
+ * @brief Incremental display renderer
+ *
+ * @details This file contains the implementation of the chunked renderer. The state machine per service() call:
+ * when no rectangle is being sent, the previous window is closed and the next dirty rectangle is opened.
+ * Then one chunk is prepared if needed, and when the backend is free it is sent and the chunk after it is prepared.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+// Headers
+#include "display_renderer.h"
+
+/*
+* @brief Begin function
+*
+* @param[in] canvas     The canvas to send
+* @param[in] backend    The backend to send it to
+*/
+void DisplayRenderer::begin(DisplayCanvas &canvas, DisplayBackend &backend)
+{
+    this->canvas = &canvas;
+    this->backend = &backend;
+
+    for (int i = 0; i < DISPLAY_PALETTE_SIZE; i++)
+    {
+        const uint16_t color = DisplayCanvas::paletteColor((uint8_t)i);
+        colors[i][0] = (uint8_t)((color >> 11) << 3);
+        colors[i][1] = (uint8_t)(((color >> 5) & 0x3F) << 2);
+        colors[i][2] = (uint8_t)((color & 0x1F) << 3);
+    }
+
+    sending = false;
+    windowOpen = false;
+    prepared = false;
+    fillBuffer = 0;
+    resetStats();
+}
+
+/*
+* @brief Service function
+*
+* @return True while there is work left, false when the panel shows the canvas
+*
+* @details Call this function repeatedly from loop(). It never waits for the backend.
+*/
+bool DisplayRenderer::service()
+{
+    if (!canvas)
+        return false; // Not started
+
+    if (!sending)
+    {
+        if (backend->busy())
+            return true;
+
+        if (windowOpen)
+        {
+            backend->endWindow();
+            windowOpen = false;
+        }
+
+        if (!canvas->takeDirtyRect(rect))
+            return false;
+
+        backend->beginWindow(rect);
+        windowOpen = true;
+        sending = true;
+        nextPixel = 0;
+        counters.rects++;
+    }
+
+    if (!prepared)
+        prepareChunk();
+
+    if (backend->busy())
+        return true;
+
+    backend->writePixels(chunkBuffers[fillBuffer], chunkBytes);
+    counters.chunks++;
+    counters.bytes += chunkBytes;
+    fillBuffer ^= 1;
+    prepared = false;
+
+    if (nextPixel < rect.width * rect.height)
+        prepareChunk(); // Overlaps with the transfer
+    else
+        sending = false;
+
+    return true;
+}
+
+/*
+* @brief Idle function
+*
+* @return True when nothing is being sent and the canvas has no dirty tiles
+*/
+bool DisplayRenderer::idle() const
+{
+    return !sending && !windowOpen && !backend->busy() && !canvas->isDirty();
+}
+
+/*
+* @brief Prepare chunk function
+*
+* @details This function converts the next pixels of the rectangle from palette indices
+* to the transfer format, into the free chunk buffer.
+*/
+void DisplayRenderer::prepareChunk()
+{
+    const int remaining = rect.width * rect.height - nextPixel;
+    const int count = (remaining < DISPLAY_CHUNK_PIXELS) ? remaining : DISPLAY_CHUNK_PIXELS;
+    int column = nextPixel % rect.width;
+    int row = nextPixel / rect.width;
+    uint8_t *out = chunkBuffers[fillBuffer];
+
+    for (int i = 0; i < count; i++)
+    {
+        const uint8_t *color = colors[canvas->pixelIndex(rect.x + column, rect.y + row)];
+        *out++ = color[0];
+        *out++ = color[1];
+        *out++ = color[2];
+
+        if (++column == rect.width)
+        {
+            column = 0;
+            row++;
+        }
+    }
+
+    nextPixel += count;
+    chunkBytes = count * DISPLAY_BYTES_PER_PIXEL;
+    prepared = true;
+}
@@ -0,0 +1,71 @@
+/**
+ * @file display_renderer.h
+ * @brief Header file for the incremental display renderer
+ *
+ * @details This file contains the declaration of the renderer that copies the dirty regions of the DisplayCanvas
+ * to the panel. The work is split into chunks of `DISPLAY_CHUNK_PIXELS` pixels: every service() call converts
+ * at most two chunks and starts at most one transfer, then returns, so loop() can call it once per pass
+ * without delaying the audio processing. While the backend sends one chunk the next one is converted
+ * into the second buffer.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+#ifndef DISPLAY_RENDERER_H
+#define DISPLAY_RENDERER_H
+
+// Headers
+#include <cstdint>
+#include "UI/display_canvas.h"
+#include "UI/display_backend.h"
+
+// Defines
+static const int DISPLAY_CHUNK_PIXELS = 512; // 1.5 kB, 0.5 ms at 24 MHz SPI
+
+/*
+* @struct DisplayStats
+* @brief Transfer counters of the renderer
+*/
+struct DisplayStats
+{
+    uint32_t rects = 0;     // Dirty rectangles sent
+    uint32_t chunks = 0;    // writePixels() calls
+    uint32_t bytes = 0;     // Pixel bytes sent
+};
+
+/*
+* @class DisplayRenderer
+* @brief Sends the dirty rectangles of a canvas in chunks
+*/
+class DisplayRenderer
+{
+    public:
+        void begin(DisplayCanvas &canvas, DisplayBackend &backend);
+        bool service();
+        bool idle() const;
+
+        const DisplayStats& stats() const { return counters; }
+        void resetStats() { counters = DisplayStats(); }
+
+    private:
+        void prepareChunk();
+
+        DisplayCanvas *canvas = nullptr;
+        DisplayBackend *backend = nullptr;
+        uint8_t colors[DISPLAY_PALETTE_SIZE][DISPLAY_BYTES_PER_PIXEL]; // Palette in the transfer format
+
+        DisplayRect rect = {};
+        bool sending = false;       // Pixels of `rect` are left to prepare or send
+        bool windowOpen = false;
+        int nextPixel = 0;          // Next pixel of `rect` to prepare, row by row
+        bool prepared = false;      // `chunkBuffers[fillBuffer]` holds the next chunk
+        int fillBuffer = 0;
+        int chunkBytes = 0;
+        uint8_t chunkBuffers[2][DISPLAY_CHUNK_PIXELS * DISPLAY_BYTES_PER_PIXEL];
+
+        DisplayStats counters;
+};
+
+#endif // DISPLAY_RENDERER_H
@@ -0,0 +1,36 @@
+/**
+ * @file gfx_canvas.h
+ * @brief Adafruit_GFX drawing surface on a DisplayCanvas
+ *
+ * @details This file defines the GfxCanvas class, which gives the screens the familiar Adafruit_GFX interface
+ * (text, lines, rectangles) while the pixels go into the DisplayCanvas framebuffer instead of to the panel.
+ * The primitives that Adafruit_GFX builds everything else from are overridden, so fills and text
+ * backgrounds are written as spans instead of pixel by pixel.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+#ifndef GFX_CANVAS_H
+#define GFX_CANVAS_H
+
+#include "Adafruit_GFX.h"
+#include "UI/display_canvas.h"
+
+class GfxCanvas : public Adafruit_GFX
+{
+    public:
+        GfxCanvas(DisplayCanvas& canvas) : Adafruit_GFX(DISPLAY_WIDTH, DISPLAY_HEIGHT), canvas(canvas) {}
+
+        void drawPixel(int16_t x, int16_t y, uint16_t color) override { canvas.setPixel(x, y, color); }
+        void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override { canvas.fill(x, y, w, h, color); }
+        void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override { canvas.fill(x, y, w, 1, color); }
+        void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override { canvas.fill(x, y, 1, h, color); }
+        void fillScreen(uint16_t color) override { canvas.fill(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT, color); }
+
+    private:
+        DisplayCanvas& canvas;
+};
+
+#endif // GFX_CANVAS_H
@@ -0,0 +1,129 @@
+/**
+ * @file ili9488_dma_backend.cpp
+ * @brief ILI9488 hardware SPI backend
+ *
+ * @details This file contains the implementation of the DMA display backend. A window keeps chip select low
+ * and the SPI transaction open from beginWindow() to endWindow(), so the chunks of one rectangle
+ * are one continuous memory write of the controller.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+// Headers
+#include "ili9488_dma_backend.h"
+
+// Defines
+static const uint8_t ILI9488_COLUMN_ADDRESS_SET = 0x2A;
+static const uint8_t ILI9488_PAGE_ADDRESS_SET = 0x2B;
+static const uint8_t ILI9488_MEMORY_WRITE = 0x2C;
+
+/*
+* @brief Constructor
+*
+* @param[in] spi    The SPI port the panel is connected to
+* @param[in] csPin  Chip select pin
+* @param[in] dcPin  Data/command pin
+* @param[in] clock  SPI clock in Hz
+*/
+Ili9488DmaBackend::Ili9488DmaBackend(SPIClass &spi, uint8_t csPin, uint8_t dcPin, uint32_t clock)
+    : spi(spi), csPin(csPin), dcPin(dcPin), settings(clock, MSBFIRST, SPI_MODE0)
+{
+}
+
+/*
+* @brief Begin function
+*
+* @details This function switches the data and clock pins to the SPI peripheral.
+*/
+void Ili9488DmaBackend::begin()
+{
+    pinMode(csPin, OUTPUT);
+    digitalWrite(csPin, HIGH);
+    pinMode(dcPin, OUTPUT);
+    spi.begin();
+
+    transferEvent.setContext(this);
+    transferEvent.attachImmediate(&transferComplete);
+}
+
+/*
+* @brief Begin window function
+*
+* @param[in] rect   The window, the following pixels fill it row by row
+*/
+void Ili9488DmaBackend::beginWindow(const DisplayRect &rect)
+{
+    spi.beginTransaction(settings);
+    digitalWrite(csPin, LOW);
+
+    writeCommand(ILI9488_COLUMN_ADDRESS_SET);
+    writeRange(rect.x, rect.x + rect.width - 1);
+    writeCommand(ILI9488_PAGE_ADDRESS_SET);
+    writeRange(rect.y, rect.y + rect.height - 1);
+    writeCommand(ILI9488_MEMORY_WRITE);
+}
+
+/*
+* @brief Write pixels function
+*
+* @param[in] data   Pixels in the 18-bit transfer format
+* @param[in] bytes  Number of bytes
+*
+* @details The transfer runs on DMA, the function returns immediately.
+*/
+void Ili9488DmaBackend::writePixels(const uint8_t *data, int bytes)
+{
+    transferActive = true;
+    spi.transfer(data, nullptr, bytes, transferEvent);
+}
+
+/*
+* @brief End window function
+*/
+void Ili9488DmaBackend::endWindow()
+{
+    digitalWrite(csPin, HIGH);
+    spi.endTransaction();
+}
+
+/*
+* @brief Write command function
+*
+* @param[in] command    The command byte
+*
+* @details The data/command pin is left high, for the parameters that follow.
+*/
+void Ili9488DmaBackend::writeCommand(uint8_t command)
+{
+    digitalWrite(dcPin, LOW);
+    spi.transfer(command);
+    digitalWrite(dcPin, HIGH);
+}
+
+/*
+* @brief Write range function
+*
+* @param[in] first  First column or row
+* @param[in] last   Last column or row, inclusive
+*/
+void Ili9488DmaBackend::writeRange(uint16_t first, uint16_t last)
+{
+    spi.transfer(first >> 8);
+    spi.transfer(first & 0xFF);
+    spi.transfer(last >> 8);
+    spi.transfer(last & 0xFF);
+}
+
+/*
+* @brief Transfer complete function
+*
+* @param[in] event  The event of the finished transfer, its context is the backend
+*
+* @details Called from the DMA interrupt.
+*/
+void Ili9488DmaBackend::transferComplete(EventResponderRef event)
+{
+    static_cast<Ili9488DmaBackend*>(event.getContext())->transferActive = false;
+}
@@ -0,0 +1,55 @@
+/**
+ * @file ili9488_dma_backend.h
+ * @brief Header file for the ILI9488 hardware SPI backend
+ *
+ * @details This file contains the declaration of the display backend that sends the pixels to the ILI9488
+ * over hardware SPI with DMA. The window commands are a few bytes and are written directly,
+ * the pixel data is sent with the asynchronous SPIClass::transfer(), which runs on DMA
+ * and signals the end of the transfer through an EventResponder.
+ *
+ * @note The panel itself is initialized by the ILI9488 library (controller setup and rotation). This backend
+ * only takes over the bus afterwards, call begin() after ILI9488::begin() and setRotation().
+ * The chunk buffers of the renderer are in DTCM, which the DMA reads without cache maintenance.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+#ifndef ILI9488_DMA_BACKEND_H
+#define ILI9488_DMA_BACKEND_H
+
+// Headers
+#include <Arduino.h>
+#include <SPI.h>
+#include "UI/display_backend.h"
+
+/*
+* @class Ili9488DmaBackend
+* @brief Display backend for the ILI9488 over hardware SPI with DMA
+*/
+class Ili9488DmaBackend : public DisplayBackend
+{
+    public:
+        Ili9488DmaBackend(SPIClass &spi, uint8_t csPin, uint8_t dcPin, uint32_t clock);
+        void begin();
+
+        void beginWindow(const DisplayRect &rect) override;
+        void writePixels(const uint8_t *data, int bytes) override;
+        bool busy() const override { return transferActive; }
+        void endWindow() override;
+
+    private:
+        void writeCommand(uint8_t command);
+        void writeRange(uint16_t first, uint16_t last);
+        static void transferComplete(EventResponderRef event);
+
+        SPIClass &spi;
+        uint8_t csPin;
+        uint8_t dcPin;
+        SPISettings settings;
+        EventResponder transferEvent;
+        volatile bool transferActive = false; // Cleared by the DMA completion interrupt
+};
+
+#endif // ILI9488_DMA_BACKEND_H
@@ -26,8 +26,8 @@
 class ScreenBase 
 {
     public:
-        virtual void draw(ILI9488& tft) = 0;
-        virtual void update(ILI9488& tft) {};
+        virtual void draw(Adafruit_GFX& tft) = 0;
+        virtual void update(Adafruit_GFX& tft) {};
         virtual void handleInput(InputEvent input) {};
         virtual ~ScreenBase() {}
 
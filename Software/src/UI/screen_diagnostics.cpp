@@ -0,0 +1,111 @@
+/**
+ * @file screen_diagnostics.cpp
+ * @brief Diagnostics screen class
+ *
+ * @details This file defines the ScreenDiagnostics class, which is a subclass of ScreenBase.
+ * The values are redrawn twice per second over the previous text, so the screen is only cleared once.
+ * Stage times are shown in microseconds.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+#include "screen_diagnostics.h"
+#include <cstdio>
+#include "DSP/audio_stream_classes.h"
+#include "DSP/profiler.h"
+
+void ScreenDiagnostics::begin(ScreenManager* manager, ScreenBase* previous)
+{
+    screenManager = manager;
+    previousScreen = previous;
+}
+
+void ScreenDiagnostics::draw(Adafruit_GFX& tft)
+{
+    if (!cleared)
+    {
+        tft.fillScreen(ILI9488_BLACK);
+        cleared = true;
+    }
+
+    char line[64];
+    const float cyclesPerMicrosecond = halCyclesPerSecond() / 1000000.0f;
+    int row = 0;
+
+    tft.setTextSize(1);
+    tft.setTextColor(ILI9488_WHITE, ILI9488_BLACK);
+
+#if VOCODER_PROFILING
+    const float frameLoad = profileFrameLoad(hopSize, AUDIO_SAMPLE_RATE_EXACT);
+    snprintf(line, sizeof(line), "DSP load %5.1f %%   ISR load %5.1f %%   ", frameLoad,
+             profileIsrLoad(AUDIO_BLOCK_SAMPLES, AUDIO_SAMPLE_RATE_EXACT));
+    tft.setTextColor(frameLoad < 80.0f ? ILI9488_GREEN : ILI9488_RED, ILI9488_BLACK);
+    tft.setCursor(0, ++row * 10);
+    tft.print(line);
+    tft.setTextColor(ILI9488_WHITE, ILI9488_BLACK);
+#else
+    tft.setCursor(0, ++row * 10);
+    tft.print("Profiling disabled (VOCODER_PROFILING)");
+#endif
+
+    snprintf(line, sizeof(line), "FFT %4d  audio mem %2u/max %2u   ", fftSize,
+             (unsigned)AudioMemoryUsage(), (unsigned)AudioMemoryUsageMax());
+    tft.setCursor(0, ++row * 10);
+    tft.print(line);
+
+    snprintf(line, sizeof(line), "overruns %lu  underruns %lu  pool %lu   ",
+             (unsigned long)captureOverruns(), (unsigned long)playbackUnderruns(), (unsigned long)audioPoolFailures());
+    tft.setCursor(0, ++row * 10);
+    tft.print(line);
+
+    snprintf(line, sizeof(line), "gate %-6s %5.1f dB  skipped %5.1f %%   ", noiseGate.open() ? "open" : "closed",
+             noiseGate.threshold(), 100.0f * vocoderSkipRatio());
+    tft.setCursor(0, ++row * 10);
+    tft.print(line);
+
+#if VOCODER_PROFILING
+    row++;
+    tft.setCursor(0, ++row * 10);
+    tft.print("stage            avg us  max us  p99 us");
+
+    for (int i = 0; i < (int)ProfileStage::Count; i++)
+    {
+        ProfileSummary summary;
+        if (profileSummary((ProfileStage)i, summary))
+        {
+            snprintf(line, sizeof(line), "%-15s %7.1f %7.1f %7.1f", profileStageName((ProfileStage)i),
+                     summary.avgCycles / cyclesPerMicrosecond, summary.maxCycles / cyclesPerMicrosecond,
+                     summary.p99Cycles / cyclesPerMicrosecond);
+        }
+        else
+        {
+            snprintf(line, sizeof(line), "%-15s       -       -       -", profileStageName((ProfileStage)i));
+        }
+        tft.setCursor(0, ++row * 10);
+        tft.print(line);
+    }
+#else
+    (void)cyclesPerMicrosecond;
+#endif
+}
+
+void ScreenDiagnostics::update(Adafruit_GFX& tft)
+{
+    if (millis() - lastRefresh >= refreshInterval)
+    {
+        lastRefresh = millis();
+        requestRedraw();
+    }
+}
+
+void ScreenDiagnostics::handleInput(InputEvent input)
+{
+    if (input == InputEvent::Select && screenManager && previousScreen)
+    {
+        cleared = false;
+        previousScreen->requestRedraw();
+        screenManager->setScreen(previousScreen);
+    }
+}
@@ -0,0 +1,37 @@
+/**
+ * @file screen_diagnostics.h
+ * @brief Diagnostics screen class
+ *
+ * @details This file defines the ScreenDiagnostics class, which is a subclass of ScreenBase.
+ * It shows the DSP load, the audio memory usage, the ring buffer counters and the timing of every
+ * profiled stage (see DSP/profiler.h). Pressing select returns to the previous screen.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+*/
+
+#ifndef SCREEN_DIAGNOSTICS_H
+#define SCREEN_DIAGNOSTICS_H
+
+#include "screen_base.h"
+#include "UI/input_manager.h"
+#include "UI/screen_manager.h"
+
+class ScreenDiagnostics : public ScreenBase
+{
+    public:
+        void begin(ScreenManager* manager, ScreenBase* previous);
+        void draw(Adafruit_GFX& tft) override;
+        void update(Adafruit_GFX& tft) override;
+        void handleInput(InputEvent input) override;
+
+    private:
+        ScreenManager* screenManager = nullptr;
+        ScreenBase* previousScreen = nullptr;
+        bool cleared = false;
+        uint32_t lastRefresh = 0;
+        static constexpr uint32_t refreshInterval = 500; // ms
+};
+
+#endif // SCREEN_DIAGNOSTICS_H
@@ -11,13 +11,28 @@
  */
 
 #include "screen_main_menu.h"
+#include "DSP/vocoder.h"
 
-void ScreenMainMenu::draw(ILI9488& tft) 
+void ScreenMainMenu::begin(ScreenManager* manager, ScreenBase* settings, ScreenBase* diagnostics, ScreenBase* spectrum)
+{
+    screenManager = manager;
+    settingsScreen = settings;
+    diagnosticsScreen = diagnostics;
+    spectrumScreen = spectrum;
+}
+
+void ScreenMainMenu::draw(Adafruit_GFX& tft) 
 {
     if (selectedIndex == lastSelectedIndex)
         return;
 
-    tft.fillScreen(ILI9488_BLACK);
+    // The screen is only cleared when the menu is shown, after that every item overwrites its own row.
+    // The canvas only sends the tiles that changed, so redrawing unchanged items costs no transfer.
+    if (!cleared)
+    {
+        tft.fillScreen(ILI9488_BLACK);
+        cleared = true;
+    }
     tft.setTextSize(1);
 
     // Clamp selectedIndex
@@ -31,7 +46,26 @@ void ScreenMainMenu::draw(ILI9488& tft)
             tft.setTextColor(ILI9488_WHITE, ILI9488_BLACK);
         }
         tft.setCursor(0, i * 10 + 10);
-        tft.println(menuItems[i]);
+        if (i == engineItem)
+        {
+            tft.print(menuItems[i]);
+            tft.print(vocoderEngineName(getVocoderEngine()));
+        }
+        else if (i == fftSizeItem)
+        {
+            tft.print(menuItems[i]);
+            tft.print(frameSizeManager.requestedSize());
+        }
+        else if (i == carrierItem)
+        {
+            tft.print(menuItems[i]);
+            tft.print((requestedCarrierVoices() == 1) ? "mono" : "stereo");
+        }
+        else
+        {
+            tft.print(menuItems[i]);
+        }
+        tft.fillRect(tft.getCursorX(), i * 10 + 10, itemWidth - tft.getCursorX(), 10, ILI9488_BLACK); // Clears a longer previous value
     }
 
     lastSelectedIndex = selectedIndex;
@@ -65,6 +99,50 @@ void ScreenMainMenu::handleInput(InputEvent input)
 
         case InputEvent::Select:
             buttonState = 1;
+            if (selectedIndex == engineItem)
+            {
+                // FFT, fixed-point FFT, filter bank
+                switch (getVocoderEngine())
+                {
+                    case VocoderEngine::FFT:        setVocoderEngine(VocoderEngine::FixedPoint); break;
+                    case VocoderEngine::FixedPoint: setVocoderEngine(VocoderEngine::FilterBank); break;
+                    default:                        setVocoderEngine(VocoderEngine::FFT); break;
+                }
+                lastSelectedIndex = -1; // Force a redraw of the engine name
+            }
+            else if (selectedIndex == fftSizeItem)
+            {
+                // Applied by the DSP between two frames
+                frameSizeManager.requestSize(FrameSizeManager::nextSize(frameSizeManager.requestedSize()));
+                lastSelectedIndex = -1;
+            }
+            else if (selectedIndex == carrierItem)
+            {
+                // Mono uses the left input, stereo vocodes both inputs as two voices
+                requestCarrierVoices(requestedCarrierVoices() % carrierInputs + 1); // Applied between two frames
+                lastSelectedIndex = -1;
+            }
+            else if (selectedIndex == settingsItem && screenManager && settingsScreen)
+            {
+                lastSelectedIndex = -1;
+                cleared = false;
+                screenManager->setScreen(settingsScreen);
+                return;
+            }
+            else if (selectedIndex == diagnosticsItem && screenManager && diagnosticsScreen)
+            {
+                lastSelectedIndex = -1; // Redraw the menu when coming back
+                cleared = false;
+                screenManager->setScreen(diagnosticsScreen);
+                return;
+            }
+            else if (selectedIndex == spectrumItem && screenManager && spectrumScreen)
+            {
+                lastSelectedIndex = -1;
+                cleared = false;
+                screenManager->setScreen(spectrumScreen);
+                return;
+            }
             stateChanged = true;
             break;
     }
@@ -19,16 +19,29 @@
 class ScreenMainMenu : public ScreenBase 
 {
     public:
-        void draw(ILI9488& tft) override;
+        void begin(ScreenManager* manager, ScreenBase* settings, ScreenBase* diagnostics, ScreenBase* spectrum);
+        void draw(Adafruit_GFX& tft) override;
         void handleInput(InputEvent input) override;
         
 
     private:
-        ScreenManager* screenManager;
+        ScreenManager* screenManager = nullptr;
+        ScreenBase* settingsScreen = nullptr;
+        ScreenBase* diagnosticsScreen = nullptr;
+        ScreenBase* spectrumScreen = nullptr;
         int selectedIndex = 0;
         int lastSelectedIndex = -1;
         int buttonState = 0;
+        bool cleared = false;
         bool needsRedraw = true;
-        static constexpr const char* menuItems[2] = {"1. Start", "2. Settings"};
+        static constexpr const char* menuItems[7] = {"1. Start", "2. Settings", "3. Engine: ", "4. FFT size: ", "5. Carrier: ", "6. Diagnostics", "7. Spectrum"};
+        static constexpr int settingsItem = 1;
+        static constexpr int engineItem = 2;
+        static constexpr int fftSizeItem = 3;
+        static constexpr int carrierItem = 4;
+        static constexpr int diagnosticsItem = 5;
+        static constexpr int spectrumItem = 6;
+        static constexpr int carrierInputs = 2; // Left and right channel of the line input
+        static constexpr int itemWidth = 160;   // Pixels cleared per item row
         static constexpr int itemCount = sizeof(menuItems) / sizeof(menuItems[0]);
 };
\ No newline at end of file
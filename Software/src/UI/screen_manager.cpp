@@ -12,14 +12,14 @@
 
 #include "screen_manager.h"
 
-ScreenManager::ScreenManager(ILI9488& display) : tft(display), currentScreen(nullptr) {}
+ScreenManager::ScreenManager(Adafruit_GFX& display) : tft(display), currentScreen(nullptr) {}
 
 void ScreenManager::setScreen(ScreenBase* screen) 
 {
     currentScreen = screen;
     if (currentScreen) 
     {
-        currentScreen->draw(tft);
+        currentScreen->requestRedraw(); // Drawn by the next draw(), not from the input callback
         redraw = true;
     }
 }
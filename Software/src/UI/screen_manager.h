@@ -5,7 +5,9 @@
  * @details This file defines the ScreenManager class, which is responsible for managing different screens in the application.
  * It provides methods to set the current screen, draw the screen, update the screen, and handle input events.
  * 
- * @note This class is intended to be used with the Adafruit ST7735 display library.
+ * @note The screens draw into the display canvas (see gfx_canvas.h), not directly to the panel.
+ * The DisplayRenderer sends the changed regions to the panel from loop().
+ * setScreen() only requests a redraw, so the input callback stays short and the drawing runs as its own task.
  * 
  * @author Tim Wannet
  * @date 20-05-2025
@@ -21,7 +23,7 @@
 class ScreenManager 
 {
     public:
-        ScreenManager(ILI9488& display);
+        ScreenManager(Adafruit_GFX& display);
         void setScreen(ScreenBase* screen);
         void draw();
         void update();
@@ -29,7 +31,7 @@ class ScreenManager
         bool needsRedraw();
 
     private:
-        ILI9488& tft;
+        Adafruit_GFX& tft;
         ScreenBase* currentScreen;
         bool redraw = true; 
 };
@@ -0,0 +1,98 @@
+/**
+ * @file screen_settings.cpp
+ * @brief Settings screen class
+ *
+ * @details This file defines the ScreenSettings class, which is a subclass of ScreenBase.
+ * The screen is cleared once, after that every item overwrites its own row. The value being edited is shown
+ * in yellow. A value written over Serial or MIDI redraws the screen, so it always shows the current targets.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+#include "screen_settings.h"
+#include "DSP/vocoder.h"
+
+void ScreenSettings::begin(ScreenManager* manager, ScreenBase* previous)
+{
+    screenManager = manager;
+    previousScreen = previous;
+}
+
+void ScreenSettings::draw(Adafruit_GFX& tft)
+{
+    if (!cleared)
+    {
+        tft.fillScreen(ILI9488_BLACK);
+        cleared = true;
+    }
+    tft.setTextSize(1);
+    lastRevision = vocoderParameters.revision();
+
+    char value[24];
+    for (int i = 0; i < itemCount; i++)
+    {
+        const bool selected = (i == selectedIndex);
+        const int y = i * 10 + 10;
+
+        tft.setTextColor(selected && !editing ? ILI9488_BLACK : ILI9488_WHITE, selected && !editing ? ILI9488_WHITE : ILI9488_BLACK);
+        tft.setCursor(0, y);
+        if (i == backItem)
+        {
+            tft.print("Back");
+            tft.fillRect(tft.getCursorX(), y, itemWidth - tft.getCursorX(), 10, ILI9488_BLACK);
+            continue;
+        }
+
+        const ParamId id = (ParamId)i;
+        tft.print(ParameterRegistry::info(id).label);
+        tft.fillRect(tft.getCursorX(), y, valueColumn - tft.getCursorX(), 10, ILI9488_BLACK);
+
+        ParameterRegistry::format(id, vocoderParameters.target(id), value, sizeof(value));
+        tft.setTextColor(selected && editing ? ILI9488_YELLOW : ILI9488_WHITE, ILI9488_BLACK);
+        tft.setCursor(valueColumn, y);
+        tft.print(value);
+        tft.fillRect(tft.getCursorX(), y, itemWidth - tft.getCursorX(), 10, ILI9488_BLACK); // Clears a longer previous value
+    }
+}
+
+void ScreenSettings::update(Adafruit_GFX& tft)
+{
+    if (vocoderParameters.revision() != lastRevision)
+        requestRedraw();
+}
+
+void ScreenSettings::handleInput(InputEvent input)
+{
+    switch (input)
+    {
+        case InputEvent::Left:
+            if (editing)
+                vocoderParameters.step((ParamId)selectedIndex, -1); // Redraws through the revision
+            else
+                selectedIndex = (selectedIndex > 0) ? selectedIndex - 1 : itemCount - 1;
+            break;
+
+        case InputEvent::Right:
+            if (editing)
+                vocoderParameters.step((ParamId)selectedIndex, 1);
+            else
+                selectedIndex = (selectedIndex < itemCount - 1) ? selectedIndex + 1 : 0;
+            break;
+
+        case InputEvent::Select:
+            if (selectedIndex == backItem && screenManager && previousScreen)
+            {
+                cleared = false;
+                selectedIndex = 0;
+                previousScreen->requestRedraw();
+                screenManager->setScreen(previousScreen);
+                return;
+            }
+            editing = !editing && selectedIndex != backItem;
+            break;
+    }
+
+    requestRedraw();
+}
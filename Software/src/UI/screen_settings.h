@@ -0,0 +1,45 @@
+/**
+ * @file screen_settings.h
+ * @brief Settings screen class
+ *
+ * @details This file defines the ScreenSettings class, which is a subclass of ScreenBase.
+ * It lists the vocoder parameters (see DSP/parameters.h) with their target value. The encoder moves the selection,
+ * select starts editing the selected parameter, then the encoder steps its value and select ends editing.
+ * Selecting "Back" returns to the previous screen.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+*/
+
+#ifndef SCREEN_SETTINGS_H
+#define SCREEN_SETTINGS_H
+
+#include "screen_base.h"
+#include "UI/input_manager.h"
+#include "UI/screen_manager.h"
+#include "DSP/parameters.h"
+
+class ScreenSettings : public ScreenBase
+{
+    public:
+        void begin(ScreenManager* manager, ScreenBase* previous);
+        void draw(Adafruit_GFX& tft) override;
+        void update(Adafruit_GFX& tft) override;
+        void handleInput(InputEvent input) override;
+
+    private:
+        ScreenManager* screenManager = nullptr;
+        ScreenBase* previousScreen = nullptr;
+        int selectedIndex = 0;
+        bool editing = false;
+        bool cleared = false;
+        uint32_t lastRevision = 0;  // Of the registry, Serial and MIDI also write to it
+
+        static constexpr int backItem = (int)ParamId::Count;
+        static constexpr int itemCount = backItem + 1;
+        static constexpr int itemWidth = 200;   // Pixels cleared per item row
+        static constexpr int valueColumn = 100; // Pixels from the left
+};
+
+#endif // SCREEN_SETTINGS_H
@@ -0,0 +1,172 @@
+/**
+ * @file screen_spectrum.cpp
+ * @brief Spectrum visualizer screen class
+ *
+ * @details This file defines the ScreenSpectrum class, which is a subclass of ScreenBase.
+ * The screen is cleared once, after that every refresh only draws the difference: a bar that grows gets the new part
+ * filled, a bar that shrinks gets the old part cleared, and the peak markers are moved. The values are shown in dB
+ * below a reference that follows the loudest band, so the graphs scale with the input level.
+ *
+ * The refresh interval adapts to the load of the DSP: up to `idleLoad` the screen refreshes 30 times per second,
+ * above it the interval grows, up to `maxRefreshInterval` at `busyLoad`.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+ */
+
+#include "screen_spectrum.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include "DSP/vocoder.h"
+
+static const char* graphNames[3] = {"Modulator", "Carrier", "Gain"};
+static const uint16_t graphColors[3] = {ILI9488_GREEN, ILI9488_CYAN, ILI9488_YELLOW};
+static const float graphRanges[3] = {60.0f, 60.0f, 40.0f}; // dB from the top of the graph to the bottom
+
+void ScreenSpectrum::begin(ScreenManager* manager, ScreenBase* previous)
+{
+    screenManager = manager;
+    previousScreen = previous;
+}
+
+void ScreenSpectrum::draw(Adafruit_GFX& tft)
+{
+    char line[80];
+
+    tft.setTextSize(1);
+    if (!cleared)
+    {
+        tft.fillScreen(ILI9488_BLACK);
+        tft.setTextColor(ILI9488_WHITE, ILI9488_BLACK);
+        for (int graph = 0; graph < 3; graph++)
+        {
+            tft.setCursor(0, graphTop + graph * graphSpacing);
+            tft.print(graphNames[graph]);
+        }
+        memset(barHeight, 0, sizeof(barHeight));
+        memset(peakHeight, 0, sizeof(peakHeight));
+        cleared = true;
+    }
+
+    tft.setTextColor(ILI9488_WHITE, ILI9488_BLACK);
+    tft.setCursor(0, 0);
+    if (getVocoderEngine() != VocoderEngine::FFT)
+    {
+        tft.print("Spectrum: select the FFT engine in the main menu      ");
+        return;
+    }
+    snprintf(line, sizeof(line), "Spectrum  FFT %4d  DSP load %3d %%  refresh %3d ms  %s   ", frame.fftSize,
+             (int)(vocoderLoad() * 100.0f + 0.5f), refreshInterval, frame.unvoiced ? "unvoiced" : "voiced");
+    tft.print(line);
+
+    if (!hasFrame)
+        return;
+
+    drawGraph(tft, 0, frame.modulator, graphRanges[0]);
+    drawGraph(tft, 1, frame.carrier, graphRanges[1]);
+    drawGraph(tft, 2, frame.gain, graphRanges[2]);
+}
+
+void ScreenSpectrum::update(Adafruit_GFX& tft)
+{
+    if (millis() - lastRefresh < (uint32_t)refreshInterval)
+        return;
+
+    // Asks for the next frame, the DSP fills it without waiting for the display
+    spectrumSnapshot.request();
+    if (spectrumSnapshot.read(frame))
+    {
+        hasFrame = true;
+        lastRefresh = millis();
+        refreshInterval = refreshIntervalFor(vocoderLoad());
+        requestRedraw();
+    }
+}
+
+void ScreenSpectrum::handleInput(InputEvent input)
+{
+    if (input == InputEvent::Select && screenManager && previousScreen)
+    {
+        cleared = false;
+        previousScreen->requestRedraw();
+        screenManager->setScreen(previousScreen);
+    }
+}
+
+/*
+* @brief Draw graph function
+*
+* @param[in] tft    The display
+* @param[in] graph  The graph, 0 to 2
+* @param[in] values The linear value per band
+* @param[in] range  The dB range of the graph
+*
+* @details Only the changed part of every bar and the moved peak markers are drawn.
+* A peak marker is the row above the peak height, so it never overlaps its bar.
+*/
+void ScreenSpectrum::drawGraph(Adafruit_GFX& tft, int graph, const float *values, float range)
+{
+    const int base = graphTop + graph * graphSpacing + 10 + graphHeight; // Row below the graph
+    const uint32_t now = millis();
+
+    float loudest = -200.0f;
+    for (int band = 0; band < SPECTRUM_BANDS; band++)
+    {
+        const float level = 20.0f * log10f(values[band] + 1e-10f);
+        loudest = (level > loudest) ? level : loudest;
+    }
+    reference[graph] = (loudest > reference[graph] - referenceFall) ? loudest : reference[graph] - referenceFall;
+
+    for (int band = 0; band < SPECTRUM_BANDS; band++)
+    {
+        const int x = band * barPitch;
+        const float level = 20.0f * log10f(values[band] + 1e-10f) - (reference[graph] - range);
+        int height = (int)(level * graphHeight / range);
+        height = (height < 0) ? 0 : (height > graphHeight - 1) ? graphHeight - 1 : height;
+
+        int peak = peakHeight[graph][band];
+        if (height >= peak)
+        {
+            peak = height;
+            peakTime[graph][band] = now;
+        }
+        else if (now - peakTime[graph][band] > peakHold)
+        {
+            peak = (peak - peakFall > height) ? peak - peakFall : height;
+        }
+
+        // Remove the old marker first, a growing bar may cover its row
+        if (peak != peakHeight[graph][band])
+            tft.drawFastHLine(x, base - peakHeight[graph][band] - 1, barWidth, ILI9488_BLACK);
+
+        const int previous = barHeight[graph][band];
+        if (height > previous)
+            tft.fillRect(x, base - height, barWidth, height - previous, graphColors[graph]);
+        else if (height < previous)
+            tft.fillRect(x, base - previous, barWidth, previous - height, ILI9488_BLACK);
+
+        tft.drawFastHLine(x, base - peak - 1, barWidth, ILI9488_WHITE);
+        barHeight[graph][band] = (int16_t)height;
+        peakHeight[graph][band] = (int16_t)peak;
+    }
+}
+
+/*
+* @brief Refresh interval function
+*
+* @param[in] load   The DSP load, 1 is the real-time limit
+* @return The refresh interval in ms
+*
+* @details The display uses what the DSP leaves: the fastest rate up to `idleLoad`,
+* then the interval grows linearly to `maxRefreshInterval` at `busyLoad`.
+*/
+int ScreenSpectrum::refreshIntervalFor(float load) const
+{
+    if (load <= idleLoad)
+        return minRefreshInterval;
+    if (load >= busyLoad)
+        return maxRefreshInterval;
+    return minRefreshInterval + (int)((maxRefreshInterval - minRefreshInterval) * (load - idleLoad) / (busyLoad - idleLoad));
+}
@@ -0,0 +1,62 @@
+/**
+ * @file screen_spectrum.h
+ * @brief Spectrum visualizer screen class
+ *
+ * @details This file defines the ScreenSpectrum class, which is a subclass of ScreenBase.
+ * It shows the modulator spectrum, the carrier spectrum (voice 0) and the applied vocoder gain as three bar graphs
+ * of `SPECTRUM_BANDS` logarithmic bands with peak hold. The data comes from the spectrum snapshot of the
+ * FFT engine (see DSP/spectrum_snapshot.h). Pressing select returns to the previous screen.
+ *
+ * @author Tim Wannet
+ * @date 16-10-2026
+ * @version 0.01
+*/
+
+#ifndef SCREEN_SPECTRUM_H
+#define SCREEN_SPECTRUM_H
+
+#include "screen_base.h"
+#include "UI/input_manager.h"
+#include "UI/screen_manager.h"
+#include "DSP/spectrum_snapshot.h"
+
+class ScreenSpectrum : public ScreenBase
+{
+    public:
+        void begin(ScreenManager* manager, ScreenBase* previous);
+        void draw(Adafruit_GFX& tft) override;
+        void update(Adafruit_GFX& tft) override;
+        void handleInput(InputEvent input) override;
+
+    private:
+        void drawGraph(Adafruit_GFX& tft, int graph, const float *values, float range);
+        int refreshIntervalFor(float load) const;
+
+        ScreenManager* screenManager = nullptr;
+        ScreenBase* previousScreen = nullptr;
+        bool cleared = false;
+        bool hasFrame = false;
+        SpectrumFrame frame = {};
+        uint32_t lastRefresh = 0;
+        int refreshInterval = minRefreshInterval;
+
+        float reference[3] = {};                    // Top of each graph in dB, follows the peaks
+        int16_t barHeight[3][SPECTRUM_BANDS] = {};  // Pixels, as drawn
+        int16_t peakHeight[3][SPECTRUM_BANDS] = {};
+        uint32_t peakTime[3][SPECTRUM_BANDS] = {};  // millis() of the last peak
+
+        static constexpr int minRefreshInterval = 33;   // ms, 30 updates per second
+        static constexpr int maxRefreshInterval = 500;  // ms, when the DSP leaves little time
+        static constexpr float idleLoad = 0.5f;         // DSP load up to which the fastest rate is used
+        static constexpr float busyLoad = 0.9f;         // DSP load from which the slowest rate is used
+        static constexpr int graphTop = 14;
+        static constexpr int graphSpacing = 102;
+        static constexpr int graphHeight = 90;
+        static constexpr int barPitch = 10;
+        static constexpr int barWidth = 8;
+        static constexpr uint32_t peakHold = 800;       // ms before a peak starts to fall
+        static constexpr int peakFall = 3;              // Pixels per refresh
+        static constexpr float referenceFall = 0.5f;    // dB per refresh
+};
+
+#endif // SCREEN_SPECTRUM_H
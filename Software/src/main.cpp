@@ -8,89 +8,414 @@
  * Fast Fourier Transform (FFT) analysis, and reconstructs the signal for playback.
  * 
  * The program is structured into three main processing classes:
- * - CarrierBufferProcessor: Handles audio data from the carrier input.
- * - ModulatorProcessor: Handles audio data from the modulator input.
- * - PlaybackProcessor: Handles audio data playback after processing.
+ * - CaptureProcessor: Captures the carrier inputs (one per carrier voice) and the modulator input in lock-step,
+ *   aligned on one sample clock (see DSP/capture_sync.h).
+ * - PlaybackProcessor: Handles the stereo audio data playback after processing.
+ * 
+ * The left and right channels of the line input are carrier voices 0 and 1. With one voice (mono carrier)
+ * only the left channel is used and the output is the same on both channels, with two voices (stereo carrier)
+ * both channels are vocoded with the same modulator analysis and panned left and right.
+ * 
+ * As a low-latency alternative the FilterBankProcessor vocodes each audio block directly
+ * with a band-pass filter bank. Both engines feed the output mixer, only the selected one is active.
  * 
  * The FFT is performed using the CMSIS-DSP library, which provides optimized 
  * FFT routines for ARM Cortex-M processors. The program extracts magnitude and 
  * phase information from the frequency domain, reconstructs the signal, and 
  * performs an inverse FFT to return to the time domain.
  * 
- * @note The FFT size can be adjusted by modifying the `FFT_SIZE` macro. Supported 
- * sizes include 128, 256, 512, 1024, 2048, and 4096.
+ * The screens draw into an in-memory canvas. The display renderer sends only the changed tiles to the panel,
+ * in small chunks over hardware SPI with DMA, one step per pass of loop(), so the display never stalls the audio.
+ * 
+ * The FFT frames run in a software interrupt below the audio interrupts (see HAL/software_interrupt.h), triggered
+ * by the capture as soon as a full hop is available, so the latency from capture to playback does not depend on loop().
+ * loop() only runs the task scheduler (see Core/task_scheduler.h): input, screens, display and telemetry in priority
+ * order, the frame interrupt preempts all of them.
+ * 
+ * The vocoder parameters (see DSP/parameters.h) can be set from the settings screen, over Serial
+ * ("params", "set NAME VALUE") and by MIDI control change when the USB type includes MIDI.
+ * 
+ * The processing chain itself lives in DSP/vocoder.cpp, so it can also be run
+ * on a PC by the native render tool (see Tools/vocoder_render.cpp).
+ * 
+ * @note The FFT size can be changed at runtime from the main menu. Supported 
+ * sizes include 128, 256, 512, 1024, 2048, and 4096, the startup size is
+ * `DEFAULT_FFT_SIZE` in DSP/frame_size_manager.h.
  * 
  * @author Tim Wannet
  * @date 26-03-2025
  * @version 0.02
  */
 
-#include "DSP/utils.h"
-#include "DSP/fft_utils.h"
+#include <cstdio>
+#include <cstring>
+#include "DSP/vocoder.h"
 #include "DSP/audio_stream_classes.h"
 
 #include "UI/input_manager.h"
 #include "UI/screen_manager.h"
 #include "UI/screen_main_menu.h"
+#include "UI/screen_settings.h"
+#include "UI/screen_diagnostics.h"
+#include "UI/screen_spectrum.h"
+#include "UI/display_canvas.h"
+#include "UI/display_renderer.h"
+#include "UI/gfx_canvas.h"
+#include "UI/ili9488_dma_backend.h"
+#include "DSP/profiler.h"
+#include "Core/task_scheduler.h"
+#include "HAL/software_interrupt.h"
 
 // defines/constants
 #define TFT_RST   28
 #define TFT_DC    29
 #define TFT_CS    30
 #define TFT_BLK   31  
-#define TFT_MOSI  26
-#define TFT_CLK   27
+#define TFT_MOSI  26  // MOSI1
+#define TFT_CLK   27  // SCK1
 #define ENCODER_BUTTON 35
 #define ENCODER_PIN_A 33
 #define ENCODER_PIN_B 34
-// #define SPI_CLOCK 24000000
+static const uint32_t DISPLAY_SPI_CLOCK = 24000000;
+
+// Time budgets of the loop() tasks in us, overruns are reported. The frame interrupt preempts the tasks,
+// so the budgets only matter again when the frame runs from loop() (a non-preemptive deadline task).
+static const uint32_t INPUT_BUDGET = 100;       // Includes the input callback, a screen switch draws in draw
+static const uint32_t UPDATE_BUDGET = 100;
+static const uint32_t DRAW_BUDGET = 2000;       // A full redraw into the canvas
+static const uint32_t DISPLAY_BUDGET = 50;      // One chunk, see DisplayRenderer::service()
+static const uint32_t TELEMETRY_BUDGET = 1000;  // The profile report over Serial
+static const uint32_t MIDI_BUDGET = 100;        // Up to `MIDI_MESSAGES_PER_PASS` messages
+static const uint32_t CONSOLE_BUDGET = 500;     // One command, the parameter list is the longest reply
+static const uint32_t CONSOLE_INTERVAL = 10000;
+static const int MIDI_MESSAGES_PER_PASS = 16;
+static const int CONSOLE_CHARS_PER_PASS = 64;
 
-const int FFT_SIZE = 1024; // Buffer size (Change this value as needed: 128, 256, 512, 1024, 2048, etc.)
-const arm_cfft_instance_f32* fftConfig;
+static const char* captureStreamNames[CAPTURE_STREAMS] = {"carrier0", "carrier1", "carrier2", "carrier3", "modulator"};
+
+// Audio blocks in flight per update: 3 captured (line in left/right, analog), 1 filter bank, 2 playback,
+// 2 mixer copies and 4 queued in the I2S output. Twice that leaves room for the update order.
+// The capture and playback queues hold their blocks on top of that, when they are full.
+// The audio_mem_max column of the profile report shows the actual peak, pool_failures counts the exhaustions.
+static const int AUDIO_MEMORY_BLOCKS = 24 + AUDIO_QUEUE_BLOCKS;
 
 // Audio Library objects
 AudioInputI2S         i2sInput;  // I2S input from Audio Shield
 AudioInputAnalog      analogInput(A17); // Analog input as modulator
 AudioOutputI2S        i2sOutput; // I2S output to Audio Shield
+AudioMixer4           outputMixerLeft; // Sums the FFT and filter-bank engine outputs, left channel
+AudioMixer4           outputMixerRight; // Sums the FFT and filter-bank engine outputs, right channel
 AudioControlSGTL5000  sgtl5000_1;
 
-// variables
-int16_t carrierBuffer[FFT_SIZE];
-int16_t modulatorBuffer[FFT_SIZE];
-int16_t fftFloatBuffer[FFT_SIZE];
-
-float fftBuffer[FFT_SIZE * 2];
-float carrierFloatBuffer[FFT_SIZE * 2];
-float modulatorFloatBuffer[FFT_SIZE * 2];
-float modulatorFFT[FFT_SIZE * 2];
-float modulatorMagnitude[FFT_SIZE];
-float carrierMagnitude[FFT_SIZE];
-float smoothedModulator[FFT_SIZE] = {0}; // Initialize smoothedModulator with zeros
-float modulatorPhase[FFT_SIZE];
-float carrierPhase[FFT_SIZE];
-
-volatile bool carrierBufferFull = false;
-volatile bool modulatorBufferFull = false;
-volatile bool playbackReady = false;
-
 
 //Constructors
-ILI9488 tft = ILI9488(TFT_CS, TFT_DC, TFT_MOSI, TFT_CLK, TFT_RST, -1);
+ILI9488 tft = ILI9488(TFT_CS, TFT_DC, TFT_MOSI, TFT_CLK, TFT_RST, -1); // Only initializes the panel, at boot
 // Adafruit_ST7735 tft = Adafruit_ST7735(&SPI1, TFT_CS, TFT_DC, TFT_RST);
-ScreenManager* screenManager;
+static uint8_t displayPixels[DISPLAY_WIDTH * DISPLAY_HEIGHT / 2] HAL_SLOW_MEMORY;
+DisplayCanvas displayCanvas;
+GfxCanvas gfxCanvas(displayCanvas);
+Ili9488DmaBackend displayBackend(SPI1, TFT_CS, TFT_DC, DISPLAY_SPI_CLOCK); // The panel pins are the SPI1 pins
+DisplayRenderer displayRenderer;
+ScreenManager screenManager(gfxCanvas);
 ScreenMainMenu mainMenu;
+ScreenSettings settingsScreen;
+ScreenDiagnostics diagnosticsScreen;
+ScreenSpectrum spectrumScreen;
 InputManager inputManager(ENCODER_PIN_A, ENCODER_PIN_B, ENCODER_BUTTON);
+TaskScheduler scheduler(micros);
+static char consoleLine[48];
+static int consoleLength = 0;
 
 // Audio Library objects/patch connections
-CarrierBufferProcessor  carrierProcessor;
-ModulatorProcessor      modulatorProcessor;
+CaptureProcessor        captureProcessor; // Updated after the inputs, so it gets their blocks of the same update
 PlaybackProcessor       playbackProcessor;
-AudioConnection         patchCord1(i2sInput, 0, carrierProcessor, 0); 
-AudioConnection         patchCord2(analogInput, 0, modulatorProcessor, 0); 
-AudioConnection         patchCord3(playbackProcessor, 0, i2sOutput, 0); // left channel
-AudioConnection         patchCord4(playbackProcessor, 0, i2sOutput, 1); // right channel
+FilterBankProcessor     filterBankProcessor;
+AudioConnection         patchCord1(i2sInput, 0, captureProcessor, 0); // carrier voice 0
+AudioConnection         patchCord2(analogInput, 0, captureProcessor, CAPTURE_MODULATOR_INPUT); 
+AudioConnection         patchCord3(outputMixerLeft, 0, i2sOutput, 0); // left channel
+AudioConnection         patchCord4(outputMixerRight, 0, i2sOutput, 1); // right channel
+AudioConnection         patchCord5(playbackProcessor, 0, outputMixerLeft, 0);
+AudioConnection         patchCord6(i2sInput, 0, filterBankProcessor, 0);
+AudioConnection         patchCord7(analogInput, 0, filterBankProcessor, 1);
+AudioConnection         patchCord8(filterBankProcessor, 0, outputMixerLeft, 1);
+AudioConnection         patchCord9(i2sInput, 1, captureProcessor, 1); // carrier voice 1
+AudioConnection         patchCord10(playbackProcessor, 1, outputMixerRight, 0);
+AudioConnection         patchCord11(filterBankProcessor, 0, outputMixerRight, 1);
 
  
+/*
+* @brief Print memory report function
+*
+* @details This function prints the placement of every DSP buffer in the fast (DTCM) and slow (OCRAM) arena
+* as CSV over Serial, followed by the required and the available size of each arena.
+*/
+void printMemoryReport()
+{
+    char line[96];
+    const DspArena *arenas[] = {&fastArena, &slowArena};
+
+    Serial.println("mem,arena,buffer,offset,bytes,stage");
+    for (const DspArena *arena : arenas)
+    {
+        for (int i = 0; i < arena->entryCount(); i++)
+        {
+            arena->formatEntry(i, line, sizeof(line));
+            Serial.println(line);
+        }
+        arena->formatSummary(line, sizeof(line));
+        Serial.println(line);
+    }
+}
+
+#if VOCODER_PROFILING
+/*
+* @brief Report profile function
+*
+* @details This function prints the profiler statistics as CSV over Serial and starts a new interval,
+* it is the telemetry task of the scheduler and runs once per second.
+* One line per stage, all times in CPU cycles, followed by one load line,
+* then the scheduler statistics in us: one line for the DSP frame and one per background task,
+* the frames skipped by the noise gate and one line per captured stream with its offset and drift against the shared sample clock.
+*/
+static void reportProfile()
+{
+    char line[96];
+    for (int i = 0; i < (int)ProfileStage::Count; i++)
+    {
+        if (profileFormatCsv((ProfileStage)i, line, sizeof(line)) > 0)
+            Serial.println(line);
+    }
+
+    snprintf(line, sizeof(line), "prof,load,%.1f,%.1f,%u,%lu,%lu,%lu",
+             profileFrameLoad(hopSize, AUDIO_SAMPLE_RATE_EXACT), profileIsrLoad(AUDIO_BLOCK_SAMPLES, AUDIO_SAMPLE_RATE_EXACT),
+             (unsigned)AudioMemoryUsageMax(), (unsigned long)captureOverruns(), (unsigned long)playbackUnderruns(),
+             (unsigned long)audioPoolFailures());
+    Serial.println(line);
+
+    const DeadlineStats &frames = scheduler.deadlineStats();
+    snprintf(line, sizeof(line), "prof,deadline,%s,%lu,%lu,%lu,%lu,%lu,%lu", scheduler.deadlineName(),
+             (unsigned long)frames.frames, (unsigned long)frames.misses, (unsigned long)frames.maxLateness,
+             (unsigned long)frames.maxTime, (unsigned long)frames.maxResponse, (unsigned long)scheduler.frameCost());
+    Serial.println(line);
+    for (int i = 0; i < scheduler.taskCount(); i++)
+    {
+        const TaskStats &task = scheduler.taskStats(i);
+        snprintf(line, sizeof(line), "prof,task,%s,%lu,%lu,%lu,%lu", scheduler.taskName(i), (unsigned long)task.runs,
+                 (unsigned long)task.deferred, (unsigned long)task.overruns, (unsigned long)task.maxTime);
+        Serial.println(line);
+    }
+
+    snprintf(line, sizeof(line), "prof,gate,%lu,%lu,%.1f,%.1f", (unsigned long)noiseGate.frames(),
+             (unsigned long)noiseGate.skippedFrames(), 100.0f * vocoderSkipRatio(), noiseGate.threshold());
+    Serial.println(line);
+
+    // The counters of one stream are updated together by the capture interrupt
+    for (int s = 0; s < captureSync.streamCount(); s++)
+    {
+        AudioNoInterrupts();
+        const CaptureStreamStats stream = captureSync.stats(s);
+        AudioInterrupts();
+        if (stream.blocks == 0)
+            continue; // Not connected
+        snprintf(line, sizeof(line), "prof,sync,%s,%lu,%lu,%ld,%.1f", captureStreamNames[s], (unsigned long)stream.blocks,
+                 (unsigned long)stream.concealed, (long)stream.offset, stream.driftPpm);
+        Serial.println(line);
+    }
+
+    profileReset();
+    scheduler.resetStats();
+}
+#endif
+
+/*
+* @brief Frame period function
+*
+* @return The time between two frames at the active hop size in us
+*/
+static uint32_t framePeriod()
+{
+    return (uint32_t)(hopSize * 1e6f / AUDIO_SAMPLE_RATE_EXACT + 0.5f);
+}
+
+/*
+* @brief Frame ready function
+*
+* @return True when a full hop of all streams is captured
+*/
+static bool frameReady()
+{
+    return captureProcessor.available() >= (uint32_t)hopSize;
+}
+
+/*
+* @brief Process frame function
+*
+* @details The deadline task: reads one hop out of the captured blocks, vocodes it and writes the result into
+* blocks for playback.
+*/
+static void processFrame()
+{
+    const int hop = hopSize; // processVocoderFrame() may switch to a new FFT size after this hop
+    int16_t *carriers[MAX_CARRIER_VOICES];
+    for (int v = 0; v < MAX_CARRIER_VOICES; v++)
+    {
+        carriers[v] = carrierBuffers[v];
+    }
+    captureProcessor.readHop(carriers, carrierVoices.voiceCount(), modulatorBuffer, hop);
+
+    processVocoderFrame();
+
+    playbackProcessor.writeHop(outputLeftBuffer, outputRightBuffer, hop);
+    scheduler.setPeriod(framePeriod());
+}
+
+/*
+* @brief Frame interrupt function
+*
+* @details The software interrupt of the FFT frames. It discards the capture left from before a switch to the filter bank,
+* restarts a newly selected FFT engine and applies a requested change of the number of carrier voices, all before the
+* next hop is read. Then it processes every full hop in the capture queue through the scheduler, which checks each frame
+* against its deadline.
+* The capture queues the blocks of all streams together, so a newly enabled voice is aligned with the others already.
+* The audio interrupts preempt it, it preempts loop().
+*/
+static void frameInterrupt()
+{
+    captureProcessor.discardStale();
+    applyEngineReset();
+    applyCarrierVoices();
+
+    while (scheduler.runDeadlineTask())
+    {
+    }
+}
+
+/*
+* @brief Capture handler function
+*
+* @details Called from the audio interrupt after every captured block, triggers the frame interrupt when a hop is complete
+* or when the capture from before a switch to the filter bank has to be released.
+*/
+static void captureHandler()
+{
+    if (frameReady() || captureProcessor.stale())
+        halTriggerFrameInterrupt();
+}
+
+/*
+* @brief Print parameters function
+*
+* @details This function prints the target of every vocoder parameter as CSV over Serial, with its range.
+*/
+static void printParameters()
+{
+    char line[96];
+    Serial.println("param,name,value,min,max,unit,midi_cc");
+    for (int i = 0; i < (int)ParamId::Count; i++)
+    {
+        const ParamInfo &param = ParameterRegistry::info((ParamId)i);
+        snprintf(line, sizeof(line), "param,%s,%g,%g,%g,%s,%u", param.name, vocoderParameters.target((ParamId)i),
+                 param.minValue, param.maxValue, param.unit, (unsigned)param.midiControl);
+        Serial.println(line);
+    }
+}
+
+/*
+* @brief Run console command function
+*
+* @param[in] line   The command without the line end
+*
+* @details Commands: "params" prints all parameters, "set NAME VALUE" sets the target of a parameter.
+* The value is clamped to the range of the parameter.
+*/
+static void runConsoleCommand(const char *line)
+{
+    char name[32];
+    char reply[64];
+    float value;
+    ParamId id;
+
+    if (strcmp(line, "params") == 0)
+    {
+        printParameters();
+    }
+    else if (sscanf(line, "set %31s %f", name, &value) == 2 && ParameterRegistry::find(name, id))
+    {
+        vocoderParameters.set(id, value);
+        snprintf(reply, sizeof(reply), "param,%s,%g", name, vocoderParameters.target(id));
+        Serial.println(reply);
+    }
+    else
+    {
+        Serial.println("Commands: params, set NAME VALUE");
+    }
+}
+
+/*
+* @brief Service console function
+*
+* @details The console task: collects the characters received over Serial without waiting
+* and runs a command at the end of every line.
+*/
+static void serviceConsole()
+{
+    for (int i = 0; i < CONSOLE_CHARS_PER_PASS && Serial.available() > 0; i++)
+    {
+        const char c = (char)Serial.read();
+        if (c == '\n' || c == '\r')
+        {
+            consoleLine[consoleLength] = '\0';
+            if (consoleLength > 0)
+                runConsoleCommand(consoleLine);
+            consoleLength = 0;
+            return; // One command per pass
+        }
+        if (consoleLength < (int)sizeof(consoleLine) - 1)
+            consoleLine[consoleLength++] = c;
+    }
+}
+
+#if defined(USB_MIDI) || defined(USB_MIDI_SERIAL)
+/*
+* @brief Service MIDI function
+*
+* @details The MIDI task: every control change that is mapped to a parameter (see DSP/parameters.cpp)
+* sets its target, the full controller range covers the range of the parameter.
+*/
+static void serviceMidi()
+{
+    for (int i = 0; i < MIDI_MESSAGES_PER_PASS && usbMIDI.read(); i++)
+    {
+        ParamId id;
+        if (usbMIDI.getType() == usbMIDI.ControlChange && ParameterRegistry::findControl(usbMIDI.getData1(), id))
+            vocoderParameters.setNormalized(id, usbMIDI.getData2() / 127.0f);
+    }
+}
+#endif
+
+/*
+* @brief Start scheduler function
+*
+* @details This function registers the DSP frame as the deadline task and the work of loop() as background tasks,
+* in priority order.
+*/
+static void startScheduler()
+{
+    scheduler.setDeadlineTask("dsp", frameReady, processFrame, true); // Run by frameInterrupt()
+    scheduler.setPeriod(framePeriod());
+    scheduler.addTask("input", []() { inputManager.update(); }, 0, INPUT_BUDGET);
+#if defined(USB_MIDI) || defined(USB_MIDI_SERIAL)
+    scheduler.addTask("midi", serviceMidi, 0, MIDI_BUDGET);
+#endif
+    scheduler.addTask("update", []() { screenManager.update(); }, 1, UPDATE_BUDGET);
+    scheduler.addTask("draw", []() { screenManager.draw(); }, 2, DRAW_BUDGET); // Into the canvas
+    scheduler.addTask("display", []() { displayRenderer.service(); }, 3, DISPLAY_BUDGET);
+    scheduler.addTask("console", serviceConsole, 4, CONSOLE_BUDGET, CONSOLE_INTERVAL);
+#if VOCODER_PROFILING
+    scheduler.addTask("telemetry", reportProfile, 4, TELEMETRY_BUDGET, 1000000);
+#endif
+}
+
 /*
 * @brief Setup function
 *
@@ -100,15 +425,17 @@ void setup()
 {
     Serial.begin(115200);
 
-    AudioMemory(30);
+    captureSync.begin(CAPTURE_STREAMS);
+    AudioMemory(AUDIO_MEMORY_BLOCKS);
     sgtl5000_1.enable();
     sgtl5000_1.inputSelect(AUDIO_INPUT_LINEIN);
     sgtl5000_1.volume(0.7);
 
-    fftConfig = getFFTConfig(FFT_SIZE);
-    if (!fftConfig)
+    const bool vocoderReady = initVocoder();
+    printMemoryReport();
+    if (!vocoderReady)
     {
-        Serial.println("Invalid FFT size!");
+        Serial.println("Invalid vocoder configuration!");
         return;
     }
     
@@ -118,7 +445,7 @@ void setup()
 
     // Connect input events to screen manager
     inputManager.onInput([](InputEvent event) {
-        screenManager->handleInput(event);
+        screenManager.handleInput(event);
     });
 
     pinMode(TFT_BLK, OUTPUT);
@@ -126,13 +453,32 @@ void setup()
     delay(2000); 
     digitalWrite(TFT_BLK, HIGH);  // Turn backlight ON
 
-    // Initialize the TFT display
+    // Initialize the TFT display, then hand the pins to hardware SPI
     tft.begin();
     tft.setRotation(3);
-    tft.fillScreen(ILI9488_BLACK);
+    displayBackend.begin();
+    displayCanvas.begin(displayPixels);
+    displayRenderer.begin(displayCanvas, displayBackend);
+
+    mainMenu.begin(&screenManager, &settingsScreen, &diagnosticsScreen, &spectrumScreen);
+    settingsScreen.begin(&screenManager, &mainMenu);
+    diagnosticsScreen.begin(&screenManager, &mainMenu);
+    spectrumScreen.begin(&screenManager, &mainMenu);
+    screenManager.setScreen(&mainMenu);
+    startScheduler();
+
+    // From here on the frames run in the frame interrupt
+    halAttachFrameInterrupt(frameInterrupt);
+    setCaptureHandler(captureHandler);
 
-    screenManager = new ScreenManager(tft);
-    screenManager->setScreen(&mainMenu);
+#if VOCODER_PROFILING
+    Serial.println("prof,stage,count,min,avg,max,p99");
+    Serial.println("prof,load,frame_pct,isr_pct,audio_mem_max,overruns,underruns,pool_failures");
+    Serial.println("prof,deadline,task,frames,misses,max_late_us,max_us,max_response_us,cost_us");
+    Serial.println("prof,task,name,runs,deferred,overruns,max_us");
+    Serial.println("prof,gate,frames,skipped,skip_pct,threshold_db");
+    Serial.println("prof,sync,stream,blocks,concealed,offset_samples,drift_ppm");
+#endif
 
     Serial.println("Setup complete");
 
@@ -142,38 +488,10 @@ void setup()
 /*
 * @brief Loop function
 *
-* @details This function is the main loop of the program.
-* It checks if the buffer is full and processes the FFT when the buffer is full.
+* @details This function is the main loop of the program, it runs one pass of the scheduler.
+* The audio and the FFT frames are processed in interrupts.
 */
 void loop() 
 {
-    inputManager.update();  // Reads encoder, may set needsRedraw flag
-    screenManager->update(); // Optional if doing per-screen updates
-
-    screenManager->draw();  // Only draw when something changed
-
-    if (carrierBufferFull == true && modulatorBufferFull == true)
-    {
-        for (int i = 0; i < FFT_SIZE; i++) 
-        {
-            modulatorBuffer[i] = highpass(modulatorBuffer[i]);
-        }
-
-        
-
-        // Convert int16_t to float
-        convertInt16ToFloat(carrierBuffer, carrierFloatBuffer);
-        convertInt16ToFloat(modulatorBuffer, modulatorFloatBuffer);
-
-        processFFT(carrierFloatBuffer, carrierMagnitude, carrierPhase);
-        processFFT(modulatorFloatBuffer, modulatorMagnitude, modulatorPhase);
-
-        inverseFFT(fftBuffer, carrierMagnitude, carrierPhase, modulatorMagnitude, modulatorPhase);
-        
-        convertFloatToInt16(fftBuffer, fftFloatBuffer);
-
-        carrierBufferFull = false;
-        modulatorBufferFull = false;
-        playbackReady = true;
-    }
-}
\ No newline at end of file
+    scheduler.service();
+}